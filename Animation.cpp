@@ -70,12 +70,16 @@ void Animation::setCurrentFrame(std::size_t frame)
 	tx1 = 0;
 	ty1 = 0;
 
+	mCurrentFrame = frame;
+
+	// No texture in headless worlds: just keep count
+	if (!mSprite.getTexture())
+		return;
+
 	sf::Vector2u textureSize = mSprite.getTexture()->getSize();
 
 	int cols = static_cast<int>(textureSize.x / mFrameSize.x);
 
-	mCurrentFrame = frame;
-
 	tx1 = mCurrentFrame * mFrameSize.x;
 	if(tx1 > textureSize.x - mFrameSize.x)
 	{
@@ -121,7 +125,8 @@ void Animation::update(sf::Time dt)
 	sf::Time timePerFrame = mDuration / static_cast<float>(mNumFrames);
 	mElapsedTime += dt;
 
-	sf::Vector2i textureBounds(mSprite.getTexture()->getSize());
+	// No texture in headless worlds: the frames are counted all the same
+	sf::Vector2i textureBounds = mSprite.getTexture() ? sf::Vector2i(mSprite.getTexture()->getSize()) : mFrameSize;
 	sf::IntRect textureRect = mSprite.getTextureRect();
 
 	if (mCurrentFrame == 0)
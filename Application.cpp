@@ -19,7 +19,9 @@ Application::Application()
 , mFontManager()
 , mPlayer()
 , mPlayerPlatformer()
-, mStateStack(State::Context(mWindow, mTextureManager, mFontManager, mPlayer, mPlayerPlatformer))
+, mReplay()
+, mReplayFilename()
+, mStateStack(State::Context(mWindow, mTextureManager, mFontManager, mPlayer, mPlayerPlatformer, mReplay))
 , mStatisticsText()
 , mStatisticsUpdateTime()
 , mStatisticsNumFrames(0)
@@ -73,6 +75,15 @@ void Application::run()
 		updateStatistics(dt);
 		render();
 	}
+
+	if (mReplay.isRecording() && !mReplay.saveToFile(mReplayFilename))
+		throw std::runtime_error("Application::run - Failed to save replay " + mReplayFilename);
+}
+
+void Application::recordReplay(const std::string& filename)
+{
+	mReplayFilename = filename;
+	mReplay.startRecording(TimePerFrame);
 }
 
 void Application::processInput()
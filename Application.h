@@ -6,6 +6,7 @@
 
 #include "Player.h"
 #include "PlayerPlatformer.h"
+#include "Replay.h"
 
 #include "StateStack.h"
 
@@ -18,6 +19,12 @@ public:
 
 	void	run();
 
+	// Records the game sessions; the last one is saved to the file on exit
+	void	recordReplay(const std::string& filename);
+
+public:
+	static const sf::Time	TimePerFrame;
+
 private:
 	void	processInput();
 	void	update(sf::Time dt);
@@ -27,14 +34,14 @@ private:
 	void	registerStates();
 
 private:
-	static const sf::Time	TimePerFrame;
-
 	sf::RenderWindow		mWindow;
 	TextureManager			mTextureManager;
 	FontManager				mFontManager;
 
 	Player					mPlayer;
 	PlayerPlatformer		mPlayerPlatformer;
+	Replay					mReplay;
+	std::string				mReplayFilename;
 
 	StateStack				mStateStack;
 
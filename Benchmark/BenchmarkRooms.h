@@ -0,0 +1,106 @@
+//
+// Random numbers and synthetic rooms shared by the headless benchmarks.
+//
+// Header-only, so that each benchmark still builds from a single source
+// file plus the sources of the code it measures.
+//
+
+#ifndef _BenchmarkRooms_h_
+#define _BenchmarkRooms_h_
+
+#include "Room.h"
+
+
+// Small, portable random number generator (xorshift), so that the same seed
+// produces the same rooms and workloads on every platform:
+class Random
+{
+public:
+	Random ( unsigned int seed ) : state(seed * 2654435761u + 1) {}
+
+	inline unsigned int next () {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// Uniform integer in [0, n):
+	inline int range ( int n ) {
+		return (int) (next() % (unsigned int) n);
+	}
+
+	// Uniform float in [a, b), in steps of 1/16 pixel, so that coordinates
+	// often land exactly on block edges, like game objects do:
+	inline float range ( float a, float b ) {
+		return a + (float) (next() % (unsigned int) ((b - a) * 16)) / 16.0f;
+	}
+
+private:
+	unsigned int state;
+};
+
+
+
+// Fills the grid with rolling hills, one block column at a time: the ground
+// goes up or down a row with a random slope, and stays between row
+// <tt>minGround</tt> and two rows above the bottom. With
+// <tt>platforms</tt>, a thin floor is added three rows above the ground
+// now and then.
+static inline void buildHills ( ObstacleGrid & grid, Random & rnd, int minGround, bool platforms ) {
+	// Slope blocks, in pairs that go up (from left to right) and down:
+	static const RoomBlock::Type slopesUp[] = {
+		RoomBlock::BLK_SW_NE_BOTTOM, RoomBlock::BLK_SW_E_BOTTOM, RoomBlock::BLK_W_NE_BOTTOM };
+	static const RoomBlock::Type slopesDown[] = {
+		RoomBlock::BLK_NW_SE_BOTTOM, RoomBlock::BLK_NW_E_BOTTOM, RoomBlock::BLK_W_SE_BOTTOM };
+
+	int height = grid.rows;
+	int ground = height * 2 / 3;
+
+	for ( int j = 0; j < grid.columns; j++ ) {
+		int step  = rnd.range( 3 ) - 1;
+		int slope = rnd.range( 3 );
+
+		if ( step < 0 && ground > minGround ) {
+			ground--;
+			grid.set( ground, j, slopesUp[slope] );
+		}
+		else if ( step > 0 && ground < height - 2 ) {
+			grid.set( ground, j, slopesDown[slope] );
+			ground++;
+		}
+
+		for ( int i = ground + (step < 0 ? 1 : 0); i < height; i++ )
+			if ( grid.cell( i, j ) == RoomBlock::BLK_EMPTY )
+				grid.set( i, j, RoomBlock::BLK_FULL );
+
+		// A platform now and then:
+		if ( platforms && rnd.range( 4 ) == 0 && ground > 4 )
+			grid.set( ground - 3, j, RoomBlock::BLK_THINFLOOR_HI );
+	}
+} // End of function: buildHills
+
+
+
+// Builds a room for characters to walk through: rolling hills in the lower
+// half, with thin-floor platforms above them and walls at both ends. The
+// edge mesh is only built <tt>withMesh</tt>.
+static inline Room * buildHillsRoom ( Random & rnd, int blockSize, int width, int height, int waterLevel,
+                                      bool withMesh ) {
+	Room * room = new Room( blockSize, width, height, waterLevel, 0 );
+	ObstacleGrid & grid = room->obstacleLayer;
+
+	buildHills( grid, rnd, height / 2, true );
+
+	for ( int i = 0; i < height; i++ ) {
+		grid.set( i, 0, RoomBlock::BLK_FULL );
+		grid.set( i, width - 1, RoomBlock::BLK_FULL );
+	}
+
+	if ( withMesh )
+		room->buildEdgeMesh();
+
+	return room;
+} // End of function: buildHillsRoom
+
+#endif
@@ -0,0 +1,345 @@
+//
+// Headless benchmark for RoomNavGraph, PathPlanner, PathService and
+// FlowField.
+//
+// Builds the same kind of synthetic room as PlatformerBenchmark (rolling
+// hills with thin-floor platforms, walls at both ends), builds its
+// navigation graph with 1, 2, 4, ... threads, up to the hardware's, and
+// reports the build times and a checksum of the graph, which must be the
+// same for all thread counts. Then it plans paths between random points of
+// the graph twice: the first round searches the routes, the second one
+// gets them from the planner's cache. Last, it runs a crowd of agents that
+// keep asking PathService for paths to random points, a quarter of them
+// with a higher priority (as if they were on screen): once with the
+// searches run by PathService::update(), and once on worker threads. The
+// frames last a fixed time, as in the game, so the workers also search in
+// the rest of the frame. It reports the time spent in update() per frame,
+// how many frames overran the budget (which is only checked between
+// searches), and how long the agents waited for their paths. Then the same number of
+// agents chase a target that wanders over the graph, through a FlowField:
+// It reports the time to recompute the field, and to look up the agents'
+// steps.
+//
+// Options:
+//   -n <count>       Number of paths per round (default 10000).
+//   -agents <count>  Number of agents (default 500).
+//   -budget <ms>     PathService time budget per frame (default 1).
+//   -workers <count> Number of PathService worker threads (default 4).
+//   -seed <seed>     Seed for the room and the paths (default 1).
+//
+// It only needs the Room and PlatformerMotion sources, e.g.:
+//
+//   g++ -O2 -std=c++11 -pthread -I.. NavBenchmark.cpp ../RoomNavGraph.cpp ../PathPlanner.cpp ../PathService.cpp
+//       ../FlowField.cpp ../PlanAction.cpp ../PlatformerMotion.cpp ../Room.cpp ../RoomBlockGeometry.cpp ../RoomEdgeMesh.cpp ../RoomBGLayer.cpp
+//       ../Geom.cpp -lsfml-graphics -lsfml-window -lsfml-system
+//
+
+#include "RoomNavGraph.h"
+#include "PathPlanner.h"
+#include "PathService.h"
+#include "FlowField.h"
+#include "BenchmarkRooms.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <thread>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Auxiliary functions:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+static const int BLOCK_SIZE  = 48;
+static const int ROOM_WIDTH  = 240;
+static const int ROOM_HEIGHT = 40;
+
+static const int FRAMES = 600;
+
+// The agents' frames last this long, whatever time update() takes:
+static const double FRAME_MS = 1000.0 / 60.0;
+
+
+
+// FNV-1a over the graph's spans and links:
+static unsigned int checksum ( const RoomNavGraph & graph ) {
+	unsigned int hash = 2166136261u;
+
+	for ( int s = 0; s < graph.getSpanCount(); s++ ) {
+		const RoomNavGraph::Span & span = graph.getSpan( s );
+
+		for ( int j = span.firstColumn; j <= span.lastColumn; j++ ) {
+			float surface = graph.getSurface( s, j );
+			const unsigned char * bytes = (const unsigned char *) &surface;
+
+			for ( size_t b = 0; b < sizeof(surface); b++ )
+				hash = (hash ^ bytes[b]) * 16777619u;
+		}
+	}
+
+	for ( int l = 0; l < graph.getLinkCount(); l++ ) {
+		const RoomNavGraph::Link & link = graph.getLink( l );
+		float values[6] = { (float) link.from, (float) link.to, (float) link.action, link.landing.x, link.landing.y, link.time };
+		const unsigned char * bytes = (const unsigned char *) values;
+
+		for ( size_t b = 0; b < sizeof(values); b++ )
+			hash = (hash ^ bytes[b]) * 16777619u;
+	}
+
+	return hash;
+} // End of function: checksum
+
+
+
+// Plans paths between the points, and returns the time per path, in
+// microseconds. The number of paths found is stored in <tt>found</tt>.
+static double planPaths ( PathPlanner & planner, const std::vector<Vector2D> & points, int * found ) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	*found = 0;
+
+	for ( size_t p = 0; p + 1 < points.size(); p += 2 ) {
+		PlanAction::Ptr plan = planner.findPath( points[p], points[p + 1] );
+
+		if ( plan )
+			(*found)++;
+	}
+
+	double us = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count();
+
+	return us / (points.size() / 2);
+} // End of function: planPaths
+
+
+
+// Random point standing on one of the graph's spans:
+static Vector2D randomPoint ( const RoomNavGraph & graph, Random & rnd ) {
+	int span = rnd.range( graph.getSpanCount() );
+	const RoomNavGraph::Span & s = graph.getSpan( span );
+	float x = (float) ((s.firstColumn + rnd.range( s.lastColumn - s.firstColumn + 1 )) * BLOCK_SIZE + BLOCK_SIZE / 2);
+
+	return graph.getStandingPoint( span, x );
+} // End of function: randomPoint
+
+
+
+// Runs the agents for FRAMES frames of FRAME_MS each; each one asks for a
+// new path as soon as it gets one. Prints the time spent in update() per
+// frame, the number of frames it overran the budget, and the agents'
+// average wait for a path, in frames and in milliseconds. The Random is copied, so that every run asks for the same
+// paths.
+static void runAgents ( const RoomNavGraph & graph, Random rnd, int count, float budget, int threads ) {
+	typedef std::chrono::steady_clock Clock;
+
+	PathPlanner planner( graph );
+	PathService service( planner, threads );
+
+	std::vector<Vector2D>          positions( count );
+	std::vector<int>               asked( count );
+	std::vector<Clock::time_point> askedTime( count );
+	long long                      waited[2]   = { 0, 0 };
+	double                         waitedMs[2] = { 0, 0 };
+	int                            answered[2] = { 0, 0 };
+	double                         total = 0, worst = 0;
+	int                            overruns = 0;
+	int                            frame = 0;
+
+	// A path's end is the agent's next starting point:
+	std::function<void ( int )> ask = [&] ( int agent ) {
+		Vector2D goal = randomPoint( graph, rnd );
+		int priority  = (agent % 4 == 0 ? 1 : 0);
+
+		asked[agent]     = frame;
+		askedTime[agent] = Clock::now();
+		service.request( positions[agent], goal, priority, [&, agent, goal, priority] ( PathService::Handle, PlanAction::Ptr & ) {
+			waited[priority]   += frame - asked[agent];
+			waitedMs[priority] += std::chrono::duration<double, std::milli>( Clock::now() - askedTime[agent] ).count();
+			answered[priority]++;
+			positions[agent] = goal;
+			ask( agent );
+		} );
+	};
+
+	for ( int a = 0; a < count; a++ ) {
+		positions[a] = randomPoint( graph, rnd );
+		ask( a );
+	}
+
+	Clock::time_point frameStart = Clock::now();
+
+	for ( frame = 0; frame < FRAMES; frame++ ) {
+		Clock::time_point start = Clock::now();
+
+		service.update( budget );
+
+		double ms = std::chrono::duration<double, std::milli>( Clock::now() - start ).count();
+		total += ms;
+		worst  = std::max( worst, ms );
+
+		if ( ms > budget * 1000.0 )
+			overruns++;
+
+		// The rest of the frame goes to the game, and to the workers:
+		frameStart += std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double, std::milli>( FRAME_MS ) );
+		std::this_thread::sleep_until( frameStart );
+	}
+
+	service.clear();
+
+	printf( "%d agents, %d worker threads: update() %.3f ms/frame, %.3f ms at worst, %d of %d frames over the %.3f ms budget\n",
+	        count, service.getThreadCount(), total / FRAMES, worst, overruns, FRAMES, budget * 1000.0 );
+	printf( "  high priority: %d paths, %.2f frames (%.2f ms) waited; low priority: %d paths, %.2f frames (%.2f ms) waited\n",
+	        answered[1], answered[1] ? (double) waited[1] / answered[1] : 0.0, answered[1] ? waitedMs[1] / answered[1] : 0.0,
+	        answered[0], answered[0] ? (double) waited[0] / answered[0] : 0.0, answered[0] ? waitedMs[0] / answered[0] : 0.0 );
+} // End of function: runAgents
+
+
+
+// Moves the target to a random point every 10 frames, for FRAMES frames,
+// and looks up the steps of all agents every frame. Prints the time spent
+// recomputing the field, and looking up the steps.
+static void runChasers ( const RoomNavGraph & graph, Random & rnd, int count ) {
+	FlowField field( graph );
+
+	std::vector<Vector2D> positions( count );
+	double fieldMs = 0, lookupMs = 0;
+	int    reachable = 0;
+
+	for ( int a = 0; a < count; a++ )
+		positions[a] = randomPoint( graph, rnd );
+
+	for ( int frame = 0; frame < FRAMES; frame++ ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		if ( frame % 10 == 0 ) {
+			Vector2D target = randomPoint( graph, rnd );
+			field.setTarget( target.x, target.y );
+		}
+
+		std::chrono::steady_clock::time_point lookup = std::chrono::steady_clock::now();
+
+		for ( int a = 0; a < count; a++ ) {
+			const FlowField::Step * step = field.findStep( positions[a].x, positions[a].y );
+
+			if ( step && step->time < 1e30f )
+				reachable++;
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		fieldMs  += std::chrono::duration<double, std::milli>( lookup - start ).count();
+		lookupMs += std::chrono::duration<double, std::milli>( end - lookup ).count();
+	}
+
+	printf( "%d chasers: field %.3f ms per update (%u updates), lookups %.3f ms/frame, %.1f%% reachable\n",
+	        count, fieldMs / field.getUpdateCount(), field.getUpdateCount(), lookupMs / FRAMES,
+	        100.0 * reachable / ((double) count * FRAMES) );
+} // End of function: runChasers
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Main:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+int main ( int argc, char ** argv ) {
+	int count  = 10000;
+	int agents = 500;
+	float budget = 1.0f;
+	int workers = 4;
+	unsigned int seed = 1;
+
+	for ( int a = 1; a < argc; a++ ) {
+		if ( !strcmp( argv[a], "-n" ) && a + 1 < argc )
+			count = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-agents" ) && a + 1 < argc )
+			agents = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-budget" ) && a + 1 < argc )
+			budget = (float) atof( argv[++a] );
+		else if ( !strcmp( argv[a], "-workers" ) && a + 1 < argc )
+			workers = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-seed" ) && a + 1 < argc )
+			seed = (unsigned int) atoi( argv[++a] );
+		else {
+			std::cerr << "Usage: " << argv[0] << " [-n count] [-agents count] [-budget ms] [-workers count] [-seed seed]" << std::endl;
+			return 2;
+		}
+	}
+
+	Random rnd( seed );
+	Room * room = buildHillsRoom( rnd, BLOCK_SIZE, ROOM_WIDTH, ROOM_HEIGHT, -1, true );
+
+	int hardware = std::max( 1, (int) std::thread::hardware_concurrency() );
+	unsigned int reference = 0;
+	bool deterministic = true;
+
+	RoomNavGraph graph;
+
+	printf( "%7s %12s %10s %10s\n", "threads", "build ms", "speedup", "checksum" );
+
+	double single = 0;
+
+	for ( int threads = 1; ; threads = std::min( threads * 2, hardware ) ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		graph.build( *room, PlatformerMotion::defaultTuning(), threads );
+
+		double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+		unsigned int hash = checksum( graph );
+
+		if ( threads == 1 ) {
+			single    = ms;
+			reference = hash;
+		}
+		else if ( hash != reference )
+			deterministic = false;
+
+		printf( "%7d %12.3f %9.2fx %10x\n", threads, ms, single / ms, hash );
+
+		if ( threads == hardware )
+			break;
+	}
+
+	printf( "%d spans, %d links\n", graph.getSpanCount(), graph.getLinkCount() );
+
+	if ( graph.getSpanCount() > 0 ) {
+		// Random pairs of points standing on the graph's spans:
+		std::vector<Vector2D> points;
+
+		for ( int p = 0; p < count * 2; p++ )
+			points.push_back( randomPoint( graph, rnd ) );
+
+		PathPlanner planner( graph );
+		int found;
+
+		double cold = planPaths( planner, points, &found );
+		printf( "%d paths, %d found: %.3f us/path searching, %u searches\n", count, found, cold, planner.getSearchCount() );
+
+		double warm = planPaths( planner, points, &found );
+		printf( "%d paths, %d found: %.3f us/path cached\n", count, found, warm );
+
+		// The searches in update(), then on the workers:
+		runAgents( graph, rnd, agents, budget / 1000.0f, 0 );
+		runAgents( graph, rnd, agents, budget / 1000.0f, workers );
+		runChasers( graph, rnd, agents );
+	}
+
+	delete room;
+
+	if ( !deterministic ) {
+		printf( "The graph depends on the number of threads!\n" );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,218 @@
+//
+// Headless benchmark for PlatformerSystem.
+//
+// Builds a synthetic room of rolling hills with thin-floor platforms,
+// spawns a crowd of patrolling characters (they walk until they run into a
+// wall, then turn around, and jump now and then), and steps them for a
+// number of frames with 1, 2, 4, ... threads, up to the hardware's. For
+// each thread count it reports the time per frame and per character, and a
+// checksum of the characters' final state, which must be the same for all
+// thread counts.
+//
+// Last, the crowd is stepped with and without the room's edge mesh (without
+// it, the box sweeps test the blocks), in the same room and in a flooded
+// one; the edge mesh must not change the checksums.
+//
+// Options:
+//   -n <count>      Number of characters (default 500).
+//   -frames <count> Number of frames (default 600).
+//   -seed <seed>    Seed for the room and the characters (default 1).
+//
+// It only needs the Room and PlatformerMotion sources, e.g.:
+//
+//   g++ -O2 -std=c++11 -pthread -I.. PlatformerBenchmark.cpp ../PlatformerSystem.cpp ../PlatformerMotion.cpp
+//       ../Room.cpp ../RoomBlockGeometry.cpp ../RoomEdgeMesh.cpp ../RoomBGLayer.cpp ../Geom.cpp
+//       -lsfml-graphics -lsfml-window -lsfml-system
+//
+
+#include "PlatformerSystem.h"
+#include "BenchmarkRooms.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Auxiliary functions:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+static const int BLOCK_SIZE  = 48;
+static const int ROOM_WIDTH  = 240;
+static const int ROOM_HEIGHT = 40;
+
+static const float FRAME_TIME = 1.0f / 60.0f;
+
+// Now and then a frame takes longer, as when frames are dropped, so that the
+// characters don't always stay on the same sub-pixel positions:
+static const float SLOW_FRAME_TIME = 1.0f / 20.0f;
+
+
+
+// Runs the crowd for the given number of frames, and returns the time per
+// frame, in milliseconds. The checksum of the final state is stored in
+// <tt>checksum</tt>.
+static double runCrowd ( const Room & room, int threads, int count, int frames, unsigned int seed,
+                         unsigned int * checksum ) {
+	PlatformerSystem system( room, threads );
+	Random rnd( seed );
+
+	PlatformerMotion::Tuning walker;
+	PlatformerMotion::Tuning runner;
+	runner.WALK_SPEED    = 200.0f;
+	runner.JUMP_STRENGTH = 320.0f;
+
+	int profiles[2] = { system.addTuning( walker ), system.addTuning( runner ) };
+
+	for ( int c = 0; c < count; c++ ) {
+		float x = (float) (BLOCK_SIZE * (2 + rnd.range( ROOM_WIDTH - 4 ))) + rnd.range( 16 ) / 16.0f;
+		int i = system.add( profiles[c % 2], Vector2D( x, (float) BLOCK_SIZE * 4 ) );
+		system.controls( i ).right = (rnd.range( 2 ) != 0);
+		system.controls( i ).left  = !system.controls( i ).right;
+	}
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for ( int f = 0; f < frames; f++ ) {
+		// Patrol: Turn around at walls, and jump now and then.
+		for ( int i = 0; i < system.getCount(); i++ ) {
+			PlatformerMotion::Controls & controls = system.controls( i );
+			int contacts = system.getContacts( i );
+
+			if ( controls.right && (contacts & PlatformerSystem::CONTACT_RIGHT) ) {
+				controls.right = false;
+				controls.left  = true;
+			}
+			else if ( controls.left && (contacts & PlatformerSystem::CONTACT_LEFT) ) {
+				controls.left  = false;
+				controls.right = true;
+			}
+
+			controls.jumpPress = (rnd.range( 120 ) == 0);
+			controls.jump      = controls.jumpPress || (controls.jump && rnd.range( 30 ) != 0);
+		}
+
+		system.step( rnd.range( 10 ) == 0 ? SLOW_FRAME_TIME : FRAME_TIME );
+	}
+
+	double ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+
+	// FNV-1a over the final positions and speeds:
+	unsigned int hash = 2166136261u;
+	for ( int i = 0; i < system.getCount(); i++ ) {
+		float values[4] = { system.getPos( i ).x, system.getPos( i ).y, system.getVel( i ).x, system.getVel( i ).y };
+		const unsigned char * bytes = (const unsigned char *) values;
+
+		for ( size_t b = 0; b < sizeof(values); b++ )
+			hash = (hash ^ bytes[b]) * 16777619u;
+	}
+
+	*checksum = hash;
+
+	return ms / frames;
+} // End of function: runCrowd
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Main:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+int main ( int argc, char ** argv ) {
+	int count  = 500;
+	int frames = 600;
+	unsigned int seed = 1;
+
+	for ( int a = 1; a < argc; a++ ) {
+		if ( !strcmp( argv[a], "-n" ) && a + 1 < argc )
+			count = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-frames" ) && a + 1 < argc )
+			frames = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-seed" ) && a + 1 < argc )
+			seed = (unsigned int) atoi( argv[++a] );
+		else {
+			std::cerr << "Usage: " << argv[0] << " [-n count] [-frames count] [-seed seed]" << std::endl;
+			return 2;
+		}
+	}
+
+	Random rnd( seed );
+	Room * room = buildHillsRoom( rnd, BLOCK_SIZE, ROOM_WIDTH, ROOM_HEIGHT, -1, true );
+
+	int hardware = std::max( 1, (int) std::thread::hardware_concurrency() );
+	unsigned int reference = 0;
+	bool deterministic = true;
+
+	printf( "%d characters, %d frames\n", count, frames );
+	printf( "%7s %12s %14s %10s %10s\n", "threads", "ms/frame", "us/character", "speedup", "checksum" );
+
+	double single = 0;
+
+	for ( int threads = 1; ; threads = std::min( threads * 2, hardware ) ) {
+		unsigned int checksum;
+		double ms = runCrowd( *room, threads, count, frames, seed, &checksum );
+
+		if ( threads == 1 ) {
+			single    = ms;
+			reference = checksum;
+		}
+		else if ( checksum != reference )
+			deterministic = false;
+
+		printf( "%7d %12.3f %14.3f %9.2fx %10x\n", threads, ms, ms * 1000.0 / count, single / ms, checksum );
+
+		if ( threads == hardware )
+			break;
+	}
+
+	delete room;
+
+	// The edge mesh must not change the movement, on dry land or in the
+	// water (the valleys are flooded). A negative level means no water: Room
+	// moves it to -10000, outside the room, and Room::hasWater() is false:
+	static const int    waterLevels[2] = { -1, (ROOM_HEIGHT * 2 / 3) * BLOCK_SIZE - BLOCK_SIZE / 2 };
+	static const char * roomNames[2]   = { "dry", "flooded" };
+	bool meshExact = true;
+
+	printf( "\n%7s %10s %10s\n", "room", "mesh", "no mesh" );
+
+	for ( int w = 0; w < 2; w++ ) {
+		unsigned int checksums[2];
+
+		for ( int withMesh = 1; withMesh >= 0; withMesh-- ) {
+			Random roomRnd( seed );
+			Room * checkRoom = buildHillsRoom( roomRnd, BLOCK_SIZE, ROOM_WIDTH, ROOM_HEIGHT, waterLevels[w], withMesh != 0 );
+
+			runCrowd( *checkRoom, 1, count, frames, seed, &checksums[withMesh] );
+
+			delete checkRoom;
+		}
+
+		if ( checksums[0] != checksums[1] )
+			meshExact = false;
+
+		printf( "%7s %10x %10x\n", roomNames[w], checksums[1], checksums[0] );
+	}
+
+	if ( !deterministic ) {
+		printf( "The results depend on the number of threads!\n" );
+		return 1;
+	}
+
+	if ( !meshExact ) {
+		printf( "The results depend on the edge mesh!\n" );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,480 @@
+//
+// Headless benchmark for the Room collision queries.
+//
+// Builds synthetic rooms of several kinds and sizes, runs randomized
+// workloads of static points, moving points, static segments, moving
+// segments and box sweeps through Room::pointCollision,
+// Room::segmentCollision and Room::boxSweep, and reports throughput and
+// latency percentiles for each query type.
+//
+// The results of every query can also be recorded to a file, and later
+// verified against, so that a faster kernel can be checked against the
+// results of the current one:
+//
+//   RoomBenchmark -record reference.txt     (with the current kernel)
+//   RoomBenchmark -verify reference.txt     (with the new kernel)
+//
+// The files start with a version line. Older files without one are still
+// accepted: those from before the box sweeps were added are verified
+// without them.
+//
+// Other options:
+//   -n <count>     Number of queries per query type and room (default 200000).
+//   -seed <seed>   Seed for the rooms and workloads (default 1).
+//   -nomesh        Don't build the rooms' edge meshes, so that the box
+//                  sweeps test the blocks instead.
+//
+// It only needs the Room sources, e.g.:
+//
+//   g++ -O2 -std=c++11 -I.. RoomBenchmark.cpp ../Room.cpp ../RoomBlockGeometry.cpp
+//       ../RoomEdgeMesh.cpp ../RoomBGLayer.cpp ../Geom.cpp -lsfml-graphics -lsfml-window -lsfml-system
+//
+
+#include "Room.h"
+#include "BenchmarkRooms.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Auxiliary functions:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// The kinds of synthetic rooms:
+enum MapKind
+{
+	MAP_RANDOM,
+	MAP_SLOPES,
+	MAP_THIN_FLOORS,
+	MAP_SPARSE,
+	MAP_KIND_COUNT
+};
+
+static const char * mapKindNames[MAP_KIND_COUNT] = { "random", "slopes", "thinfloors", "sparse" };
+
+
+
+// Room sizes, in blocks:
+static const int roomSizes[][2] = { { 24, 18 }, { 120, 54 }, { 480, 108 } };
+static const int ROOM_SIZE_COUNT = sizeof(roomSizes) / sizeof(roomSizes[0]);
+
+static const int BLOCK_SIZE = 48;
+
+
+
+// Builds a room of the specified kind:
+static Room * buildRoom ( MapKind kind, int width, int height, bool withMesh, Random & rnd ) {
+	Room * room = new Room( BLOCK_SIZE, width, height, -1, 0 );
+	ObstacleGrid & grid = room->obstacleLayer;
+
+	static const RoomBlock::Type thinFloors[] = {
+		RoomBlock::BLK_THINFLOOR_HI, RoomBlock::BLK_THINFLOOR_MID, RoomBlock::BLK_THINFLOOR_LO };
+
+	switch ( kind ) {
+		case MAP_RANDOM:
+			// Half of the blocks are empty; the rest, of any type:
+			for ( int i = 0; i < height; i++ )
+				for ( int j = 0; j < width; j++ )
+					if ( rnd.range( 2 ) )
+						grid.set( i, j, (RoomBlock::Type) rnd.range( RoomBlockGeometry::SHAPE_COUNT - 1 ) );
+			break;
+
+		case MAP_SLOPES:
+			// Rolling hills:
+			buildHills( grid, rnd, 2, false );
+			break;
+
+		case MAP_THIN_FLOORS:
+			// A solid floor, with platforms of thin floors above it:
+			for ( int j = 0; j < width; j++ )
+				grid.set( height - 1, j, RoomBlock::BLK_FULL );
+
+			for ( int i = 2; i < height - 1; i += 3 ) {
+				for ( int j = 0; j < width; j++ ) {
+					if ( rnd.range( 3 ) ) {
+						RoomBlock::Type type = thinFloors[rnd.range( 3 )];
+						int length = 2 + rnd.range( 6 );
+
+						for ( ; length > 0 && j < width; length--, j++ )
+							grid.set( i, j, type );
+					}
+				}
+			}
+			break;
+
+		case MAP_SPARSE:
+			// A solid floor, and a few scattered blocks in the open air:
+			for ( int j = 0; j < width; j++ )
+				grid.set( height - 1, j, RoomBlock::BLK_FULL );
+
+			for ( int i = 0; i < height - 1; i++ )
+				for ( int j = 0; j < width; j++ )
+					if ( rnd.range( 100 ) < 3 )
+						grid.set( i, j, (RoomBlock::Type) rnd.range( RoomBlockGeometry::SHAPE_COUNT - 1 ) );
+			break;
+
+		default:
+			break;
+	}
+
+	if ( withMesh )
+		room->buildEdgeMesh();
+
+	return room;
+} // End of function: buildRoom
+
+
+
+// The kinds of queries:
+enum QueryKind
+{
+	QUERY_STATIC_POINT,
+	QUERY_MOVING_POINT,
+	QUERY_STATIC_SEGMENT,
+	QUERY_MOVING_SEGMENT,
+	QUERY_BOX_SWEEP,
+	QUERY_KIND_COUNT
+};
+
+static const char * queryKindNames[QUERY_KIND_COUNT] = { "static point", "moving point", "static segment", "moving segment",
+                                                         "box sweep" };
+
+
+
+// The first line of the recorded results. Version 1 files have no such
+// line, and no box sweeps:
+static const char * RESULTS_HEADER  = "RoomBenchmark results, version ";
+static const int    RESULTS_VERSION = 2;
+
+// Whether the results of a query kind are in files of a version:
+static inline bool isRecorded ( QueryKind kind, int version ) {
+	return version >= 2 || kind != QUERY_BOX_SWEEP;
+}
+
+
+
+// One randomized query: a segment from (x1, y1) to (x2, y2) -- or a point
+// at (x1, y1) -- possibly moving by (dx, dy):
+struct Query
+{
+	float x1, y1, x2, y2, dx, dy;
+	bool  thinFloor;
+};
+
+
+
+// Generates a workload that covers the room and its surroundings; segments
+// and displacements are up to two blocks long, as with game objects:
+static void buildWorkload ( const Room & room, int count, Random & rnd, std::vector<Query> & queries ) {
+	float maxX = (float) (room.obstacleLayer.columns * BLOCK_SIZE);
+	float maxY = (float) (room.obstacleLayer.rows    * BLOCK_SIZE);
+	float reach = 2.0f * BLOCK_SIZE;
+
+	queries.resize( count );
+
+	for ( int k = 0; k < count; k++ ) {
+		Query & q = queries[k];
+
+		q.x1 = rnd.range( -BLOCK_SIZE, maxX + BLOCK_SIZE );
+		q.y1 = rnd.range( -BLOCK_SIZE, maxY + BLOCK_SIZE );
+
+		// Mostly horizontal and vertical segments, like a character's sides:
+		switch ( rnd.range( 3 ) ) {
+			case 0:  q.x2 = q.x1 + rnd.range( -reach, reach ); q.y2 = q.y1;                             break;
+			case 1:  q.x2 = q.x1;                             q.y2 = q.y1 + rnd.range( -reach, reach ); break;
+			default: q.x2 = q.x1 + rnd.range( -reach, reach ); q.y2 = q.y1 + rnd.range( -reach, reach ); break;
+		}
+
+		q.dx = rnd.range( -reach, reach );
+		q.dy = rnd.range( -reach, reach );
+
+		q.thinFloor = (rnd.range( 2 ) != 0);
+	}
+} // End of function: buildWorkload
+
+
+
+// Runs a single query, and optionally writes its results as a line of text:
+static inline bool runQuery ( const Room & room, QueryKind kind, const Query & q,
+                              Container<Vector2D> & contacts, std::string * out ) {
+	char line[256];
+	bool hit = false;
+
+	switch ( kind ) {
+		case QUERY_STATIC_POINT:
+			hit = room.pointCollision( q.x1, q.y1 );
+			if ( out )
+				sprintf( line, "%d", hit );
+			break;
+
+		case QUERY_MOVING_POINT: {
+			Vector2D contact, normal;
+			hit = room.pointCollision( q.x1, q.y1, q.x1 + q.dx, q.y1 + q.dy, q.thinFloor, &contact, &normal );
+			if ( out ) {
+				if ( hit )
+					sprintf( line, "1 %.3f %.3f %.3f %.3f", contact.x, contact.y, normal.x, normal.y );
+				else
+					sprintf( line, "0" );
+			}
+			break;
+		}
+
+		case QUERY_STATIC_SEGMENT:
+			hit = room.segmentCollision( q.x1, q.y1, q.x2, q.y2, q.thinFloor );
+			if ( out )
+				sprintf( line, "%d", hit );
+			break;
+
+		case QUERY_MOVING_SEGMENT: {
+			Vector2D displacement;
+			hit = room.segmentCollision( q.x1, q.y1, q.x2, q.y2, q.dx, q.dy, q.thinFloor,
+			                             &contacts, NULL, &displacement );
+			if ( out ) {
+				if ( hit )
+					sprintf( line, "1 %.3f %.3f %.3f %.3f", displacement.x, displacement.y,
+					         contacts[0].x, contacts[0].y );
+				else
+					sprintf( line, "0" );
+			}
+			break;
+		}
+
+		case QUERY_BOX_SWEEP: {
+			// The box around the segment, at least one pixel wide and high:
+			Room::SweepResult sweep;
+			hit = room.boxSweep( std::min( q.x1, q.x2 ), std::min( q.y1, q.y2 ),
+			                     std::max( q.x1, q.x2 ) + 1, std::max( q.y1, q.y2 ) + 1,
+			                     q.dx, q.dy, q.thinFloor, &sweep );
+			if ( out ) {
+				if ( hit )
+					sprintf( line, "1 %.3f", sweep.time );
+				else
+					sprintf( line, "0" );
+			}
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	if ( out )
+		*out = line;
+
+	return hit;
+} // End of function: runQuery
+
+
+
+// Compares two result lines, allowing for small rounding differences:
+static bool sameResult ( const std::string & a, const std::string & b ) {
+	float va[5] = { 0 }, vb[5] = { 0 };
+	int na = sscanf( a.c_str(), "%f %f %f %f %f", &va[0], &va[1], &va[2], &va[3], &va[4] );
+	int nb = sscanf( b.c_str(), "%f %f %f %f %f", &vb[0], &vb[1], &vb[2], &vb[3], &vb[4] );
+
+	if ( na != nb )
+		return false;
+
+	for ( int k = 0; k < na; k++ )
+		if ( fabsf( va[k] - vb[k] ) > 0.01f )
+			return false;
+
+	return true;
+} // End of function: sameResult
+
+
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static inline double elapsedNs ( Clock::time_point from, Clock::time_point to ) {
+	return std::chrono::duration<double, std::nano>( to - from ).count();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Main:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+int main ( int argc, char ** argv ) {
+	int count = 200000;
+	unsigned int seed = 1;
+	const char * recordFile = NULL;
+	const char * verifyFile = NULL;
+	bool withMesh = true;
+
+	for ( int a = 1; a < argc; a++ ) {
+		if ( !strcmp( argv[a], "-n" ) && a + 1 < argc )
+			count = atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-seed" ) && a + 1 < argc )
+			seed = (unsigned int) atoi( argv[++a] );
+		else if ( !strcmp( argv[a], "-record" ) && a + 1 < argc )
+			recordFile = argv[++a];
+		else if ( !strcmp( argv[a], "-verify" ) && a + 1 < argc )
+			verifyFile = argv[++a];
+		else if ( !strcmp( argv[a], "-nomesh" ) )
+			withMesh = false;
+		else {
+			std::cerr << "Usage: " << argv[0] << " [-n count] [-seed seed] [-nomesh] [-record file | -verify file]" << std::endl;
+			return 2;
+		}
+	}
+
+	std::ofstream record;
+	std::ifstream reference;
+	std::string result, expected;
+	int  referenceVersion = RESULTS_VERSION;
+	bool expectedPending = false;
+
+	if ( recordFile ) {
+		record.open( recordFile );
+		if ( !record ) {
+			std::cerr << "Cannot write " << recordFile << std::endl;
+			return 2;
+		}
+
+		record << RESULTS_HEADER << RESULTS_VERSION << '\n';
+	}
+
+	if ( verifyFile ) {
+		reference.open( verifyFile );
+		if ( !reference ) {
+			std::cerr << "Cannot read " << verifyFile << std::endl;
+			return 2;
+		}
+
+		// Without a version line, the first line is already a result:
+		if ( std::getline( reference, expected ) ) {
+			if ( expected.compare( 0, strlen( RESULTS_HEADER ), RESULTS_HEADER ) == 0 )
+				referenceVersion = atoi( expected.c_str() + strlen( RESULTS_HEADER ) );
+			else {
+				// Only the box sweeps were recorded without a version line
+				// too; tell them apart by their length:
+				long lines = 1;
+				std::string line;
+				while ( std::getline( reference, line ) )
+					lines++;
+
+				long perKind = (long) MAP_KIND_COUNT * ROOM_SIZE_COUNT * count;
+				referenceVersion = (lines == perKind * QUERY_KIND_COUNT ? 2 : 1);
+
+				reference.clear();
+				reference.seekg( 0 );
+				std::getline( reference, expected );
+				expectedPending = true;
+			}
+		}
+
+		if ( referenceVersion < 1 || referenceVersion > RESULTS_VERSION ) {
+			std::cerr << verifyFile << " has results of an unknown version" << std::endl;
+			return 2;
+		}
+	}
+
+	printf( "%-11s %-9s %-15s %10s %9s %9s %9s %9s %7s\n",
+	        "room", "size", "query", "Mquery/s", "ns/query", "p50 ns", "p90 ns", "p99 ns", "hits %" );
+
+	Random rnd( seed );
+	std::vector<Query>  queries;
+	std::vector<double> latencies;
+	Container<Vector2D> contacts;
+	long mismatches = 0;
+
+	for ( int m = 0; m < MAP_KIND_COUNT; m++ ) {
+		for ( int s = 0; s < ROOM_SIZE_COUNT; s++ ) {
+			Room * room = buildRoom( (MapKind) m, roomSizes[s][0], roomSizes[s][1], withMesh, rnd );
+			buildWorkload( *room, count, rnd, queries );
+
+			char size[32];
+			sprintf( size, "%dx%d", roomSizes[s][0], roomSizes[s][1] );
+
+			for ( int k = 0; k < QUERY_KIND_COUNT; k++ ) {
+				QueryKind kind = (QueryKind) k;
+
+				// Throughput: the whole workload, without timing each query.
+				int hits = 0;
+				Clock::time_point start = Clock::now();
+
+				for ( int q = 0; q < count; q++ )
+					hits += runQuery( *room, kind, queries[q], contacts, NULL );
+
+				double total = elapsedNs( start, Clock::now() );
+
+				// Latency: each query on its own, minus the clock's overhead.
+				Clock::time_point t0 = Clock::now();
+				Clock::time_point t1 = Clock::now();
+				double overhead = elapsedNs( t0, t1 );
+
+				latencies.resize( count );
+				for ( int q = 0; q < count; q++ ) {
+					t0 = Clock::now();
+					runQuery( *room, kind, queries[q], contacts, NULL );
+					t1 = Clock::now();
+					latencies[q] = std::max( 0.0, elapsedNs( t0, t1 ) - overhead );
+				}
+
+				std::sort( latencies.begin(), latencies.end() );
+
+				printf( "%-11s %-9s %-15s %10.2f %9.1f %9.0f %9.0f %9.0f %7.1f\n",
+				        mapKindNames[m], size, queryKindNames[k],
+				        count / total * 1000.0, total / count,
+				        latencies[count / 2], latencies[count * 9 / 10], latencies[count * 99 / 100],
+				        100.0 * hits / count );
+
+				// Reference equivalence:
+				if ( recordFile || verifyFile ) {
+					for ( int q = 0; q < count; q++ ) {
+						runQuery( *room, kind, queries[q], contacts, &result );
+
+						if ( recordFile )
+							record << result << '\n';
+
+						if ( verifyFile && isRecorded( kind, referenceVersion ) ) {
+							if ( expectedPending )
+								expectedPending = false;
+							else
+							if ( !std::getline( reference, expected ) ) {
+								std::cerr << verifyFile << " is shorter than this run" << std::endl;
+								return 1;
+							}
+
+							if ( !sameResult( result, expected ) ) {
+								if ( mismatches < 20 ) {
+									const Query & r = queries[q];
+									fprintf( stderr, "Mismatch (%s, %s, %s): query (%g, %g)-(%g, %g) by (%g, %g) thin %d: "
+									         "expected \"%s\", got \"%s\"\n",
+									         mapKindNames[m], size, queryKindNames[k],
+									         r.x1, r.y1, r.x2, r.y2, r.dx, r.dy, (int) r.thinFloor,
+									         expected.c_str(), result.c_str() );
+								}
+								mismatches++;
+							}
+						}
+					}
+				}
+			}
+
+			delete room;
+		}
+	}
+
+	if ( verifyFile ) {
+		printf( "\n%ld mismatching results\n", mismatches );
+		return (mismatches > 0 ? 1 : 0);
+	}
+
+	return 0;
+}
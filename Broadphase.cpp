@@ -0,0 +1,169 @@
+#include "Broadphase.h"
+#include "Foreach.h"
+
+#include <algorithm>
+#include <cmath>
+
+Broadphase::Broadphase(float cellSize)
+: mCellSize(cellSize)
+, mRules()
+, mCategories(0)
+, mNodes()
+, mColliders()
+, mCellStart()
+, mCellEntries()
+, mGridOrigin()
+, mGridCellSize(cellSize)
+, mGridColumns(0)
+, mGridRows(0)
+{
+}
+
+void Broadphase::addRule(unsigned int category1, unsigned int category2)
+{
+	mRules.push_back(std::make_pair(category1, category2));
+	mCategories |= category1 | category2;
+}
+
+void Broadphase::findPairs(SceneNode& sceneGraph, std::vector<SceneNode::Pair>& pairs)
+{
+	mNodes.clear();
+	sceneGraph.collectNodes(mCategories, mNodes);
+
+	findPairs(mNodes, pairs);
+}
+
+void Broadphase::findPairs(const std::vector<SceneNode*>& nodes, std::vector<SceneNode::Pair>& pairs)
+{
+	pairs.clear();
+
+	// Compute every bounding rectangle once
+	mColliders.clear();
+	FOREACH(SceneNode* node, nodes)
+	{
+		if (!(node->getCategory() & mCategories) || node->isDestroyed())
+			continue;
+
+		Collider collider;
+		collider.node = node;
+		collider.rect = node->getBoundingRect();
+		collider.category = node->getCategory();
+		collider.mask = getMask(collider.category);
+
+		mColliders.push_back(collider);
+	}
+
+	bin();
+
+	// Test the colliders sharing a cell; a pair covering several cells is
+	// reported by the first one they share only
+	for (int cell = 0; cell < mGridColumns * mGridRows; ++cell)
+	{
+		for (std::size_t i = mCellStart[cell]; i < mCellStart[cell + 1]; ++i)
+		{
+			const Collider& first = mColliders[mCellEntries[i]];
+
+			for (std::size_t j = i + 1; j < mCellStart[cell + 1]; ++j)
+			{
+				const Collider& second = mColliders[mCellEntries[j]];
+
+				if (!(first.mask & second.category) || !first.rect.intersects(second.rect))
+					continue;
+
+				int firstShared = std::max(first.top, second.top) * mGridColumns + std::max(first.left, second.left);
+				if (firstShared == cell)
+					pairs.push_back(SceneNode::Pair(first.node, second.node));
+			}
+		}
+	}
+}
+
+unsigned int Broadphase::getMask(unsigned int category) const
+{
+	unsigned int mask = 0;
+
+	for (std::size_t i = 0; i < mRules.size(); ++i)
+	{
+		if (category & mRules[i].first)
+			mask |= mRules[i].second;
+		if (category & mRules[i].second)
+			mask |= mRules[i].first;
+	}
+
+	return mask;
+}
+
+void Broadphase::bin()
+{
+	mGridColumns = 0;
+	mGridRows = 0;
+
+	if (mColliders.empty())
+		return;
+
+	// Grid over the colliders' bounds; cells grow if the colliders are few
+	// and far apart, so that the grid stays proportional to their number
+	float left = mColliders[0].rect.left;
+	float top = mColliders[0].rect.top;
+	float right = left;
+	float bottom = top;
+
+	FOREACH(const Collider& collider, mColliders)
+	{
+		left = std::min(left, collider.rect.left);
+		top = std::min(top, collider.rect.top);
+		right = std::max(right, collider.rect.left + collider.rect.width);
+		bottom = std::max(bottom, collider.rect.top + collider.rect.height);
+	}
+
+	const int maxCells = std::max<int>(64, 4 * static_cast<int>(mColliders.size()));
+
+	mGridOrigin = sf::Vector2f(left, top);
+	mGridCellSize = mCellSize;
+
+	for (;;)
+	{
+		mGridColumns = static_cast<int>((right - left) / mGridCellSize) + 1;
+		mGridRows = static_cast<int>((bottom - top) / mGridCellSize) + 1;
+
+		if (mGridColumns * mGridRows <= maxCells)
+			break;
+
+		mGridCellSize *= 2.f;
+	}
+
+	// Count the entries per cell, then fill them in (counting sort)
+	const int cellCount = mGridColumns * mGridRows;
+	mCellStart.assign(cellCount + 1, 0);
+
+	FOREACH(Collider& collider, mColliders)
+	{
+		collider.left = static_cast<int>((collider.rect.left - left) / mGridCellSize);
+		collider.top = static_cast<int>((collider.rect.top - top) / mGridCellSize);
+		collider.right = std::min(mGridColumns - 1, static_cast<int>((collider.rect.left + collider.rect.width - left) / mGridCellSize));
+		collider.bottom = std::min(mGridRows - 1, static_cast<int>((collider.rect.top + collider.rect.height - top) / mGridCellSize));
+
+		for (int y = collider.top; y <= collider.bottom; ++y)
+			for (int x = collider.left; x <= collider.right; ++x)
+				++mCellStart[y * mGridColumns + x + 1];
+	}
+
+	for (int cell = 0; cell < cellCount; ++cell)
+		mCellStart[cell + 1] += mCellStart[cell];
+
+	mCellEntries.resize(mCellStart[cellCount]);
+
+	for (std::size_t i = 0; i < mColliders.size(); ++i)
+	{
+		const Collider& collider = mColliders[i];
+
+		for (int y = collider.top; y <= collider.bottom; ++y)
+			for (int x = collider.left; x <= collider.right; ++x)
+				mCellEntries[mCellStart[y * mGridColumns + x]++] = i;
+	}
+
+	// Filling moved each cell's start to the next one's: shift them back
+	for (int cell = cellCount; cell > 0; --cell)
+		mCellStart[cell] = mCellStart[cell - 1];
+	mCellStart[0] = 0;
+}
@@ -0,0 +1,62 @@
+#ifndef _Broadphase_h_
+#define _Broadphase_h_
+
+#include "SceneNode.h"
+
+#include <SFML\Graphics.hpp>
+#include <vector>
+
+// Finds the scene nodes whose bounding rectangles intersect, in about
+// O(n + k) for n nodes and k pairs: The rectangles are computed once, and
+// binned into a uniform grid; only nodes sharing a cell are tested. Only
+// categories that interact (see addRule()) are tested against each other.
+//
+// The pairs come out in a deterministic order: by grid cell, then in the
+// order of the nodes.
+class Broadphase : private sf::NonCopyable
+{
+	public:
+		explicit				Broadphase(float cellSize);
+
+		// Nodes of category1 collide with nodes of category2 (and vice versa)
+		void					addRule(unsigned int category1, unsigned int category2);
+
+		// Collects the nodes of the scene graph that take part in a rule, and
+		// aren't destroyed, and returns the intersecting pairs
+		void					findPairs(SceneNode& sceneGraph, std::vector<SceneNode::Pair>& pairs);
+
+		// Same, for candidate nodes found some other way (e.g. by a spatial query)
+		void					findPairs(const std::vector<SceneNode*>& nodes, std::vector<SceneNode::Pair>& pairs);
+
+
+	private:
+		struct Collider
+		{
+			SceneNode*			node;
+			sf::FloatRect		rect;
+			unsigned int		category;
+			unsigned int		mask;		// Categories it collides with
+			int					left, top, right, bottom;	// Cells covered
+		};
+
+		unsigned int			getMask(unsigned int category) const;
+		void					bin();
+
+
+	private:
+		float					mCellSize;
+		std::vector<std::pair<unsigned int, unsigned int>>	mRules;
+		unsigned int			mCategories;	// Union of all rules
+
+		// Scratch space, kept between frames
+		std::vector<SceneNode*>	mNodes;
+		std::vector<Collider>	mColliders;
+		std::vector<std::size_t> mCellStart;	// Per cell, first entry in mCellEntries
+		std::vector<std::size_t> mCellEntries;	// Collider indices, grouped by cell
+		sf::Vector2f			mGridOrigin;
+		float					mGridCellSize;
+		int						mGridColumns;
+		int						mGridRows;
+};
+
+#endif
@@ -16,8 +16,8 @@ namespace
 Character::Character(Type type, const TextureManager& textures, const FontManager& fonts)
 : Entity(Table[type].hitpoints)
 , mType(type)
-, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
-, mExplosion(textures.get(Textures::Explosion))
+, mSprite()
+, mExplosion()
 , mFireCommand()
 , mMissileCommand()
 , mFireCountdown(sf::Time::Zero)
@@ -34,6 +34,13 @@ Character::Character(Type type, const TextureManager& textures, const FontManage
 , mHealthDisplay(nullptr)
 , mMissileDisplay(nullptr)
 {
+	// Headless worlds have no textures: the rects still give the bounds
+	mSprite.setTextureRect(Table[type].textureRect);
+	if (const sf::Texture* texture = textures.find(Table[type].texture))
+		mSprite.setTexture(*texture);
+	if (const sf::Texture* explosion = textures.find(Textures::Explosion))
+		mExplosion.setTexture(*explosion);
+
 	mExplosion.setFrameSize(sf::Vector2i(256, 256));
 	mExplosion.setNumFrames(16);
 	mExplosion.setDuration(sf::seconds(1));
@@ -1,5 +1,70 @@
 #include "Command.h"
 
+CommandAction::CommandAction()
+: mBuffer()
+, mOperations(nullptr)
+, mOnHeap(false)
+{
+}
+
+CommandAction::CommandAction(const CommandAction& other)
+: mBuffer()
+, mOperations(other.mOperations)
+, mOnHeap(other.mOnHeap)
+{
+	if (mOperations)
+		mOperations->copy(other.getFunction(), &mBuffer);
+}
+
+CommandAction::~CommandAction()
+{
+	reset();
+}
+
+CommandAction& CommandAction::operator= (const CommandAction& other)
+{
+	if (this != &other)
+	{
+		reset();
+
+		if (other.mOperations)
+			other.mOperations->copy(other.getFunction(), &mBuffer);
+
+		mOperations = other.mOperations;
+		mOnHeap = other.mOnHeap;
+	}
+
+	return *this;
+}
+
+void CommandAction::operator() (SceneNode& node, sf::Time dt) const
+{
+	assert(mOperations);
+
+	mOperations->invoke(getFunction(), node, dt);
+}
+
+CommandAction::operator bool() const
+{
+	return mOperations != nullptr;
+}
+
+void CommandAction::reset()
+{
+	if (mOperations)
+		mOperations->destroy(const_cast<void*>(getFunction()));
+
+	mOperations = nullptr;
+	mOnHeap = false;
+}
+
+const void* CommandAction::getFunction() const
+{
+	// Heap functions keep a pointer to them in the buffer
+	return mOnHeap ? *reinterpret_cast<void* const*>(&mBuffer) : static_cast<const void*>(&mBuffer);
+}
+
+
 Command::Command()
 	: action(), category(CommandCategory::None)
-{}
\ No newline at end of file
+{}
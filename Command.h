@@ -5,14 +5,78 @@
 #include "SFML\Graphics.hpp"
 #include "SFML\System.hpp"
 
-#include <functional>
 #include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 class SceneNode;
 
+// Callable like std::function<void(SceneNode&, sf::Time)>, but functions of
+// up to BufferSize bytes are stored inline, so that copying commands around
+// doesn't allocate; larger ones go on the heap. Calls go through a plain
+// function pointer.
+class CommandAction
+{
+	public:
+		enum
+		{
+			BufferSize = 48
+		};
+
+
+	public:
+								CommandAction();
+								CommandAction(const CommandAction& other);
+								~CommandAction();
+
+		template <typename Function, typename = typename std::enable_if<!std::is_same<typename std::decay<Function>::type, CommandAction>::value>::type>
+								CommandAction(Function fn);
+
+		CommandAction&			operator= (const CommandAction& other);
+
+		void					operator() (SceneNode& node, sf::Time dt) const;
+		explicit				operator bool() const;
+
+
+	private:
+		struct Operations
+		{
+			void				(*invoke)(const void* function, SceneNode& node, sf::Time dt);
+			void				(*copy)(const void* function, void* buffer);
+			void				(*destroy)(void* function);
+		};
+
+		template <typename Function>
+		struct InlineOperations;
+
+		template <typename Function>
+		struct HeapOperations;
+
+		// Whether the function is stored inline, known at compile time so that
+		// only one of the two ways is compiled for each function type
+		template <typename Function>
+		struct FitsInline;
+
+		template <typename Function>
+		void					construct(Function& fn, std::true_type inlineStorage);
+
+		template <typename Function>
+		void					construct(Function& fn, std::false_type inlineStorage);
+
+		void					reset();
+		const void*				getFunction() const;
+
+
+	private:
+		typename std::aligned_storage<BufferSize>::type	mBuffer;	// The function, or a pointer to it
+		const Operations*		mOperations;
+		bool					mOnHeap;
+};
+
 struct Command
 {
-	typedef std::function<void(SceneNode&, sf::Time)> Action;
+	typedef CommandAction Action;
 
 								Command();
 
@@ -33,4 +97,5 @@ Command::Action derivedAction(Function fn)
 	};
 }
 
-#endif
\ No newline at end of file
+#include "Command.inl"
+#endif
@@ -0,0 +1,88 @@
+
+template <typename Function>
+struct CommandAction::InlineOperations
+{
+	static void invoke(const void* function, SceneNode& node, sf::Time dt)
+	{
+		(*static_cast<const Function*>(function))(node, dt);
+	}
+
+	static void copy(const void* function, void* buffer)
+	{
+		new (buffer) Function(*static_cast<const Function*>(function));
+	}
+
+	static void destroy(void* function)
+	{
+		static_cast<Function*>(function)->~Function();
+	}
+
+	static const Operations operations;
+};
+
+template <typename Function>
+const CommandAction::Operations CommandAction::InlineOperations<Function>::operations =
+{
+	&CommandAction::InlineOperations<Function>::invoke,
+	&CommandAction::InlineOperations<Function>::copy,
+	&CommandAction::InlineOperations<Function>::destroy
+};
+
+template <typename Function>
+struct CommandAction::HeapOperations
+{
+	static void invoke(const void* function, SceneNode& node, sf::Time dt)
+	{
+		(*static_cast<const Function*>(function))(node, dt);
+	}
+
+	static void copy(const void* function, void* buffer)
+	{
+		*static_cast<void**>(buffer) = new Function(*static_cast<const Function*>(function));
+	}
+
+	static void destroy(void* function)
+	{
+		delete static_cast<Function*>(function);
+	}
+
+	static const Operations operations;
+};
+
+template <typename Function>
+const CommandAction::Operations CommandAction::HeapOperations<Function>::operations =
+{
+	&CommandAction::HeapOperations<Function>::invoke,
+	&CommandAction::HeapOperations<Function>::copy,
+	&CommandAction::HeapOperations<Function>::destroy
+};
+
+template <typename Function>
+struct CommandAction::FitsInline : std::integral_constant<bool,
+	sizeof(Function) <= BufferSize &&
+	std::alignment_of<Function>::value <= std::alignment_of<std::aligned_storage<BufferSize>::type>::value>
+{
+};
+
+template <typename Function, typename>
+CommandAction::CommandAction(Function fn)
+: mBuffer()
+, mOperations(nullptr)
+, mOnHeap(!FitsInline<Function>::value)
+{
+	construct(fn, FitsInline<Function>());
+}
+
+template <typename Function>
+void CommandAction::construct(Function& fn, std::true_type)
+{
+	new (&mBuffer) Function(std::move(fn));
+	mOperations = &InlineOperations<Function>::operations;
+}
+
+template <typename Function>
+void CommandAction::construct(Function& fn, std::false_type)
+{
+	*reinterpret_cast<void**>(&mBuffer) = new Function(std::move(fn));
+	mOperations = &HeapOperations<Function>::operations;
+}
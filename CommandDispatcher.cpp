@@ -0,0 +1,145 @@
+#include "CommandDispatcher.h"
+#include "SceneNode.h"
+
+#include <algorithm>
+#include <cassert>
+
+CommandDispatcher::CommandDispatcher()
+: mRegistrations()
+, mFreeRegistrations()
+, mRemoved()
+, mRemovedCategories(0)
+, mDispatchDepth(0)
+, mEntries()
+, mPending()
+{
+}
+
+unsigned int CommandDispatcher::addNode(SceneNode& node, unsigned int category)
+{
+	unsigned int registration;
+
+	if (mFreeRegistrations.empty())
+	{
+		registration = static_cast<unsigned int>(mRegistrations.size());
+		mRegistrations.push_back(Registration());
+	}
+	else
+	{
+		registration = mFreeRegistrations.back();
+		mFreeRegistrations.pop_back();
+	}
+
+	mRegistrations[registration].node = &node;
+	mRegistrations[registration].category = category;
+
+	for (std::size_t bit = 0; bit < CategoryBitCount; ++bit)
+	{
+		if (category & (1u << bit))
+			mEntries[bit].push_back(registration);
+	}
+
+	return registration;
+}
+
+void CommandDispatcher::removeNode(unsigned int registration)
+{
+	assert(mRegistrations[registration].node != nullptr);
+
+	// The entries stay until the next dropRemovedNodes(), and the
+	// registration isn't reused before
+	mRegistrations[registration].node = nullptr;
+	mRemovedCategories |= mRegistrations[registration].category;
+	mRemoved.push_back(registration);
+}
+
+void CommandDispatcher::dispatch(const Command& command, sf::Time dt)
+{
+	// From an action, the outer dispatch is still going through the entries
+	if (mDispatchDepth == 0)
+		dropRemovedNodes();
+
+	dispatch(&command, 1, dt);
+}
+
+void CommandDispatcher::dispatch(CommandQueue& commands, sf::Time dt)
+{
+	assert(mDispatchDepth == 0);
+	dropRemovedNodes();
+
+	while (!commands.isEmpty())
+	{
+		commands.popAll(mPending);
+
+		for (std::size_t first = 0; first < mPending.size(); )
+		{
+			std::size_t last = first + 1;
+			while (last < mPending.size() && mPending[last].category == mPending[first].category)
+				++last;
+
+			dispatch(&mPending[first], last - first, dt);
+			first = last;
+		}
+
+		mPending.clear();
+	}
+}
+
+void CommandDispatcher::dispatch(const Command* commands, std::size_t count, sf::Time dt)
+{
+	// All commands of the batch share the categories
+	unsigned int categories = commands[0].category;
+	++mDispatchDepth;
+
+	for (std::size_t bit = 0; bit < CategoryBitCount; ++bit)
+	{
+		unsigned int category = 1u << bit;
+		if (!(categories & category))
+			continue;
+
+		// Indices rather than iterators or references: the actions may attach
+		// nodes. Look the node up for each command, as one may remove it
+		std::vector<unsigned int>& entries = mEntries[bit];
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			unsigned int registration = entries[i];
+
+			// A node in several of the command's categories takes it once, in the lowest
+			if (mRegistrations[registration].category & categories & (category - 1))
+				continue;
+
+			for (std::size_t c = 0; c < count; ++c)
+			{
+				SceneNode* node = mRegistrations[registration].node;
+				if (!node)
+					break;
+
+				commands[c].action(*node, dt);
+			}
+		}
+	}
+
+	--mDispatchDepth;
+}
+
+void CommandDispatcher::dropRemovedNodes()
+{
+	if (mRemoved.empty())
+		return;
+
+	// One pass over the categories that lost nodes; erasing in place keeps
+	// the attach order
+	for (std::size_t bit = 0; bit < CategoryBitCount; ++bit)
+	{
+		if (!(mRemovedCategories & (1u << bit)))
+			continue;
+
+		std::vector<unsigned int>& entries = mEntries[bit];
+		entries.erase(std::remove_if(entries.begin(), entries.end(),
+			[this] (unsigned int registration) { return mRegistrations[registration].node == nullptr; }), entries.end());
+	}
+
+	mFreeRegistrations.insert(mFreeRegistrations.end(), mRemoved.begin(), mRemoved.end());
+	mRemoved.clear();
+	mRemovedCategories = 0;
+}
@@ -0,0 +1,69 @@
+#ifndef _CommandDispatcher_h_
+#define _CommandDispatcher_h_
+
+#include "Command.h"
+#include "CommandQueue.h"
+
+#include <SFML\System.hpp>
+#include <array>
+#include <vector>
+
+// Keeps the nodes of a scene graph by category, so that a command goes
+// straight to the nodes it's meant for, instead of down the whole graph.
+// The nodes register themselves (see SceneNode::setCommandDispatcher()).
+//
+// A command reaches its nodes category by category (lowest bit first), and
+// within a category in the order they were attached.
+class CommandDispatcher : private sf::NonCopyable
+{
+	public:
+								CommandDispatcher();
+
+		// Returns the node's registration, to remove it with
+		unsigned int			addNode(SceneNode& node, unsigned int category);
+
+		// Only marks the node's entries as removed; they're dropped at the
+		// next dispatch that isn't made from an action
+		void					removeNode(unsigned int registration);
+
+		// Nodes attached by the action receive the command too, if their
+		// category matches; nodes detached or destroyed meanwhile are skipped
+		void					dispatch(const Command& command, sf::Time dt);
+
+		// Dispatches the queue until it's empty (commands pushed by the actions
+		// too). Consecutive commands for the same categories are dispatched as
+		// a batch: each recipient receives all of them in turn, so they must
+		// not depend on each other's effects on other nodes. Not to be called
+		// from the actions
+		void					dispatch(CommandQueue& commands, sf::Time dt);
+
+
+	private:
+		struct Registration
+		{
+			SceneNode*			node;		// nullptr once removed
+			unsigned int		category;
+		};
+
+		enum
+		{
+			CategoryBitCount = 32
+		};
+
+
+		void					dispatch(const Command* commands, std::size_t count, sf::Time dt);
+		void					dropRemovedNodes();
+
+
+	private:
+		std::vector<Registration>	mRegistrations;
+		std::vector<unsigned int>	mFreeRegistrations;
+		std::vector<unsigned int>	mRemoved;		// Freed by dropRemovedNodes()
+		unsigned int				mRemovedCategories;
+		unsigned int				mDispatchDepth;	// Entries are only dropped at 0
+
+		std::array<std::vector<unsigned int>, CategoryBitCount>	mEntries;	// Registrations per category bit
+		std::vector<Command>	mPending;	// Commands taken from the queue, kept allocated
+};
+
+#endif
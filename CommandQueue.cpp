@@ -1,19 +1,47 @@
 #include "CommandQueue.h"
 #include "SceneNode.h"
 
+CommandQueue::CommandQueue()
+: mQueue()
+, mFront(0)
+{
+}
+
 void CommandQueue::push(const Command& command)
 {
-	mQueue.push(command);
+	mQueue.push_back(command);
 }
 
 Command CommandQueue::pop()
 {
-	Command command = mQueue.front();
-	mQueue.pop();
+	Command command = mQueue[mFront++];
+
+	// Drained: start over at the front of the storage
+	if (mFront == mQueue.size())
+	{
+		mQueue.clear();
+		mFront = 0;
+	}
+
 	return command;
 }
 
 bool CommandQueue::isEmpty() const
 {
-	return mQueue.empty();
+	return mFront == mQueue.size();
+}
+
+void CommandQueue::popAll(std::vector<Command>& commands)
+{
+	if (commands.empty() && mFront == 0)
+	{
+		commands.swap(mQueue);
+	}
+	else
+	{
+		commands.insert(commands.end(), mQueue.begin() + mFront, mQueue.end());
+		mQueue.clear();
+	}
+
+	mFront = 0;
 }
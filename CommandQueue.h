@@ -3,17 +3,27 @@
 
 #include "Command.h"
 
-#include <queue>
+#include <vector>
 
+// FIFO of commands. The storage is kept once drained, so that queueing the
+// commands of a frame doesn't allocate once the queue has grown to size.
 class CommandQueue
 {
 public:
+							CommandQueue();
+
 	void					push(const Command& command);
 	Command					pop();
 	bool					isEmpty() const;
+
+	// Moves all queued commands to the end of commands, in order; commands
+	// pushed afterwards stay queued. Swapping buffers back and forth with
+	// the caller keeps both allocated.
+	void					popAll(std::vector<Command>& commands);
 	
 private:
-	std::queue<Command>		mQueue;
+	std::vector<Command>	mQueue;
+	std::size_t				mFront;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -1,4 +1,5 @@
 #include "EmitterNode.h"
+#include "NodePool.h"
 #include "ParticleNode.h"
 #include "CommandQueue.h"
 #include "Command.h"
@@ -7,15 +8,15 @@ EmitterNode::EmitterNode(Particle::Type type)
 : SceneNode()
 , mAccumulatedTime(sf::Time::Zero)
 , mType(type)
-, mParticleSystem(nullptr)
+, mParticleSystem()
 {
 }
 
 void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands)
 {
-	if (mParticleSystem)
+	if (ParticleNode* particleSystem = getParticleSystem())
 	{
-		emitParticles(dt);
+		emitParticles(*particleSystem, dt);
 	}
 	else
 	{
@@ -23,7 +24,7 @@ void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands)
 		auto finder = [this] (ParticleNode& container, sf::Time)
 		{
 			if (container.getParticleType() == mType)
-				mParticleSystem = &container;
+				mParticleSystem = container.getHandle();
 		};
 
 		Command command;
@@ -34,7 +35,7 @@ void EmitterNode::updateCurrent(sf::Time dt, CommandQueue& commands)
 	}
 }
 
-void EmitterNode::emitParticles(sf::Time dt)
+void EmitterNode::emitParticles(ParticleNode& particleSystem, sf::Time dt)
 {
 	const float emissionRate = 30.f;
 	const sf::Time interval = sf::seconds(1.f) / emissionRate;
@@ -44,6 +45,23 @@ void EmitterNode::emitParticles(sf::Time dt)
 	while (mAccumulatedTime > interval)
 	{
 		mAccumulatedTime -= interval;
-		mParticleSystem->addParticle(getWorldPosition());
+		particleSystem.addParticle(getWorldPosition());
 	}
-}
\ No newline at end of file
+}
+
+ParticleNode* EmitterNode::getParticleSystem() const
+{
+	// nullptr until found, and if the particle node has been removed since
+	EntityRegistry* registry = getEntityRegistry();
+	return registry ? registry->get<ParticleNode>(mParticleSystem) : nullptr;
+}
+
+void* EmitterNode::operator new(std::size_t size)
+{
+	return NodePool<EmitterNode>::allocate(size);
+}
+
+void EmitterNode::operator delete(void* block, std::size_t size)
+{
+	NodePool<EmitterNode>::deallocate(block, size);
+}
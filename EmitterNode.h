@@ -6,22 +6,29 @@
 
 class ParticleNode;
 
+// Emits into the particle node of its type, which it finds through the
+// scene graph's entity registry (see SceneNode::setEntityRegistry())
 class EmitterNode : public SceneNode
 {
 	public:
 		explicit				EmitterNode(Particle::Type type);
 
+		// Storage recycled through NodePool
+		static void*			operator new(std::size_t size);
+		static void				operator delete(void* block, std::size_t size);
+
 
 	private:
 		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
 		
-		void					emitParticles(sf::Time dt);
+		void					emitParticles(ParticleNode& particleSystem, sf::Time dt);
+		ParticleNode*			getParticleSystem() const;
 
 
 	private:
 		sf::Time				mAccumulatedTime;
 		Particle::Type			mType;
-		ParticleNode*			mParticleSystem;
+		EntityHandle			mParticleSystem;
 };
 
 #endif
\ No newline at end of file
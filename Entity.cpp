@@ -1,4 +1,6 @@
 #include "Entity.h"
+#include "Utility.h"
+#include "QuadTree.h"
 
 #include <cassert>
 
@@ -51,12 +53,20 @@ void Entity::damage(int points)
 {
 	assert(points > 0);
 
+	bool wasDestroyed = isDestroyed();
 	mHitpoints -= points;
+
+	if (!wasDestroyed && isDestroyed())
+		notifyDestroyed();
 }
 
 void Entity::destroy()
 {
+	bool wasDestroyed = isDestroyed();
 	mHitpoints = 0;
+
+	if (!wasDestroyed)
+		notifyDestroyed();
 }
 
 void Entity::remove()
@@ -69,7 +79,38 @@ bool Entity::isDestroyed() const
 	return mHitpoints <= 0;
 }
 
+void Entity::updateBounds()
+{
+	if (!GetTree())
+		return;
+
+	m_aabb = getBoundingRect();
+	TreeUpdate();
+}
+
 void Entity::updateCurrent(sf::Time dt, CommandQueue&)
 {	
 	move(mVelocity * dt.asSeconds());
+	updateBounds();
+}
+
+void Entity::enterQuadTree(qdt::QuadTree& quadTree)
+{
+	m_aabb = getBoundingRect();
+	quadTree.Add(this);
+}
+
+void Entity::leaveQuadTree()
+{
+	RemoveFromTree();
+}
+
+unsigned int Entity::getChecksumCurrent(unsigned int hash) const
+{
+	hash = SceneNode::getChecksumCurrent(hash);
+	hash = hashFloat(hash, mVelocity.x);
+	hash = hashFloat(hash, mVelocity.y);
+	hash = hashInt(hash, mHitpoints);
+
+	return hash;
 }
\ No newline at end of file
@@ -2,8 +2,11 @@
 #define _Entity_h_
 
 #include "SceneNode.h"
+#include "QuadTreeOccupant.h"
 
-class Entity : public SceneNode
+// Entities attached to a node with a quadtree (see SceneNode::setQuadTree())
+// are indexed by their bounding rectangle
+class Entity : public SceneNode, public qdt::QuadTreeOccupant
 {
 	public:
 		explicit			Entity(int hitpoints);
@@ -21,9 +24,19 @@ class Entity : public SceneNode
 		virtual void		remove();
 		virtual bool		isDestroyed() const;
 
+		// Moves the entity's bounds in its quadtree; update() does so already,
+		// call it after moving the entity elsewhere
+		void				updateBounds();
+
 
 	protected:
 		virtual void		updateCurrent(sf::Time dt, CommandQueue& commands);
+		virtual unsigned int	getChecksumCurrent(unsigned int hash) const;
+
+
+	private:
+		virtual void		enterQuadTree(qdt::QuadTree& quadTree);
+		virtual void		leaveQuadTree();
 
 
 	private:
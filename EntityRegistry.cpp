@@ -0,0 +1,131 @@
+#include "EntityRegistry.h"
+#include "SceneNode.h"
+#include "Foreach.h"
+
+#include <algorithm>
+
+EntityHandle::EntityHandle()
+: index(0)
+, generation(0)
+{
+}
+
+bool operator== (EntityHandle lhs, EntityHandle rhs)
+{
+	return lhs.index == rhs.index && lhs.generation == rhs.generation;
+}
+
+bool operator!= (EntityHandle lhs, EntityHandle rhs)
+{
+	return !(lhs == rhs);
+}
+
+
+EntityRegistry::EntityRegistry()
+: mSlots()
+, mFreeSlots()
+, mDestroyed()
+, mWreckParents()
+{
+}
+
+EntityHandle EntityRegistry::add(SceneNode& node)
+{
+	EntityHandle handle;
+
+	if (mFreeSlots.empty())
+	{
+		// Generations start at 1, so that default handles never resolve
+		Slot slot;
+		slot.node = nullptr;
+		slot.generation = 1;
+
+		handle.index = static_cast<unsigned int>(mSlots.size());
+		mSlots.push_back(slot);
+	}
+	else
+	{
+		handle.index = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+
+	Slot& slot = mSlots[handle.index];
+	slot.node = &node;
+	handle.generation = slot.generation;
+
+	return handle;
+}
+
+void EntityRegistry::remove(EntityHandle handle)
+{
+	assert(get(handle) != nullptr);
+
+	// Invalidate the handles to the node; skip 0 on wrap-around
+	Slot& slot = mSlots[handle.index];
+	slot.node = nullptr;
+	if (++slot.generation == 0)
+		slot.generation = 1;
+
+	mFreeSlots.push_back(handle.index);
+}
+
+SceneNode* EntityRegistry::get(EntityHandle handle) const
+{
+	if (handle.index >= mSlots.size())
+		return nullptr;
+
+	const Slot& slot = mSlots[handle.index];
+	return slot.generation == handle.generation ? slot.node : nullptr;
+}
+
+void EntityRegistry::markDestroyed(EntityHandle handle)
+{
+	assert(get(handle) != nullptr);
+
+	mDestroyed.push_back(handle);
+}
+
+void EntityRegistry::removeWrecks()
+{
+	// Keep the nodes that aren't ready yet, find the parents of the others
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < mDestroyed.size(); ++i)
+	{
+		SceneNode* node = get(mDestroyed[i]);
+
+		// Already removed along with an ancestor, or detached
+		if (!node)
+			continue;
+
+		if (!node->isMarkedForRemoval())
+		{
+			mDestroyed[kept++] = mDestroyed[i];
+			continue;
+		}
+
+		SceneNode* parent = node->getParent();
+		if (!parent)
+			continue;
+
+		EntityHandle parentHandle = parent->getHandle();
+		if (std::find(mWreckParents.begin(), mWreckParents.end(), parentHandle) == mWreckParents.end())
+			mWreckParents.push_back(parentHandle);
+	}
+
+	mDestroyed.resize(kept);
+
+	// One pass per parent, whatever the number of wrecks; a parent may itself
+	// go with an earlier one, so go through the handles
+	FOREACH(EntityHandle parentHandle, mWreckParents)
+	{
+		if (SceneNode* parent = get(parentHandle))
+			parent->removeChildWrecks();
+	}
+
+	mWreckParents.clear();
+}
+
+std::size_t EntityRegistry::getSize() const
+{
+	return mSlots.size() - mFreeSlots.size();
+}
@@ -0,0 +1,72 @@
+#ifndef _EntityRegistry_h_
+#define _EntityRegistry_h_
+
+#include <SFML\System.hpp>
+#include <cassert>
+#include <vector>
+
+class SceneNode;
+
+// Refers to a node of an EntityRegistry. Stays valid as long as the node
+// exists; afterwards it resolves to nullptr, even if the slot is reused.
+struct EntityHandle
+{
+							EntityHandle();
+
+	unsigned int			index;
+	unsigned int			generation;
+};
+
+bool	operator== (EntityHandle lhs, EntityHandle rhs);
+bool	operator!= (EntityHandle lhs, EntityHandle rhs);
+
+
+// Gives the nodes of a scene graph a handle each, to keep references to
+// other nodes (the player, missile targets, particle systems...) without
+// dangling once they're removed. The nodes register themselves (see
+// SceneNode::setEntityRegistry()).
+//
+// Destroyed nodes are reported as well, so that removeWrecks() only looks at
+// them rather than at the whole graph.
+class EntityRegistry : private sf::NonCopyable
+{
+	public:
+								EntityRegistry();
+
+		EntityHandle			add(SceneNode& node);
+		void					remove(EntityHandle handle);
+
+		// nullptr if the node was removed in the meantime
+		SceneNode*				get(EntityHandle handle) const;
+
+		template <typename Node>
+		Node*					get(EntityHandle handle) const;
+
+		// The node stays in the graph until it's marked for removal (e.g.
+		// after its explosion), and is checked every removeWrecks() until then
+		void					markDestroyed(EntityHandle handle);
+
+		// Detaches and deletes the destroyed nodes that are marked for
+		// removal; call it between frames, when nothing refers to them
+		void					removeWrecks();
+
+		std::size_t				getSize() const;
+
+
+	private:
+		struct Slot
+		{
+			SceneNode*			node;
+			unsigned int		generation;
+		};
+
+
+	private:
+		std::vector<Slot>			mSlots;
+		std::vector<unsigned int>	mFreeSlots;
+		std::vector<EntityHandle>	mDestroyed;
+		std::vector<EntityHandle>	mWreckParents;	// Kept allocated between calls
+};
+
+#include "EntityRegistry.inl"
+#endif
@@ -0,0 +1,11 @@
+
+template <typename Node>
+Node* EntityRegistry::get(EntityHandle handle) const
+{
+	SceneNode* node = get(handle);
+
+	// Check if cast is safe
+	assert(node == nullptr || dynamic_cast<Node*>(node) != nullptr);
+
+	return static_cast<Node*>(node);
+}
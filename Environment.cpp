@@ -1,11 +1,13 @@
 #include "Environment.h"
 #include "Animation.h"
 #include "MapLoader.h"
+#include "Utility.h"
 
 Environment::Environment(sf::RenderTarget& outputTarget, TextureManager& textures, FontManager& fonts)
 : mTarget(outputTarget)
 , mSceneTexture()
 , mWorldView(outputTarget.getDefaultView())
+, mCommandDispatcher()
 , mSceneGraph()
 , mTextures(textures) 
 , mFonts(fonts)
@@ -22,6 +24,7 @@ Environment::Environment(sf::RenderTarget& outputTarget, TextureManager& texture
 	}
 
 	mSceneTexture.create(mTarget.getSize().x, mTarget.getSize().y);
+	mSceneGraph.setCommandDispatcher(&mCommandDispatcher);
 
 	//create background
 	mTextures.load(Textures::Background, "../resources/Textures/Background.png");
@@ -63,8 +66,7 @@ void Environment::update(sf::Time dt)
 	getCurrentMap().update(dt);
 
 	// Forward commands to scene graph
-	while (!mCommandQueue.isEmpty())
-		mSceneGraph.onCommand(mCommandQueue.pop(), dt);
+	mCommandDispatcher.dispatch(mCommandQueue, dt);
 
 	// Regular update step, adapt position
 	mSceneGraph.update(dt, mCommandQueue);
@@ -84,7 +86,7 @@ void Environment::draw()
 	}
 
 	// DRAW WATER
-	if(mRoom->waterLevel > 0)
+	if(mRoom->hasWater())
 	{
 		Animation anim(mTextures.get(Textures::Water));
 		anim.setFrameSize(sf::Vector2i(32,32));
@@ -163,6 +165,11 @@ CommandQueue& Environment::getCommandQueue()
 	return mCommandQueue;
 }
 
+unsigned int Environment::getChecksum() const
+{
+	return mSceneGraph.getChecksum(2166136261u);
+}
+
 const Map& Environment::getCurrentMap() const
 {
 	auto found = mMaps.find(0);
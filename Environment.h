@@ -7,6 +7,7 @@
 #include "SpriteNode.h"
 #include "CommandQueue.h"
 #include "Command.h"
+#include "CommandDispatcher.h"
 #include "Room.h"
 #include "Platformer.h"
 #include "EffectBloom.h"
@@ -24,6 +25,7 @@ class Environment : private sf::NonCopyable
 		void								draw();
  
 		CommandQueue&						getCommandQueue();
+		unsigned int						getChecksum() const;
 
 	private:
 		const Map&							getCurrentMap() const;
@@ -33,6 +35,9 @@ class Environment : private sf::NonCopyable
 		sf::RenderTexture					mSceneTexture;
 
 		sf::View							mWorldView;
+
+		// Declared before the scene graph, which unregisters from it when destroyed
+		CommandDispatcher					mCommandDispatcher;
 		
 		SceneNode							mSceneGraph;
 
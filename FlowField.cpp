@@ -0,0 +1,215 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+FlowField::FlowField ( const RoomNavGraph & _graph )
+	// Initialize members:
+	: graph(_graph),
+	  build(0),
+	  target(-1),
+	  updateCount(0)
+{
+} // End of method: FlowField::FlowField
+
+
+
+
+
+
+bool FlowField::setTarget ( float x, float y ) {
+	bool rebuilt = (build != graph.getBuildCount());
+
+	if ( rebuilt ) {
+		indexCells();
+		target = -1;
+	}
+
+	int span = graph.findSpan( x, y );
+
+	if ( span < 0 ) {
+		// Keep chasing the last known cell, unless it's gone with the old
+		// graph:
+		if ( rebuilt )
+			steps.clear();
+
+		return rebuilt;
+	}
+
+	int cell = findCell( span, x );
+
+	if ( cell == target && !rebuilt )
+		return false;
+
+	target = cell;
+	compute();
+
+	return true;
+
+} // End of method: FlowField::setTarget
+
+
+
+
+
+
+const FlowField::Step * FlowField::findStep ( float x, float y ) const {
+	if ( target < 0 || build != graph.getBuildCount() )
+		return NULL;
+
+	int span = graph.findSpan( x, y );
+
+	return span >= 0 ? &steps[findCell( span, x )] : NULL;
+
+} // End of method: FlowField::findStep
+
+
+
+
+
+
+bool FlowField::isWorse ( const Open & a, const Open & b ) {
+	return a.time > b.time || (a.time == b.time && a.cell > b.cell);
+
+} // End of method: FlowField::isWorse
+
+
+
+
+
+
+int FlowField::findCell ( int span, float x ) const {
+	const RoomNavGraph::Span & s = graph.getSpan( span );
+	int column = (int) floorf( x / graph.getBlockSize() );
+
+	return graph.getCell( span, std::min( std::max( column, s.firstColumn ), s.lastColumn ) );
+
+} // End of method: FlowField::findCell
+
+
+
+
+
+
+void FlowField::indexCells () {
+	int cellCount = graph.getCellCount();
+	int linkCount = graph.getLinkCount();
+
+	build = graph.getBuildCount();
+
+	cellSpans.resize( cellCount );
+	cellColumns.resize( cellCount );
+
+	for ( int s = 0; s < graph.getSpanCount(); s++ ) {
+		const RoomNavGraph::Span & span = graph.getSpan( s );
+
+		for ( int j = span.firstColumn; j <= span.lastColumn; j++ ) {
+			cellSpans[graph.getCell( s, j )]   = s;
+			cellColumns[graph.getCell( s, j )] = j;
+		}
+	}
+
+	// Where each link starts and lands:
+	std::vector<int> landingCells( linkCount );
+	launchCells.resize( linkCount );
+
+	for ( int l = 0; l < linkCount; l++ ) {
+		const RoomNavGraph::Link & link = graph.getLink( l );
+
+		launchCells[l]  = findCell( link.from, link.launch.x );
+		landingCells[l] = findCell( link.to, link.landing.x );
+	}
+
+	arrivalStart.assign( cellCount + 1, 0 );
+
+	for ( int l = 0; l < linkCount; l++ )
+		arrivalStart[landingCells[l] + 1]++;
+
+	for ( int c = 0; c < cellCount; c++ )
+		arrivalStart[c + 1] += arrivalStart[c];
+
+	arrivals.resize( linkCount );
+
+	std::vector<int> slot( arrivalStart.begin(), arrivalStart.end() - 1 );
+
+	for ( int l = 0; l < linkCount; l++ )
+		arrivals[slot[landingCells[l]]++] = l;
+
+} // End of method: FlowField::indexCells
+
+
+
+
+
+
+void FlowField::compute () {
+	Step unreachable;
+	unreachable.time      = std::numeric_limits<float>::infinity();
+	unreachable.direction = 0;
+	unreachable.link      = -1;
+
+	steps.assign( graph.getCellCount(), unreachable );
+	open.clear();
+
+	float walkTime = graph.getBlockSize() / graph.getTuning().WALK_SPEED;
+
+	steps[target].time = 0;
+
+	Open first = { 0, target };
+	open.push_back( first );
+
+	// Dijkstra from the target, following the moves backwards: Each cell
+	// reached learns the move that leads towards the target.
+	while ( !open.empty() ) {
+		std::pop_heap( open.begin(), open.end(), isWorse );
+		Open current = open.back();
+		open.pop_back();
+
+		int   cell = current.cell;
+		float time = current.time;
+
+		if ( time > steps[cell].time )
+			continue;
+
+		// Walking from the neighbouring columns of the span:
+		for ( int direction = -1; direction <= 1; direction += 2 ) {
+			int from   = cell - direction;
+			int column = cellColumns[cell] - direction;
+			const RoomNavGraph::Span & span = graph.getSpan( cellSpans[cell] );
+
+			if ( column < span.firstColumn || column > span.lastColumn || time + walkTime >= steps[from].time )
+				continue;
+
+			steps[from].time      = time + walkTime;
+			steps[from].direction = direction;
+			steps[from].link      = -1;
+
+			Open next = { time + walkTime, from };
+			open.push_back( next );
+			std::push_heap( open.begin(), open.end(), isWorse );
+		}
+
+		// Dropping or jumping from other spans:
+		for ( int a = arrivalStart[cell]; a < arrivalStart[cell + 1]; a++ ) {
+			int   link     = arrivals[a];
+			int   from     = launchCells[link];
+			float linkTime = time + graph.getLink( link ).time;
+
+			if ( linkTime >= steps[from].time )
+				continue;
+
+			steps[from].time      = linkTime;
+			steps[from].direction = 0;
+			steps[from].link      = link;
+
+			Open next = { linkTime, from };
+			open.push_back( next );
+			std::push_heap( open.begin(), open.end(), isWorse );
+		}
+	}
+
+	updateCount++;
+
+} // End of method: FlowField::compute
@@ -0,0 +1,118 @@
+#ifndef _FlowField_h_
+#define _FlowField_h_
+
+
+#include "RoomNavGraph.h"
+#include "Vector2D.h"
+
+#include <vector>
+
+/**
+* Tells every point of a <tt>RoomNavGraph</tt> the way to a single target
+* (e.g., the player), for crowds of agents chasing it.
+*
+* The field holds, for every cell of the graph (a column of a span), the
+* time it takes to reach the target's cell, and the first move to make:
+* walk to the neighbouring column on the left or right, or take a link
+* (drop or jump) launched from this column. It's computed with Dijkstra's
+* algorithm from the target's cell, following the graph's moves backwards,
+* so it respects what the character can actually do.
+*
+* The field is only recomputed when the target enters another cell, or
+* the graph is rebuilt; between those, and for any number of agents,
+* looking up the way to go is a constant-time read.
+*
+* @see PathPlanner, for agents with targets of their own.
+*/
+class FlowField
+{
+public:
+	/** What to do in a cell. */
+	struct Step
+	{
+		/** Seconds to the target; infinite if it can't be reached. */
+		float time;
+
+		/** -1 or 1 to walk to the neighbouring column, or 0 to take
+		* <tt>link</tt> (or, if there's no link, to stay: the cell is the
+		* target's, or the target can't be reached). */
+		int direction;
+
+		/** The link to take, or -1. */
+		int link;
+	};
+
+	FlowField ( const RoomNavGraph & graph );
+
+	/**
+	* Moves the target to the cell at <tt>(x, y)</tt>, recomputing the
+	* field if the cell has changed, or if the graph has been rebuilt.
+	* Points that are not on any span leave the target where it was.
+	*
+	* @return true if the field was recomputed.
+	*/
+	bool setTarget ( float x, float y );
+
+	/**
+	* @return The target's cell, or -1 if there's no target yet.
+	*/
+	inline int getTargetCell () const {
+		return target;
+	}
+
+	/**
+	* @return What to do in the cell.
+	*/
+	inline const Step & getStep ( int cell ) const {
+		return steps[cell];
+	}
+
+	/**
+	* @return What to do at <tt>(x, y)</tt>, or NULL if the point is not on
+	*         any span, or there's no target yet.
+	*/
+	const Step * findStep ( float x, float y ) const;
+
+	/**
+	* @return The number of times the field has been computed.
+	*/
+	inline unsigned int getUpdateCount () const {
+		return updateCount;
+	}
+
+private:
+	/** An entry of the open list. */
+	struct Open
+	{
+		float time;
+		int   cell;
+	};
+
+	static bool isWorse ( const Open & a, const Open & b );
+
+	const RoomNavGraph & graph;
+
+	/** The graph's build the cell tables below are for. */
+	unsigned int build;
+
+	/** For every cell, its span and column. */
+	std::vector<int> cellSpans, cellColumns;
+
+	/** For every cell, the links landing in it (backwards through the
+	* graph): <tt>arrivals[arrivalStart[c] .. arrivalStart[c + 1] - 1]</tt>. */
+	std::vector<int> arrivalStart, arrivals;
+
+	/** For every link, the cell it's launched from. */
+	std::vector<int> launchCells;
+
+	std::vector<Step> steps;
+	std::vector<Open> open;
+	int               target;
+	unsigned int      updateCount;
+
+	int  findCell      ( int span, float x ) const;
+	void indexCells    ();
+	void compute       ();
+};
+
+#endif
@@ -1,20 +1,76 @@
 #include "Application.h"
+#include "Replay.h"
+#include "ReplayRunner.h"
 
 #include <stdexcept>
 #include <iostream>
+#include <string>
+#include <cstdlib>
 
+// Plays a replay back without a window, as many times as requested, and
+// reports the speed and whether every run matched the recorded checksums
+int playReplay(const std::string& filename, int runs)
+{
+	Replay replay;
+	if (!replay.loadFromFile(filename))
+		throw std::runtime_error("playReplay - Failed to load " + filename);
+
+	bool deterministic = true;
+
+	for (int run = 0; run < runs; ++run)
+	{
+		ReplayRunner runner;
+		ReplayRunner::Result result = runner.run(replay);
+
+		float seconds = result.elapsed.asSeconds();
+		std::cout << "Run " << run + 1 << ": " << result.ticks << " ticks in " << seconds << " s ("
+			<< (seconds > 0.f ? result.ticks / seconds : 0.f) << " ticks/s), "
+			<< result.checksums << " checksums";
+
+		if (result.deterministic)
+			std::cout << ", all matching" << std::endl;
+		else
+			std::cout << ", first mismatch at tick " << result.firstMismatch << std::endl;
+
+		deterministic = deterministic && result.deterministic;
+	}
+
+	return deterministic ? 0 : 1;
+}
+
+// Usage:
+//   wanderlust                                 Play
+//   wanderlust -record <replay>                Play, and record the last game session
+//   wanderlust -play <replay> [-runs <count>]  Play the replay back, headless
 int main(int argc, char** argv)
 {
 	try
 	{
+		std::string mode = (argc >= 3 ? argv[1] : "");
+
+		if (mode == "-play")
+		{
+			int runs = (argc >= 5 && std::string(argv[3]) == "-runs" ? std::atoi(argv[4]) : 1);
+			return playReplay(argv[2], runs);
+		}
+
 		Application app;
+
+		if (mode == "-record")
+			app.recordReplay(argv[2]);
+
 		app.run();
 	}
 	catch (std::exception& e)
 	{
 		std::cout << "\nEXCEPTION: " << e.what() << std::endl;
-		getchar();
+
+		// Don't wait for a key when playing back unattended
+		if (argc < 3 || std::string(argv[1]) != "-play")
+			getchar();
+
+		return 1;
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
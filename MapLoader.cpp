@@ -49,6 +49,9 @@ bool MapLoader::load(const std::string& mapFile, Map& map)
 		currentNode = currentNode.next_sibling();
 	}
 
+	//the collision layer is complete, fuse its edges for the sweeps
+	map.mRoom->buildEdgeMesh();
+
 	return true;
 }
 
@@ -202,7 +205,7 @@ bool MapLoader::mParseLayer(const pugi::xml_node& layerNode, Map& map)
 		{
 			int c = atoi(mTileInfo[gid].properties["c"].c_str());
 
-			map.mRoom->obstacleLayer.cell(y,x) = static_cast<RoomBlock::Type>(c);
+			map.mRoom->obstacleLayer.set(y, x, static_cast<RoomBlock::Type>(c));
 		}
 
 		tileNode = tileNode.next_sibling("tile");
@@ -0,0 +1,42 @@
+#ifndef _NodePool_h_
+#define _NodePool_h_
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+// Recycles the storage of the scene nodes of type Node, which are created and
+// destroyed in bulk (projectiles, pickups, particle emitters...). The class
+// routes its allocations here, so that new and SceneNode::Ptr work as usual:
+//
+//	static void*	operator new(std::size_t size)				{ return NodePool<Node>::allocate(size); }
+//	static void		operator delete(void* block, std::size_t size)	{ NodePool<Node>::deallocate(block, size); }
+//
+// Destroying a node returns its storage to the pool; creating one takes the
+// storage back, and the constructor resets the state. Blocks of other sizes
+// (derived classes) go to the heap. Each thread has its own pool.
+template <typename Node>
+class NodePool
+{
+public:
+	static void*		allocate(std::size_t size);
+	static void			deallocate(void* block, std::size_t size);
+
+	// Allocates blocks ahead, e.g. for the peak number of nodes alive
+	static void			reserve(std::size_t count);
+
+	static std::size_t	getFreeCount();
+
+private:
+	struct FreeList
+	{
+						~FreeList();
+
+		std::vector<void*>	blocks;
+	};
+
+	static FreeList&	getFreeList();
+};
+
+#include "NodePool.inl"
+#endif
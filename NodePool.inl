@@ -0,0 +1,58 @@
+
+template <typename Node>
+void* NodePool<Node>::allocate(std::size_t size)
+{
+	FreeList& freeList = getFreeList();
+
+	if (size != sizeof(Node) || freeList.blocks.empty())
+		return ::operator new(size);
+
+	void* block = freeList.blocks.back();
+	freeList.blocks.pop_back();
+	return block;
+}
+
+template <typename Node>
+void NodePool<Node>::deallocate(void* block, std::size_t size)
+{
+	if (!block)
+		return;
+
+	if (size != sizeof(Node))
+	{
+		::operator delete(block);
+		return;
+	}
+
+	getFreeList().blocks.push_back(block);
+}
+
+template <typename Node>
+void NodePool<Node>::reserve(std::size_t count)
+{
+	FreeList& freeList = getFreeList();
+	freeList.blocks.reserve(count);
+
+	while (freeList.blocks.size() < count)
+		freeList.blocks.push_back(::operator new(sizeof(Node)));
+}
+
+template <typename Node>
+std::size_t NodePool<Node>::getFreeCount()
+{
+	return getFreeList().blocks.size();
+}
+
+template <typename Node>
+NodePool<Node>::FreeList::~FreeList()
+{
+	for (std::size_t i = 0; i < blocks.size(); ++i)
+		::operator delete(blocks[i]);
+}
+
+template <typename Node>
+typename NodePool<Node>::FreeList& NodePool<Node>::getFreeList()
+{
+	static thread_local FreeList freeList;
+	return freeList;
+}
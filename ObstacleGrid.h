@@ -0,0 +1,289 @@
+#ifndef _ObstacleGrid_h_
+#define _ObstacleGrid_h_
+
+#include <algorithm>
+#include <stdexcept>
+#include <stdint.h>
+#include <string.h>
+
+#include "RoomBlock.h"
+
+
+/**
+* Compact storage for a Room's obstacle layer.
+*
+* Each cell takes a single byte, and cells are arranged in square tiles of
+* 8x8 cells, so that each tile fills exactly one 64-byte cache line. This
+* way, probes moving vertically stay on the same cache line as long as
+* probes moving horizontally.
+*
+* The grid is surrounded by a border of <tt>BLK_EMPTY</tt> cells, one cell
+* wide, which can be read (but not written) by the unchecked accessor
+* <tt>at()</tt>. Any index can be moved onto the border with
+* <tt>clampRow()</tt> and <tt>clampColumn()</tt>, so the collision methods
+* don't need to branch on the room's limits.
+*
+* The grid also keeps a two-level occupancy bitmap: one bit per cell, and
+* one bit per 8x8 group of cells, set if any cell in the group isn't
+* <tt>BLK_EMPTY</tt>. <tt>isEmpty()</tt> uses it to tell whether a whole
+* region is free with a handful of word-wide tests, before any block is
+* examined.
+*
+* Every change to the grid increases its version number, so that anything
+* computed from the grid's contents can tell when it's out of date.
+*
+* @see Room
+*/
+class ObstacleGrid
+{
+public:
+	/**
+	* Grid dimensions, not counting the border; initialized in the
+	* constructor.
+	*/
+	const int rows, columns;
+
+
+	/**
+	* The constructor will allocate the tiles, with every cell (including
+	* the border) set to <tt>BLK_EMPTY</tt>. The grid's dimensions cannot
+	* be changed after creation.
+	*/
+	ObstacleGrid ( int _rows, int _columns ) : rows(_rows), columns(_columns) {
+		version = 0;
+
+		tileColumns = (columns + 2 + TILE_MASK) >> TILE_SHIFT;
+		size        = ((rows + 2 + TILE_MASK) >> TILE_SHIFT) * tileColumns * TILE_CELLS;
+
+		data = new signed char[size];
+		memset( data, RoomBlock::BLK_EMPTY, size );
+
+		// Nothing is occupied yet:
+		cellWords  = (columns + WORD_MASK) >> WORD_SHIFT;
+		groupWords = (((columns + TILE_MASK) >> TILE_SHIFT) + WORD_MASK) >> WORD_SHIFT;
+
+		cellBits  = new uint64_t[rows * cellWords];
+		groupBits = new uint64_t[((rows + TILE_MASK) >> TILE_SHIFT) * groupWords];
+		memset( cellBits,  0, rows * cellWords * sizeof(uint64_t) );
+		memset( groupBits, 0, ((rows + TILE_MASK) >> TILE_SHIFT) * groupWords * sizeof(uint64_t) );
+	}
+
+	/**
+	* Copy constructor: Copies data from the other grid.
+	*/
+	ObstacleGrid ( const ObstacleGrid & orig ) : rows(orig.rows), columns(orig.columns) {
+		version = orig.version;
+
+		tileColumns = orig.tileColumns;
+		size        = orig.size;
+
+		data = new signed char[size];
+		memcpy( data, orig.data, size );
+
+		cellWords  = orig.cellWords;
+		groupWords = orig.groupWords;
+
+		cellBits  = new uint64_t[rows * cellWords];
+		groupBits = new uint64_t[((rows + TILE_MASK) >> TILE_SHIFT) * groupWords];
+		memcpy( cellBits,  orig.cellBits,  rows * cellWords * sizeof(uint64_t) );
+		memcpy( groupBits, orig.groupBits, ((rows + TILE_MASK) >> TILE_SHIFT) * groupWords * sizeof(uint64_t) );
+	}
+
+	/**
+	* Cell access method.
+	* @return The block type stored at the specified cell.
+	* @throw std::out_of_range if either the row or column indices exceed
+	*        the grid's dimensions.
+	*/
+	inline RoomBlock::Type cell ( int row, int column ) const {
+		// Test index validity:
+		if ( row < 0 || row >= rows || column < 0 || column >= columns )
+			throw std::out_of_range("ObstacleGrid index out of range");
+
+		return at( row, column );
+	}
+
+	/**
+	* Stores a block type at the specified cell.
+	* @throw std::out_of_range if either the row or column indices exceed
+	*        the grid's dimensions.
+	*/
+	inline void set ( int row, int column, RoomBlock::Type type ) {
+		// Test index validity:
+		if ( row < 0 || row >= rows || column < 0 || column >= columns )
+			throw std::out_of_range("ObstacleGrid index out of range");
+
+		data[index( row, column )] = (signed char) type;
+		version++;
+
+		// Update the cell's bit:
+		uint64_t bit = (uint64_t) 1 << (column & WORD_MASK);
+
+		if ( type == RoomBlock::BLK_EMPTY )
+			cellBits[row * cellWords + (column >> WORD_SHIFT)] &= ~bit;
+		else
+			cellBits[row * cellWords + (column >> WORD_SHIFT)] |= bit;
+
+		// Update the bit of the cell's group, by looking at all of its
+		// cells:
+		int groupRow    = row    >> TILE_SHIFT;
+		int groupColumn = column >> TILE_SHIFT;
+
+		int lastRow    = std::min( (groupRow    << TILE_SHIFT) + TILE_MASK, rows    - 1 );
+		int lastColumn = std::min( (groupColumn << TILE_SHIFT) + TILE_MASK, columns - 1 );
+
+		bool occupied = anyBit( cellBits, cellWords,
+		                        groupRow    << TILE_SHIFT, lastRow,
+		                        groupColumn << TILE_SHIFT, lastColumn );
+
+		bit = (uint64_t) 1 << (groupColumn & WORD_MASK);
+
+		if ( occupied )
+			groupBits[groupRow * groupWords + (groupColumn >> WORD_SHIFT)] |= bit;
+		else
+			groupBits[groupRow * groupWords + (groupColumn >> WORD_SHIFT)] &= ~bit;
+	}
+
+	/**
+	* @return A number that changes every time a cell is modified.
+	*/
+	inline unsigned int getVersion () const {
+		return version;
+	}
+
+	/**
+	* Unchecked cell access, for the collision methods: Valid rows go from
+	* -1 to <tt>rows</tt>, and valid columns from -1 to <tt>columns</tt>;
+	* i.e., the border may be read as well.
+	*/
+	inline RoomBlock::Type at ( int row, int column ) const {
+		return (RoomBlock::Type) data[index( row, column )];
+	}
+
+	/**
+	* @return The row index, moved onto the border if it lies outside of
+	*         the grid.
+	*/
+	inline int clampRow ( int row ) const {
+		return (row < -1 ? -1 : (row > rows ? rows : row));
+	}
+
+	/**
+	* @return The column index, moved onto the border if it lies outside of
+	*         the grid.
+	*/
+	inline int clampColumn ( int column ) const {
+		return (column < -1 ? -1 : (column > columns ? columns : column));
+	}
+
+
+	/**
+	* Tells whether all cells from (row1, column1) to (row2, column2),
+	* inclusive, are <tt>BLK_EMPTY</tt>. Cells outside of the grid are
+	* considered empty.
+	*/
+	inline bool isEmpty ( int row1, int column1, int row2, int column2 ) const {
+		// Clip the region to the grid:
+		row1    = std::max( row1,    0 );
+		column1 = std::max( column1, 0 );
+		row2    = std::min( row2,    rows    - 1 );
+		column2 = std::min( column2, columns - 1 );
+
+		if ( row1 > row2 || column1 > column2 )
+			return true;
+
+		// Coarse test, on the groups:
+		if ( !anyBit( groupBits, groupWords,
+		              row1    >> TILE_SHIFT, row2    >> TILE_SHIFT,
+		              column1 >> TILE_SHIFT, column2 >> TILE_SHIFT ) )
+			return true;
+
+		// Fine test, on the cells:
+		return !anyBit( cellBits, cellWords, row1, row2, column1, column2 );
+	}
+
+
+	/**
+	* Destructor: Deallocates the tiles and bitmaps.
+	*/
+	~ObstacleGrid () {
+		delete[] data;
+		delete[] cellBits;
+		delete[] groupBits;
+	}
+
+private:
+	/** Tiles are 8x8 cells, one byte each. */
+	static const int TILE_SHIFT = 3;
+	static const int TILE_MASK  = (1 << TILE_SHIFT) - 1;
+	static const int TILE_CELLS = 1 << (2 * TILE_SHIFT);
+
+	/** Number of tiles in each row of tiles, border included. */
+	int tileColumns;
+
+	/** Total number of cells allocated. */
+	int size;
+
+	signed char * data;
+
+	/** Increased on every change. */
+	unsigned int version;
+
+	/** Occupancy bits are packed into 64-bit words. */
+	static const int WORD_SHIFT = 6;
+	static const int WORD_MASK  = (1 << WORD_SHIFT) - 1;
+
+	/** Number of words in each row of the cell and group bitmaps. */
+	int cellWords, groupWords;
+
+	/** One bit per cell, and one bit per 8x8 group of cells. */
+	uint64_t * cellBits;
+	uint64_t * groupBits;
+
+	/**
+	* Finds a cell inside of the tiles: First the tile, then the row inside
+	* of the tile, then the column.
+	*/
+	inline int index ( int row, int column ) const {
+		// Skip the border:
+		row++;
+		column++;
+
+		return (((row >> TILE_SHIFT) * tileColumns + (column >> TILE_SHIFT)) << (2 * TILE_SHIFT)) |
+		       ((row & TILE_MASK) << TILE_SHIFT) |
+		        (column & TILE_MASK);
+	}
+
+	/**
+	* Tests whether any bit is set in the rectangle from (row1, column1) to
+	* (row2, column2), inclusive, of a bitmap with <tt>words</tt> words per
+	* row.
+	*/
+	static inline bool anyBit ( const uint64_t * bits, int words, int row1, int row2, int column1, int column2 ) {
+		int firstWord = column1 >> WORD_SHIFT;
+		int lastWord  = column2 >> WORD_SHIFT;
+
+		uint64_t firstMask = ~(uint64_t) 0 << (column1 & WORD_MASK);
+		uint64_t lastMask  = ~(uint64_t) 0 >> (WORD_MASK - (column2 & WORD_MASK));
+
+		for ( int row = row1; row <= row2; row++ ) {
+			const uint64_t * rowBits = bits + row * words;
+
+			for ( int w = firstWord; w <= lastWord; w++ ) {
+				uint64_t mask = ~(uint64_t) 0;
+				if ( w == firstWord ) mask &= firstMask;
+				if ( w == lastWord  ) mask &= lastMask;
+
+				if ( rowBits[w] & mask )
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	// Not assignable, since the dimensions can't change:
+	ObstacleGrid & operator = ( const ObstacleGrid & );
+};
+
+#endif
@@ -14,7 +14,7 @@ namespace
 ParticleNode::ParticleNode(Particle::Type type, const TextureManager& textures)
 : SceneNode()
 , mParticles()
-, mTexture(textures.get(Textures::Particle))
+, mTexture(textures.find(Textures::Particle))
 , mType(type)
 , mVertexArray(sf::Quads)
 , mNeedsVertexUpdate(true)
@@ -56,6 +56,9 @@ void ParticleNode::updateCurrent(sf::Time dt, CommandQueue&)
 
 void ParticleNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
 {
+	if (!mTexture)
+		return;
+
 	if (mNeedsVertexUpdate)
 	{
 		computeVertices();
@@ -63,7 +66,7 @@ void ParticleNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states
 	}
 
 	// Apply particle texture
-	states.texture = &mTexture;
+	states.texture = mTexture;
 	
 	// Draw vertices
 	target.draw(mVertexArray, states);
@@ -81,7 +84,7 @@ void ParticleNode::addVertex(float worldX, float worldY, float texCoordX, float
 
 void ParticleNode::computeVertices() const
 {
-	sf::Vector2f size(mTexture.getSize());
+	sf::Vector2f size(mTexture->getSize());
 	sf::Vector2f half = size / 2.f;
 
 	// Refill vertex array
@@ -28,7 +28,7 @@ class ParticleNode : public SceneNode
 
 	private:
 		std::deque<Particle>	mParticles;
-		const sf::Texture&		mTexture;
+		const sf::Texture*		mTexture;		// nullptr in headless worlds
 		Particle::Type			mType;
 
 		mutable sf::VertexArray	mVertexArray;
@@ -0,0 +1,271 @@
+#include "PathPlanner.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Auxiliary functions:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Scratch space for searches that aren't given one; each thread gets its
+// own, grown to the largest graph it has searched:
+static PathPlanner::Scratch & threadScratch () {
+	static thread_local PathPlanner::Scratch scratch;
+
+	return scratch;
+
+} // End of function: threadScratch
+
+
+
+
+
+
+// Orders the open list as a min-heap:
+static inline bool isWorse ( const PathPlanner::Scratch::Open & a, const PathPlanner::Scratch::Open & b ) {
+	return a.estimate > b.estimate || (a.estimate == b.estimate && a.span > b.span);
+
+} // End of function: isWorse
+
+
+
+
+
+
+static inline sf::Vector2f toPoint ( const Vector2D & v ) {
+	return sf::Vector2f( v.x, v.y );
+
+} // End of function: toPoint
+
+
+
+
+
+
+// The middle of the span, from where routes are searched:
+static inline float middleX ( const RoomNavGraph & graph, int span ) {
+	const RoomNavGraph::Span & s = graph.getSpan( span );
+
+	return (s.firstColumn + s.lastColumn + 1) * graph.getBlockSize() / 2.0f;
+
+} // End of function: middleX
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// PathPlanner:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+PathPlanner::PathPlanner ( const RoomNavGraph & graph )
+	// Initialize members:
+	: graph(graph),
+	  cacheBuild(graph.getBuildCount()),
+	  searchCount(0)
+{
+} // End of constructor: PathPlanner::PathPlanner
+
+
+
+
+
+
+PlanAction::Ptr PathPlanner::findPath ( const Vector2D & start, const Vector2D & goal, Scratch * scratch ) {
+	int startSpan = graph.findSpan( start.x, start.y );
+	int goalSpan  = graph.findSpan( goal.x, goal.y );
+
+	if ( startSpan < 0 || goalSpan < 0 )
+		return PlanAction::Ptr();
+
+	std::vector<int> route;
+
+	if ( !findRoute( startSpan, goalSpan, route, scratch ) )
+		return PlanAction::Ptr();
+
+	// Build the chain backwards, from the goal:
+	PlanAction * plan = new PlanAction( toPoint( graph.getStandingPoint( goalSpan, goal.x ) ), PlanAction::WALK );
+
+	for ( size_t i = route.size(); i-- > 0; ) {
+		const RoomNavGraph::Link & link = graph.getLink( route[i] );
+
+		plan = new PlanAction( toPoint( link.landing ), link.action, plan );
+		plan = new PlanAction( toPoint( link.launch ), PlanAction::WALK, plan );
+	}
+
+	return PlanAction::Ptr( plan );
+
+} // End of method: PathPlanner::findPath
+
+
+
+
+
+
+bool PathPlanner::findRoute ( int startSpan, int goalSpan, std::vector<int> & route, Scratch * scratch ) {
+	route.clear();
+
+	if ( startSpan == goalSpan )
+		return true;
+
+	unsigned long long key = ((unsigned long long) startSpan << 32) | (unsigned int) goalSpan;
+
+	{
+		std::lock_guard<std::mutex> lock( cacheMutex );
+
+		if ( cacheBuild != graph.getBuildCount() ) {
+			cache.clear();
+			cacheBuild = graph.getBuildCount();
+		}
+
+		std::unordered_map<unsigned long long, Route>::const_iterator cached = cache.find( key );
+
+		if ( cached != cache.end() ) {
+			route = cached->second.links;
+			return cached->second.found;
+		}
+	}
+
+	// Search without holding the lock; if another thread searches the same
+	// route meanwhile, both find the same one.
+	if ( scratch == NULL )
+		scratch = &threadScratch();
+
+	Route result;
+	result.found = search( startSpan, goalSpan, result.links, *scratch );
+	route = result.links;
+
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	searchCount++;
+	cache[key] = result;
+
+	return result.found;
+
+} // End of method: PathPlanner::findRoute
+
+
+
+
+
+
+void PathPlanner::clearCache () {
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	cache.clear();
+
+} // End of method: PathPlanner::clearCache
+
+
+
+
+
+
+size_t PathPlanner::getCacheSize () const {
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	return cache.size();
+
+} // End of method: PathPlanner::getCacheSize
+
+
+
+
+
+
+unsigned int PathPlanner::getSearchCount () const {
+	std::lock_guard<std::mutex> lock( cacheMutex );
+
+	return searchCount;
+
+} // End of method: PathPlanner::getSearchCount
+
+
+
+
+
+
+bool PathPlanner::search ( int startSpan, int goalSpan, std::vector<int> & route, Scratch & scratch ) const {
+	int spanCount = graph.getSpanCount();
+
+	if ( (int) scratch.visited.size() < spanCount ) {
+		scratch.cost.resize( spanCount );
+		scratch.entryX.resize( spanCount );
+		scratch.via.resize( spanCount );
+		scratch.visited.resize( spanCount, 0 );
+	}
+
+	// Spans not touched by this search have a stale search number, so the
+	// tables need no clearing:
+	if ( ++scratch.search == 0 ) {
+		std::fill( scratch.visited.begin(), scratch.visited.end(), 0 );
+		scratch.search = 1;
+	}
+
+	const PlatformerMotion::Tuning & tuning = graph.getTuning();
+
+	// Costs are in seconds: walking along spans, plus the links' flight
+	// times. The heuristic is the horizontal distance at the top speed.
+	float walkSpeed = tuning.WALK_SPEED;
+	float topSpeed  = std::max( tuning.WALK_SPEED, tuning.SWIM_SPEED );
+	float goalX     = middleX( graph, goalSpan );
+
+	std::vector<Scratch::Open> & open = scratch.open;
+	open.clear();
+
+	scratch.visited[startSpan] = scratch.search;
+	scratch.cost[startSpan]    = 0;
+	scratch.entryX[startSpan]  = middleX( graph, startSpan );
+	scratch.via[startSpan]     = -1;
+
+	Scratch::Open first = { std::abs( goalX - scratch.entryX[startSpan] ) / topSpeed, startSpan };
+	open.push_back( first );
+
+	while ( !open.empty() ) {
+		std::pop_heap( open.begin(), open.end(), isWorse );
+		Scratch::Open current = open.back();
+		open.pop_back();
+
+		int   span = current.span;
+		float cost = scratch.cost[span];
+
+		// Skip outdated entries, which were improved on after being added:
+		if ( current.estimate > cost + std::abs( goalX - scratch.entryX[span] ) / topSpeed + EPSILON )
+			continue;
+
+		if ( span == goalSpan ) {
+			for ( int s = goalSpan; scratch.via[s] >= 0; s = graph.getLink( scratch.via[s] ).from )
+				route.push_back( scratch.via[s] );
+
+			std::reverse( route.begin(), route.end() );
+			return true;
+		}
+
+		const RoomNavGraph::Span & s = graph.getSpan( span );
+
+		for ( int l = s.firstLink; l < s.firstLink + s.linkCount; l++ ) {
+			const RoomNavGraph::Link & link = graph.getLink( l );
+
+			float linkCost = cost + std::abs( link.launch.x - scratch.entryX[span] ) / walkSpeed + link.time;
+
+			if ( scratch.visited[link.to] == scratch.search && scratch.cost[link.to] <= linkCost )
+				continue;
+
+			scratch.visited[link.to] = scratch.search;
+			scratch.cost[link.to]    = linkCost;
+			scratch.entryX[link.to]  = link.landing.x;
+			scratch.via[link.to]     = l;
+
+			Scratch::Open next = { linkCost + std::abs( goalX - link.landing.x ) / topSpeed, link.to };
+			open.push_back( next );
+			std::push_heap( open.begin(), open.end(), isWorse );
+		}
+	}
+
+	return false;
+
+} // End of method: PathPlanner::search
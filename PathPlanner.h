@@ -0,0 +1,113 @@
+#ifndef _PathPlanner_h_
+#define _PathPlanner_h_
+
+
+#include "RoomNavGraph.h"
+#include "PlanAction.h"
+#include "Vector2D.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Plans paths through a <tt>RoomNavGraph</tt> with A*, as chains of
+* <tt>PlanAction</tt>s.
+*
+* Routes between spans (the links to take) are searched from the middle of
+* the start span to the middle of the goal span, so that they only depend
+* on the two spans: Each route is searched once, and kept in a cache for
+* all later queries between the same spans, by any agent. The cache is
+* dropped whenever the graph is rebuilt.
+*
+* <tt>findPath()</tt> can be called from several threads at once, each
+* with its own <tt>Scratch</tt>; the graph must not be rebuilt meanwhile.
+*/
+class PathPlanner
+{
+public:
+	/**
+	* Scratch space for the search. Queries that are not given one use a
+	* thread-local instance.
+	*/
+	struct Scratch
+	{
+		/** An entry of the open list. */
+		struct Open
+		{
+			float estimate;
+			int   span;
+		};
+
+		/** Per span: cost so far, entry point, the link it was reached
+		* through, and the search it was last touched by. */
+		std::vector<float>        cost;
+		std::vector<float>        entryX;
+		std::vector<int>          via;
+		std::vector<unsigned int> visited;
+		std::vector<Open>         open;
+		unsigned int              search;
+
+		Scratch () : search(0) {}
+	};
+
+	PathPlanner ( const RoomNavGraph & graph );
+
+	/**
+	* Plans a path for a character standing at <tt>start</tt> to
+	* <tt>goal</tt>: Walk to the launch point of each link of the route,
+	* take the link (a WALK off a ledge, or a JUMP) to its landing point,
+	* and finally walk to the point of the goal's span nearest to
+	* <tt>goal</tt>.
+	*
+	* @return The plan, or NULL if either point is not on a span, or there
+	*         is no way from one to the other.
+	*/
+	PlanAction::Ptr findPath ( const Vector2D & start, const Vector2D & goal, Scratch * scratch = NULL );
+
+	/**
+	* Finds the links that lead from one span to another.
+	*
+	* @param route Receives the links' indices, in order; empty if the
+	*              spans are the same.
+	* @return false if there is no route.
+	*/
+	bool findRoute ( int startSpan, int goalSpan, std::vector<int> & route, Scratch * scratch = NULL );
+
+	/**
+	* Forgets all cached routes.
+	*/
+	void clearCache ();
+
+	/**
+	* @return The number of cached routes (including the failed searches).
+	*/
+	size_t getCacheSize () const;
+
+	/**
+	* @return The number of searches run, as opposed to routes served from
+	*         the cache.
+	*/
+	unsigned int getSearchCount () const;
+
+private:
+	/** A cached search result. */
+	struct Route
+	{
+		bool             found;
+		std::vector<int> links;
+	};
+
+	const RoomNavGraph & graph;
+
+	/** Routes by (start span, goal span), for graph build number
+	* <tt>cacheBuild</tt>. */
+	std::unordered_map<unsigned long long, Route> cache;
+	unsigned int                                  cacheBuild;
+	unsigned int                                  searchCount;
+	mutable std::mutex                            cacheMutex;
+
+	bool search ( int startSpan, int goalSpan, std::vector<int> & route, Scratch & scratch ) const;
+};
+
+#endif
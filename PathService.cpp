@@ -0,0 +1,297 @@
+#include "PathService.h"
+
+#include <algorithm>
+#include <chrono>
+
+
+PathService::PathService ( PathPlanner & _planner, int threadCount )
+	// Initialize members:
+	: planner(_planner),
+	  queuedCount(0),
+	  nextHandle(1),
+	  nextOrder(0),
+	  searching(0),
+	  quit(false)
+{
+	if ( threadCount < 0 )
+		threadCount = std::max( 1, (int) std::thread::hardware_concurrency() ) - 1;
+
+	for ( int k = 0; k < threadCount; k++ )
+		workers.push_back( std::thread( &PathService::workerLoop, this ) );
+
+} // End of method: PathService::PathService
+
+
+
+
+
+
+PathService::~PathService () {
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		quit = true;
+	}
+	wake.notify_all();
+
+	for ( size_t k = 0; k < workers.size(); k++ )
+		workers[k].join();
+
+} // End of method: PathService::~PathService
+
+
+
+
+
+
+PathService::Handle PathService::request ( const Vector2D & start, const Vector2D & goal, int priority,
+                                           const Callback & callback ) {
+	std::unique_lock<std::mutex> lock( mutex );
+
+	Handle handle = nextHandle++;
+
+	if ( nextHandle == 0 )
+		nextHandle = 1;
+
+	Job & job = jobs[handle];
+	job.start    = start;
+	job.goal     = goal;
+	job.callback = callback;
+	job.queued   = true;
+	job.finished = false;
+
+	Queued queued = { priority, nextOrder++, handle };
+	queue.push_back( queued );
+	std::push_heap( queue.begin(), queue.end(), isBehind );
+	queuedCount++;
+
+	lock.unlock();
+	wake.notify_one();
+
+	return handle;
+
+} // End of method: PathService::request
+
+
+
+
+
+
+void PathService::cancel ( Handle handle ) {
+	std::lock_guard<std::mutex> lock( mutex );
+
+	std::unordered_map<Handle, Job>::iterator job = jobs.find( handle );
+
+	if ( job == jobs.end() )
+		return;
+
+	// Its queue entry is skipped when it comes up, but no longer counts as
+	// pending:
+	if ( job->second.queued )
+		queuedCount--;
+
+	jobs.erase( job );
+
+} // End of method: PathService::cancel
+
+
+
+
+
+
+PathService::Status PathService::poll ( Handle handle, PlanAction::Ptr & plan ) {
+	std::lock_guard<std::mutex> lock( mutex );
+
+	std::unordered_map<Handle, Job>::iterator job = jobs.find( handle );
+
+	if ( job == jobs.end() || job->second.callback )
+		return UNKNOWN;
+
+	if ( !job->second.finished )
+		return PENDING;
+
+	plan = std::move( job->second.plan );
+	jobs.erase( job );
+
+	return plan ? DONE : FAILED;
+
+} // End of method: PathService::poll
+
+
+
+
+
+
+void PathService::update ( float budget ) {
+	// Time-slice the searches, if nobody else runs them:
+	if ( workers.empty() ) {
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		Handle   handle;
+		Vector2D from, to;
+
+		while ( takeQueued( handle, from, to ) ) {
+			PlanAction::Ptr plan = planner.findPath( from, to, &scratch );
+			complete( handle, plan );
+
+			if ( std::chrono::duration<float>( std::chrono::steady_clock::now() - start ).count() >= budget )
+				break;
+		}
+	}
+
+	// Hand the plans over; the callbacks may make new requests, so they're
+	// called without holding the lock.
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		if ( finished.empty() )
+			return;
+
+		for ( size_t k = 0; k < finished.size(); k++ ) {
+			std::unordered_map<Handle, Job>::iterator job = jobs.find( finished[k] );
+
+			if ( job == jobs.end() )
+				continue;
+
+			Handover handover = { job->first, std::move( job->second.callback ), std::move( job->second.plan ) };
+			handovers.push_back( std::move( handover ) );
+			jobs.erase( job );
+		}
+
+		finished.clear();
+	}
+
+	for ( size_t k = 0; k < handovers.size(); k++ )
+		handovers[k].callback( handovers[k].handle, handovers[k].plan );
+
+	handovers.clear();
+
+} // End of method: PathService::update
+
+
+
+
+
+
+void PathService::clear () {
+	std::unique_lock<std::mutex> lock( mutex );
+
+	jobs.clear();
+	queue.clear();
+	finished.clear();
+	queuedCount = 0;
+
+	idle.wait( lock, [this] () { return searching == 0; } );
+
+} // End of method: PathService::clear
+
+
+
+
+
+
+size_t PathService::getPendingCount () const {
+	std::lock_guard<std::mutex> lock( mutex );
+
+	// The queue may still hold entries of cancelled requests:
+	return queuedCount + searching;
+
+} // End of method: PathService::getPendingCount
+
+
+
+
+
+
+bool PathService::isBehind ( const Queued & a, const Queued & b ) {
+	// Higher priorities first, then first come, first served:
+	if ( a.priority != b.priority )
+		return a.priority < b.priority;
+
+	return a.order > b.order;
+
+} // End of method: PathService::isBehind
+
+
+
+
+
+
+bool PathService::takeQueued ( Handle & handle, Vector2D & start, Vector2D & goal ) {
+	std::lock_guard<std::mutex> lock( mutex );
+
+	while ( !queue.empty() ) {
+		std::pop_heap( queue.begin(), queue.end(), isBehind );
+		handle = queue.back().handle;
+		queue.pop_back();
+
+		// Skip the cancelled requests:
+		std::unordered_map<Handle, Job>::iterator job = jobs.find( handle );
+
+		if ( job != jobs.end() ) {
+			start = job->second.start;
+			goal  = job->second.goal;
+			job->second.queued = false;
+			queuedCount--;
+			searching++;
+
+			return true;
+		}
+	}
+
+	return false;
+
+} // End of method: PathService::takeQueued
+
+
+
+
+
+
+void PathService::complete ( Handle handle, PlanAction::Ptr & plan ) {
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+
+		std::unordered_map<Handle, Job>::iterator job = jobs.find( handle );
+
+		if ( job != jobs.end() ) {
+			job->second.finished = true;
+			job->second.plan     = std::move( plan );
+
+			if ( job->second.callback )
+				finished.push_back( handle );
+		}
+
+		searching--;
+	}
+	idle.notify_all();
+
+} // End of method: PathService::complete
+
+
+
+
+
+
+void PathService::workerLoop () {
+	PathPlanner::Scratch workerScratch;
+
+	for ( ;; ) {
+		Handle   handle;
+		Vector2D start, goal;
+
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+
+			wake.wait( lock, [this] () { return quit || !queue.empty(); } );
+
+			if ( quit )
+				return;
+		}
+
+		if ( !takeQueued( handle, start, goal ) )
+			continue;
+
+		PlanAction::Ptr plan = planner.findPath( start, goal, &workerScratch );
+		complete( handle, plan );
+	}
+
+} // End of method: PathService::workerLoop
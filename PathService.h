@@ -0,0 +1,177 @@
+#ifndef _PathService_h_
+#define _PathService_h_
+
+
+#include "PathPlanner.h"
+#include "PlanAction.h"
+#include "Vector2D.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+* Plans paths for many agents without stalling the main loop.
+*
+* Agents queue path requests, each with a priority (e.g., higher for
+* agents on screen), and get the plans back later: either through a
+* callback, or by polling the request's handle. Requests are served
+* highest priority first, and in the order they were made among equal
+* priorities.
+*
+* The searches run on worker threads. With no workers (e.g., on a single
+* core), they're time-sliced on the main thread instead: Each
+* <tt>update()</tt> runs queued searches until its CPU budget is spent.
+* The budget is a soft limit: a search isn't interrupted, so a frame
+* overruns it by up to one search.
+*
+* Callbacks are always called from <tt>update()</tt>, on the thread
+* calling it, so they can touch the scene like any other game code.
+*
+* @see PathPlanner
+*/
+class PathService
+{
+public:
+	/** Identifies a request; 0 is never a valid handle. */
+	typedef unsigned int Handle;
+
+	/** Receives a request's plan, which is NULL if there's no path. */
+	typedef std::function<void ( Handle handle, PlanAction::Ptr & plan )> Callback;
+
+	/** The state of a request, as returned by <tt>poll()</tt>. */
+	enum Status
+	{
+		/** Queued, or being searched. */
+		PENDING,
+
+		/** The plan has been handed over. */
+		DONE,
+
+		/** There's no path; the handle is forgotten. */
+		FAILED,
+
+		/** The handle was never issued, has been cancelled, or has already
+		* been handed over. */
+		UNKNOWN
+	};
+
+	/**
+	* Creates a service for the planner's graph.
+	*
+	* @param threadCount Number of worker threads; -1 means one per
+	*                    hardware thread, but the main one. With 0, all
+	*                    searches run in <tt>update()</tt>.
+	*/
+	PathService ( PathPlanner & planner, int threadCount = -1 );
+
+	~PathService ();
+
+	/**
+	* Queues a request for a path from <tt>start</tt> to <tt>goal</tt>.
+	*
+	* @param callback Called with the plan from <tt>update()</tt>; without
+	*                 one, the plan is kept until <tt>poll()</tt> is called.
+	*/
+	Handle request ( const Vector2D & start, const Vector2D & goal, int priority = 0,
+	                 const Callback & callback = Callback() );
+
+	/**
+	* Forgets a request; its callback won't be called. A search already
+	* running is completed, but its plan is dropped.
+	*/
+	void cancel ( Handle handle );
+
+	/**
+	* Checks on a request made without a callback. Once its plan is
+	* ready, it's handed over to <tt>plan</tt>, and the handle is
+	* forgotten.
+	*/
+	Status poll ( Handle handle, PlanAction::Ptr & plan );
+
+	/**
+	* To be called once per frame: With no worker threads, runs queued
+	* searches until <tt>budget</tt> seconds have passed (at least one, if
+	* any are queued). The budget is only checked between searches, so the
+	* last one may overrun it. Then calls the callbacks of the requests
+	* completed since the last call; they mustn't call <tt>update()</tt>.
+	*/
+	void update ( float budget );
+
+	/**
+	* Cancels all requests, and waits for the searches in progress. Must be
+	* called before the graph is rebuilt.
+	*/
+	void clear ();
+
+	/**
+	* @return The number of requests queued or being searched.
+	*/
+	size_t getPendingCount () const;
+
+	/**
+	* @return The number of worker threads.
+	*/
+	inline int getThreadCount () const {
+		return (int) workers.size();
+	}
+
+private:
+	/** A request, from the moment it's made until it's handed over. */
+	struct Job
+	{
+		Vector2D        start, goal;
+		Callback        callback;
+		bool            queued;
+		bool            finished;
+		PlanAction::Ptr plan;
+	};
+
+	/** A completed request, while its callback is called. */
+	struct Handover
+	{
+		Handle          handle;
+		Callback        callback;
+		PlanAction::Ptr plan;
+	};
+
+	/** An entry of the queue. */
+	struct Queued
+	{
+		int          priority;
+		unsigned int order;
+		Handle       handle;
+	};
+
+	static bool isBehind ( const Queued & a, const Queued & b );
+
+	PathPlanner & planner;
+
+	std::unordered_map<Handle, Job> jobs;
+	std::vector<Queued>             queue;
+	std::vector<Handle>             finished;
+	size_t                          queuedCount;
+	Handle                          nextHandle;
+	unsigned int                    nextOrder;
+	int                             searching;
+
+	/** Scratch space for the searches run by <tt>update()</tt>. */
+	PathPlanner::Scratch scratch;
+
+	/** Kept between calls to <tt>update()</tt>, so as not to reallocate. */
+	std::vector<Handover> handovers;
+
+	std::vector<std::thread> workers;
+	bool                     quit;
+	mutable std::mutex       mutex;
+	std::condition_variable  wake, idle;
+
+	bool takeQueued ( Handle & handle, Vector2D & start, Vector2D & goal );
+	void complete   ( Handle handle, PlanAction::Ptr & plan );
+	void workerLoop ();
+};
+
+#endif
@@ -1,3 +1,76 @@
 #include "Physics.h"
+#include "Room.h"
 
-std::auto_ptr<b2World> pWorld;
\ No newline at end of file
+#include <vector>
+
+std::auto_ptr<b2World> pWorld;
+
+namespace
+{
+	// Converts an outline to meters, dropping the vertices Box2D would find
+	// too close to their neighbour:
+	void toMeters(const std::vector<Vector2D>& points, float scale, bool loop, std::vector<b2Vec2>& vertices)
+	{
+		vertices.clear();
+
+		for (size_t k = 0; k < points.size(); k++)
+		{
+			b2Vec2 vertex(points[k].x / scale, points[k].y / scale);
+
+			if (!vertices.empty() && b2DistanceSquared(vertices.back(), vertex) <= b2_linearSlop * b2_linearSlop)
+				continue;
+
+			vertices.push_back(vertex);
+		}
+
+		if (loop && vertices.size() > 1 && b2DistanceSquared(vertices.back(), vertices.front()) <= b2_linearSlop * b2_linearSlop)
+			vertices.pop_back();
+	}
+}
+
+b2Body* physics::createRoomBody(b2World& world, const Room& room, float scale)
+{
+	// The room's edge mesh has the outlines already fused; build one if the
+	// room's is out of date.
+	RoomEdgeMesh mesh;
+	const RoomEdgeMesh* source = &room.edgeMesh;
+
+	if (!room.edgeMesh.isUpToDate(room.obstacleLayer))
+	{
+		mesh.build(room.obstacleLayer, room.blockGeometry, room.blockSize);
+		source = &mesh;
+	}
+
+	std::vector< std::vector<Vector2D> > loops, chains;
+	source->traceOutlines(loops, chains);
+
+	b2BodyDef bodyDef;
+	bodyDef.type = b2_staticBody;
+
+	b2Body* body = world.CreateBody(&bodyDef);
+	std::vector<b2Vec2> vertices;
+
+	for (size_t k = 0; k < loops.size(); k++)
+	{
+		toMeters(loops[k], scale, true, vertices);
+		if (vertices.size() < 3)
+			continue;
+
+		b2ChainShape chainShape;
+		chainShape.CreateLoop(&vertices[0], (int32) vertices.size());
+		body->CreateFixture(&chainShape, 0.f);
+	}
+
+	for (size_t k = 0; k < chains.size(); k++)
+	{
+		toMeters(chains[k], scale, false, vertices);
+		if (vertices.size() < 2)
+			continue;
+
+		b2ChainShape chainShape;
+		chainShape.CreateChain(&vertices[0], (int32) vertices.size());
+		body->CreateFixture(&chainShape, 0.f);
+	}
+
+	return body;
+}
\ No newline at end of file
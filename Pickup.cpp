@@ -1,4 +1,5 @@
 #include "Pickup.h"
+#include "NodePool.h"
 #include "DataTables.h"
 #include "CommandCategory.h"
 #include "CommandQueue.h"
@@ -15,8 +16,13 @@ namespace
 Pickup::Pickup(Type type, const TextureManager& textures)
 : Entity(1)
 , mType(type)
-, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
+, mSprite()
 {
+	// Headless worlds have no textures: the rect still gives the bounds
+	mSprite.setTextureRect(Table[type].textureRect);
+	if (const sf::Texture* texture = textures.find(Table[type].texture))
+		mSprite.setTexture(*texture);
+
 	centerOrigin(mSprite);
 }
 
@@ -38,4 +44,14 @@ void Pickup::apply(Character& player) const
 void Pickup::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
 {
 	target.draw(mSprite, states);
-}
\ No newline at end of file
+}
+
+void* Pickup::operator new(std::size_t size)
+{
+	return NodePool<Pickup>::allocate(size);
+}
+
+void Pickup::operator delete(void* block, std::size_t size)
+{
+	NodePool<Pickup>::deallocate(block, size);
+}
@@ -30,6 +30,10 @@ class Pickup : public Entity
 
 		void 					apply(Character& player) const;
 
+		// Storage recycled through NodePool
+		static void*			operator new(std::size_t size);
+		static void				operator delete(void* block, std::size_t size);
+
 
 	protected:
 		virtual void			drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
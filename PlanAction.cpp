@@ -5,4 +5,17 @@ PlanAction::PlanAction(sf::Vector2f point, ACTION type, PlanAction* next)
 , mType(type)
 , mNext(next)
 {
-}
\ No newline at end of file
+}
+
+PlanAction::~PlanAction()
+{
+	// Delete the rest of the chain one step at a time, rather than
+	// recursively: Long plans would run out of stack
+	while (mNext)
+	{
+		PlanAction* next = mNext;
+		mNext = next->mNext;
+		next->mNext = 0;
+		delete next;
+	}
+}
@@ -3,9 +3,15 @@
 
 #include <SFML\Graphics.hpp>
 
-class PlanAction
+#include <memory>
+
+// One step of a plan: Perform the action until the point is reached, then
+// carry on with the next step. A plan owns the steps that follow its first.
+class PlanAction : private sf::NonCopyable
 {
 public:
+	typedef std::unique_ptr<PlanAction> Ptr;
+
 	enum ACTION
 	{
 		NONE,
@@ -15,6 +21,7 @@ public:
 
 public:
 	PlanAction(sf::Vector2f point, ACTION type, PlanAction* next = 0);
+	~PlanAction();
 
 public:
 	sf::Vector2f	mPoint;
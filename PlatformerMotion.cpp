@@ -0,0 +1,698 @@
+#include "PlatformerMotion.h"
+
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Mover:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// One step of one character. The character's state is bound to references,
+// so that the model reads as a method of the character. The tests for the
+// terrain features left out of the Policy are constant, and compiled out.
+template <typename Policy>
+class Mover
+{
+public:
+	Mover ( const Room & _room, const PlatformerMotion::Tuning & _tuning, const PlatformerMotion::Controls & _controls,
+	        PlatformerMotion::State & _state, PlatformerMotion::Workspace & _workspace )
+		: room(_room), tuning(_tuning), controls(_controls), state(_state), workspace(_workspace),
+		  pos(_state.pos), vel(_state.vel), accDX(_state.accDX), isFacingLeft(_state.isFacingLeft),
+		  rightContact(_state.rightContact), leftContact(_state.leftContact),
+		  topContact(_state.topContact), bottomContact(_state.bottomContact),
+		  probedRight(_state.probedRight), probedLeft(_state.probedLeft),
+		  probedTop(_state.probedTop), probedBottom(_state.probedBottom), probedThinFloor(_state.probedThinFloor),
+		  contactCacheValid(_state.contactCacheValid), contactCachePos(_state.contactCachePos),
+		  contactCacheRoom(_state.contactCacheRoom), contactCacheVersion(_state.contactCacheVersion)
+	{
+	}
+
+	void step ( float dt );
+
+private:
+	const Room &                         room;
+	const PlatformerMotion::Tuning &     tuning;
+	const PlatformerMotion::Controls &   controls;
+	PlatformerMotion::State &            state;
+	PlatformerMotion::Workspace &        workspace;
+
+	Vector2D &     pos;
+	Vector2D &     vel;
+	float &        accDX;
+	bool &         isFacingLeft;
+	bool &         rightContact;
+	bool &         leftContact;
+	bool &         topContact;
+	bool &         bottomContact;
+	bool &         probedRight;
+	bool &         probedLeft;
+	bool &         probedTop;
+	bool &         probedBottom;
+	bool &         probedThinFloor;
+	bool &         contactCacheValid;
+	Vector2D &     contactCachePos;
+	const Room * & contactCacheRoom;
+	unsigned int & contactCacheVersion;
+
+	inline float botRightX () const { return pos.x + tuning.WIDTH/2; }
+	inline float botRightY () const { return pos.y; }
+	inline float topRightX () const { return pos.x + tuning.WIDTH/2; }
+	inline float topRightY () const { return pos.y - tuning.HEIGHT; }
+	inline float topLeftX  () const { return pos.x - tuning.WIDTH/2; }
+	inline float topLeftY  () const { return pos.y - tuning.HEIGHT; }
+	inline float botLeftX  () const { return pos.x - tuning.WIDTH/2; }
+	inline float botLeftY  () const { return pos.y; }
+
+	/**
+	 * Returns true if the character is underwater, and swims.
+	 */
+	inline bool isSwimming () const {
+		return Policy::water && tuning.FLOAT_ON_WATER_SURFACE &&
+		       PlatformerMotion::isUnderwater( room, tuning, state );
+	}
+
+	/**
+	 * Tests the side the character is walking towards (left if
+	 * <tt>dx</tt> is negative, right otherwise), moved <tt>dx</tt> pixels
+	 * sideways and <tt>dy</tt> pixels down. The side is shortened by
+	 * EPSILON at both ends, so that the floor and ceiling won't count.
+	 */
+	inline bool sideCollision ( float dx, float dy ) const {
+		float x = (dx < 0 ? topLeftX() : topRightX()) + dx;
+		return room.segmentCollision(
+				x, topLeftY() + EPSILON + dy,
+				x, botLeftY() - EPSILON + dy,
+				false );
+	}
+
+	/**
+	 * Sweeps the character's box (shortened by EPSILON at the top and
+	 * bottom, as above), starting from (offX, offY) pixels away, by
+	 * <tt>steps</tt> steps of (stepX, stepY) pixels each.
+	 *
+	 * @return The number of steps whose starting position is free; i.e.,
+	 *         how many times <tt>sideCollision(offX, offY)</tt> would have
+	 *         returned false while moving step by step.
+	 */
+	inline int bodySweep ( float offX, float offY, float stepX, float stepY, int steps ) {
+		// Above and left of the room, the pixel test rounds towards zero,
+		// and still finds the blocks of the first row and column, which the
+		// sweeps don't; there, go pixel by pixel:
+		if ( topLeftX() + offX + std::min( stepX * steps, 0.0f ) < 0 ||
+		     topLeftY() + offY + std::min( stepY * steps, 0.0f ) < 0 ) {
+			for ( int k = 0; k < steps; k++ )
+				if ( sideCollision( offX + stepX * k, offY + stepY * k ) )
+					return k;
+
+			return steps;
+		}
+
+		Room::SweepResult sweep;
+
+		if ( !room.boxSweep(
+				topLeftX()  + offX, topLeftY() + EPSILON + offY,
+				topRightX() + offX, botLeftY() - EPSILON + offY,
+				stepX * steps, stepY * steps, false, &sweep, &workspace.scratch ) )
+			return steps;
+		
+		// The time of impact is only accurate to a tiny fraction of a pixel
+		// (the edge mesh may give 0.600003 for a contact at exactly 0.6), and
+		// rounding a contact at the start of a step up would walk into the
+		// obstacle. Round those down instead, and let the pixel test decide
+		// the step at the boundary:
+		const float tolerance = 0.01f;
+		
+		int freeSteps = std::min( steps, (int) ceilf( sweep.time * steps - tolerance ) );
+		
+		if ( freeSteps < steps && !sideCollision( offX + stepX * freeSteps, offY + stepY * freeSteps ) )
+			freeSteps++;
+		
+		return freeSteps;
+	}
+};
+
+
+
+
+
+
+template <typename Policy>
+void Mover<Policy>::step ( float dt ) {
+	// Store last frame's position.
+	const Vector2D prevPos = pos;
+
+	// 
+	// Horizontal controls:
+	// 
+	// Walk left?
+	if ( controls.left && !controls.right ) {
+		isFacingLeft = true;
+		
+		// Abovewater?
+		if ( !isSwimming() ) {
+			// Make xSpeed tend to the walk speed:
+			if ( vel.x < -tuning.WALK_SPEED ) {
+				vel.x += tuning.WALK_DECELERATION * dt;
+				
+				if ( vel.x > -tuning.WALK_SPEED )
+					vel.x = -tuning.WALK_SPEED;
+			}
+			else if ( vel.x > -tuning.WALK_SPEED ) {
+				vel.x -= tuning.WALK_ACCELERATION * dt;
+				
+				if ( vel.x < -tuning.WALK_SPEED )
+					vel.x = -tuning.WALK_SPEED;
+			}
+		}
+		// Underwater?
+		else {
+			// Make xSpeed tend to the swim speed:
+			if ( vel.x < -tuning.SWIM_SPEED ) {
+				vel.x += tuning.SWIM_DECELERATION * dt;
+				
+				if ( vel.x > -tuning.SWIM_SPEED )
+					vel.x = -tuning.SWIM_SPEED;
+			}
+			else if ( vel.x > -tuning.SWIM_SPEED ) {
+				vel.x -= tuning.SWIM_ACCELERATION * dt;
+				
+				if ( vel.x < -tuning.SWIM_SPEED )
+					vel.x = -tuning.SWIM_SPEED;
+			}
+		}
+	}
+	// Walk right?
+	else if ( controls.right && !controls.left ) {
+		isFacingLeft = false;
+		
+		// Abovewater?
+		if ( !isSwimming() ) {
+			// Make xSpeed tend to the walk speed:
+			if ( vel.x > tuning.WALK_SPEED ) {
+				vel.x -= tuning.WALK_DECELERATION * dt;
+				
+				if ( vel.x < tuning.WALK_SPEED )
+					vel.x = tuning.WALK_SPEED;
+			}
+			else if ( vel.x < tuning.WALK_SPEED ) {
+				vel.x += tuning.WALK_ACCELERATION * dt;
+				
+				if ( vel.x > tuning.WALK_SPEED )
+					vel.x = tuning.WALK_SPEED;
+			}
+		}
+		// Underwater?
+		else {
+			// Make xSpeed tend to the swim speed:
+			if ( vel.x > tuning.SWIM_SPEED ) {
+				vel.x -= tuning.SWIM_DECELERATION * dt;
+				
+				if ( vel.x < tuning.SWIM_SPEED )
+					vel.x = tuning.SWIM_SPEED;
+			}
+			else if ( vel.x < tuning.SWIM_SPEED ) {
+				vel.x += tuning.SWIM_ACCELERATION * dt;
+				
+				if ( vel.x > tuning.SWIM_SPEED )
+					vel.x = tuning.SWIM_SPEED;
+			}
+		}
+	}
+	// Neither left nor right.
+	else {
+		// Slow to a stop:
+		// Abovewater?
+		if ( !isSwimming() ) {
+			if ( vel.x > 0 ) {
+				vel.x -= tuning.WALK_DECELERATION * dt;
+				
+				if ( vel.x < 0 )
+					vel.x = 0;
+			}
+			else if ( vel.x < 0 ) {
+				vel.x += tuning.WALK_DECELERATION * dt;
+				
+				if ( vel.x > 0 )
+					vel.x = 0;
+			}
+		}
+		// Underwater?
+		else {
+			if ( vel.x > 0 ) {
+				vel.x -= tuning.SWIM_DECELERATION * dt;
+				
+				if ( vel.x < 0 )
+					vel.x = 0;
+			}
+			else if ( vel.x < 0 ) {
+				vel.x += tuning.SWIM_DECELERATION * dt;
+				
+				if ( vel.x > 0 )
+					vel.x = 0;
+			}
+		}
+	}
+
+
+
+	// 
+	// Horizontal movement:
+	// 
+	// The character moves in whole pixels; the remaining fraction is kept in
+	// accDX for the next frames. Each pixel is walked only if the character's
+	// side, moved one pixel ahead, is free. Rather than testing the pixels
+	// one by one, sweep the character's box over as many of them as
+	// possible, and only look for slopes where the sweep is blocked.
+	accDX += vel.x * dt;
+	
+	float dx    = (accDX < 0 ? -1.0f : 1.0f);
+	int   steps = (std::abs(accDX) > 1.0f ? (int) ceilf( std::abs(accDX) ) - 1 : 0);
+	
+	while ( steps > 0 ) {
+		// Flat floor? Walk up to the last free pixel before the obstacle.
+		int freeSteps = bodySweep( dx, 0, dx, 0, steps );
+		
+		pos.x += dx * freeSteps;
+		accDX -= dx * freeSteps;
+		steps -= freeSteps;
+		
+		if ( steps == 0 )
+			break;
+		
+		// Now, find out what's in the next pixel:
+		float probeY, climbX, climbY;
+		
+		// Flat floor after all? (The sweep may report a grazing contact with
+		// a block's corner that the pixel test doesn't.)
+		if ( !sideCollision( dx, 0 ) ) {
+			pos.x += dx;
+			accDX -= dx;
+			steps--;
+			continue;
+		}
+		// No slopes to climb?
+		else if ( !Policy::slopes ) {
+			vel.x = 0;
+			accDX = 0;
+			break;
+		}
+		// 26-degree slope?
+		else if ( !sideCollision( dx, -0.5f ) ) {
+			// Move sideways and upwards, taking into account the climb factor:
+			probeY = -0.5f;
+			climbX = dx * tuning.CLIMB_26_SLOPE_SLOWDOWN;
+			climbY = -tuning.CLIMB_26_SLOPE_SLOWDOWN/2;
+		}
+		// 45-degree slope?
+		else if ( !sideCollision( dx, -1.0f ) ) {
+			// Move sideways and upwards, taking into account the climb factor:
+			probeY = -1.0f;
+			climbX = dx * tuning.CLIMB_45_SLOPE_SLOWDOWN;
+			climbY = -tuning.CLIMB_45_SLOPE_SLOWDOWN;
+		}
+		// Wall.
+		else {
+			vel.x = 0;
+			accDX = 0;
+			break;
+		}
+		
+		// Climb that pixel...
+		pos.x += climbX;
+		pos.y += climbY;
+		accDX -= dx;
+		steps--;
+		
+		// ...and, if the feet are still resting on the slope, keep climbing
+		// in a single sweep: Slopes always start and end at half-block
+		// boundaries, so the slope goes on at least up to the next one.
+		if ( steps > 0 && climbX != 0 && sideCollision( dx, 0 ) ) {
+			float half   = room.blockSize / 2.0f;
+			float front  = (dx > 0 ? topRightX() : topLeftX());
+			float toEdge = (dx > 0 ? ceilf( front / half ) * half - front
+			                       : front - floorf( front / half ) * half);
+			
+			int climbSteps = std::min( steps, (int) ((toEdge - 1.0f) / std::abs(climbX)) );
+			
+			if ( climbSteps > 0 ) {
+				climbSteps = bodySweep( dx, probeY, climbX, climbY, climbSteps );
+				
+				// Make sure the character ends up on the slope, and not
+				// floating above it (e.g., if it was already sunk in it):
+				float endX = climbX * climbSteps;
+				float endY = climbY * climbSteps;
+				
+				if ( !sideCollision( endX + dx, endY ) ||
+				     (probeY < -0.5f && !sideCollision( endX + dx, endY - 0.5f )) )
+					climbSteps = 0;
+				
+				pos.x += climbX * climbSteps;
+				pos.y += climbY * climbSteps;
+				accDX -= dx * climbSteps;
+				steps -= climbSteps;
+			}
+		}
+	}
+
+
+
+	// 
+	// Gravity/buoyancy:
+	// 
+	// Abovewater?
+	if ( !isSwimming() ) 
+	{
+		// Increase speed downwards if the character is not standing on the floor.
+		if ( !bottomContact )
+			vel.y += tuning.GRAVITY * dt;
+		
+		// Keep speed within the allowed limit:
+		if ( vel.y > tuning.MAX_FALL_SPEED )
+			vel.y = tuning.MAX_FALL_SPEED;
+
+		// 
+		// Jumping:
+		// 
+		if ( controls.jumpPress && bottomContact ) {
+			// If the player presses DOWN + JUMP on a thin-floor, fall through.
+			// Here, I'm going to use a trick to detect thin-floors: Since they
+			// won't trigger segment collisions if I tell the Room not to detect
+			// them, the collision will return false if the player is standing on a
+			// thin-floor.
+			if ( Policy::thinFloors && controls.down &&
+				!room.segmentCollision(
+					botLeftX(), botLeftY() + 1, botRightX(), botRightY() + 1, false ) ) {
+				pos.y += 2;
+				vel.y = 2;
+			}
+			else {
+				// Jump!
+				// Set the Y speed to the configured jump strength.
+				// This will cause the character to start moving upwards.
+				vel.y = -tuning.JUMP_STRENGTH;
+			}
+		}
+		
+		// When the player stops pressing the jump button, stop the jump:
+		if ( !controls.jump && vel.y < 0 )
+			vel.y = 0;
+	}
+	// Underwater?
+	else {
+		// Increase speed upwards if the character is not touching the ceiling.
+		if ( !topContact )
+			vel.y -= tuning.BUOYANCY * dt;
+		
+		// Keep speed within the allowed limit:
+		if ( vel.y < -tuning.MAX_FLOAT_SPEED )
+			vel.y = -tuning.MAX_FLOAT_SPEED;
+		
+		if ( vel.y > tuning.MAX_SINK_SPEED )
+			vel.y = tuning.MAX_SINK_SPEED;
+		
+		// Prevent the player from "bouncing" on the water's surface:
+		// If nothing is done, the player will surpass the water's surface and
+		// exit the water, then Gravity will kick in and make him fall in
+		// again, and so on. This looks horrible; it's better to leave the
+		// "floating" effect to the character's animation, not the game logic.
+		// So, here's what I'm going to do: If the player is *about* to leave the
+		// water (i.e., at the current speed and height, he'll be out of the
+		// water by the next frame)...
+		if ( pos.y + vel.y * dt <= room.waterLevel + tuning.SUBMERSION_HEIGHT ) {
+			// Set the player's position on the water's surface, and set the
+			// speed to zero so he'll stop bouncing.
+			pos.y = room.waterLevel + tuning.SUBMERSION_HEIGHT + EPSILON;
+			vel.y = 0;
+			
+			// Now, that last change on the player's position might have
+			// caused the bottom segment to collide against the floor...
+			// Lift him onto it, unless his head bumps into the ceiling
+			// first.
+			float maxLift = (float) room.getPixelHeight();
+			float ceilingY, clearY;
+			
+			if ( room.ceilingHeight( topLeftX(), topRightX(), topLeftY(), maxLift, &ceilingY ) )
+				maxLift = topLeftY() - ceilingY;
+			
+			if ( room.clearHeight( botLeftX(), botRightX(), botLeftY(), maxLift, &clearY ) )
+				pos.y = clearY;
+			else
+				pos.y -= maxLift;
+			
+			// 
+			// Water-jumping:
+			// 
+			// So, the player is on the water's surface. Check for a water-jump
+			// here.
+			if ( controls.jumpPress ) {
+				// Jump!
+				vel.y = -tuning.WATER_JUMP_STRENGTH;
+			}
+			
+		}
+	}
+
+	// 
+	// Vertical movement:
+	// 
+	if ( vel.y > 0 ) {
+		// Fall, and check for a floor collision on the way.
+		if ( room.segmentCollision(
+				botLeftX(), botLeftY(),
+				botRightX(), botRightY(),
+				0, vel.y * dt, 
+				Policy::thinFloors,
+				&workspace.contacts, NULL, NULL, &workspace.scratch ) ) {
+			// A collision was found!
+			// Set the Y coordinate to that point, and reset the Y speed.
+			pos.y = workspace.contacts[0].y;
+			vel.y = 0;
+		}
+		else {
+			// No collision was found. Move!
+			pos.y += vel.y * dt;
+		}
+	}
+	else if ( vel.y < 0 ) {
+		// Go up, and check for a ceiling collision on the way.
+		if ( room.segmentCollision(
+				topLeftX(), topLeftY(),
+				topRightX(), topRightY(),
+				0, vel.y * dt,
+				false,
+				&workspace.contacts, NULL, NULL, &workspace.scratch ) ) {
+			// A collision was found!
+			// Set the Y coordinate to that point, and reverse the Y speed.
+			pos.y = workspace.contacts[0].y + tuning.HEIGHT;
+			vel.y = -vel.y / 3;
+		}
+		else {
+			// No collision was found. Move!
+			pos.y += vel.y * dt;
+		}
+	}
+
+	// 
+	// Stick to floor:
+	// 
+	// If the player was on the floor up until the last frame, and suddenly
+	// found himself in the air...
+	// Also, there will be no sticking to the floor when the player is
+	// underwater, or he just jumped! (Without slopes, the floor can't drop
+	// away by a few pixels.)
+	if ( Policy::slopes && bottomContact && vel.y >= 0 && !isSwimming() ) {
+		// Maybe he's walking down a slope.
+		// Look for the floor downwards, at least as far as the X speed (thus
+		// taking into account slopes of 45 degrees).
+		float fDX = std::abs(pos.x - prevPos.x);
+		
+		float groundY;
+		
+		if ( room.groundHeight( botLeftX(), botRightX(), botLeftY(), fDX + 1, Policy::thinFloors, &groundY ) ) {
+			// Floor found! Move the player there:
+			pos.y = groundY;
+		}
+	}
+
+	// 
+	// Set contact status:
+	// 
+	// The probes only depend on the character's position and the room's
+	// obstacle layer, so they're skipped while neither has changed (e.g.,
+	// for idle characters). So is the thin-floor probe; only whether the
+	// thin-floor test uses it depends on the controls and the speed:
+	if ( !contactCacheValid ||
+	     contactCachePos.x   != pos.x ||
+	     contactCachePos.y   != pos.y ||
+	     contactCacheRoom    != &room ||
+	     contactCacheVersion != room.obstacleLayer.getVersion() ) {
+		// All four probes go through the Room in a single batched query:
+		//                   top                bottom             left                right
+		float probeX1[4] = { topLeftX(),        botLeftX(),        topLeftX()  - 1,    topRightX() + 1    };
+		float probeY1[4] = { topLeftY()  - 1,   botLeftY()  + 1,   topLeftY()  + 1,    topRightY() + 1    };
+		float probeX2[4] = { topRightX(),       botRightX(),       botLeftX()  - 1,    botRightX() + 1    };
+		float probeY2[4] = { topRightY() - 1,   botRightY() + 1,   botLeftY()  - 2,    botRightY() - 2    };
+		bool  probeHit[4];
+		
+		room.segmentCollision( probeX1, probeY1, probeX2, probeY2, 4, false, probeHit );
+		
+		probedTop    = probeHit[0];
+		probedBottom = probeHit[1];
+		probedLeft   = probeHit[2];
+		probedRight  = probeHit[3];
+		
+		// The thin-floor probe only matters when the character isn't on
+		// solid ground:
+		probedThinFloor = Policy::thinFloors && !probedBottom &&
+			room.segmentCollision(
+				botLeftX() , botLeftY() - 2,
+				botRightX(), botRightY() - 2,
+				0, 4, true, NULL, NULL, NULL );
+		
+		contactCacheValid   = true;
+		contactCachePos     = pos;
+		contactCacheRoom    = &room;
+		contactCacheVersion = room.obstacleLayer.getVersion();
+	}
+	
+	topContact    = probedTop;
+	bottomContact = probedBottom;
+	leftContact   = probedLeft;
+	rightContact  = probedRight;
+	
+	// Still touching the floor?
+	if ( bottomContact && vel.y < 0 )
+		vel.y = 0;
+	
+	// Perform a "thin-floor test" now, using the bottom segment (as probed
+	// above). Also, allow the player to fall through the thin-floor if
+	// DOWN + JUMP was pressed in this frame.
+	if ( Policy::thinFloors &&
+	     !controls.jumpPress &&
+	     !bottomContact &&
+	     vel.y >= 0 &&
+	     probedThinFloor ) {
+		bottomContact = true;
+		vel.y = 0;
+	}
+
+	// Update the Y speed to keep it consistent.
+	// However, it should only be updated if it is positive (downwards) and the
+	// player isn't underwater. This will ensure the player won't be "flying
+	// off" slopes when he gets to their top, while still preventing the "snap"
+	// that always takes place when the player walks off a ledge.
+	if ( pos.y > prevPos.y && !isSwimming() ) {
+		vel.y = (pos.y - prevPos.y) / dt;
+	}
+
+} // End of method: Mover::step
+
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// PlatformerMotion:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+PlatformerMotion::Tuning::Tuning () {
+	// A few default values:
+	HEIGHT                   =  32;
+	WIDTH                    =  24;
+	
+	WALK_SPEED               = 120.0f;
+	
+	CLIMB_26_SLOPE_SLOWDOWN  =   1.0f;
+	CLIMB_45_SLOPE_SLOWDOWN  =   0.5f;
+	
+	WALK_ACCELERATION        = 900.0f;
+	WALK_DECELERATION        = 900.0f;
+	
+	JUMP_STRENGTH            = 260.0f;
+	WATER_JUMP_STRENGTH      = 220.0f;
+	GRAVITY                  = 590.5f;
+	MAX_FALL_SPEED           = 330.0f;
+	
+	SUBMERSION_HEIGHT        = 65.0f;
+	BUOYANCY                 = 250.0f;
+	MAX_FLOAT_SPEED          =  60.0f;
+	MAX_SINK_SPEED           = 150.0f;
+	SWIM_SPEED               =  90.0f;
+	SWIM_ACCELERATION        = 225.0f;
+	SWIM_DECELERATION        = 225.0f;
+	
+	FLOAT_ON_WATER_SURFACE   = true;
+
+} // End of constructor: PlatformerMotion::Tuning
+
+
+
+
+
+
+PlatformerMotion::State::State () {
+	accDX        = 0;
+	isFacingLeft = false;
+	
+	rightContact = leftContact = topContact = bottomContact = false;
+	
+	probedRight = probedLeft = probedTop = probedBottom = probedThinFloor = false;
+	contactCacheValid   = false;
+	contactCacheRoom    = NULL;
+	contactCacheVersion = 0;
+
+} // End of constructor: PlatformerMotion::State
+
+
+
+
+
+
+const PlatformerMotion::Tuning & PlatformerMotion::defaultTuning () {
+	static const Tuning tuning;
+	
+	return tuning;
+
+} // End of method: PlatformerMotion::defaultTuning
+
+
+
+
+
+
+void PlatformerMotion::step ( const Room & room, const Tuning & tuning, const Controls & controls, float dt,
+                              State & state, Workspace & workspace ) {
+	// Without water in the room, or floating on it, there's no swimming:
+	if ( room.hasWater() && tuning.FLOAT_ON_WATER_SURFACE )
+		step<AnyTerrain>( room, tuning, controls, dt, state, workspace );
+	else
+		step<DryTerrain>( room, tuning, controls, dt, state, workspace );
+
+} // End of method: PlatformerMotion::step
+
+
+
+
+
+
+template <typename Policy>
+void PlatformerMotion::step ( const Room & room, const Tuning & tuning, const Controls & controls, float dt,
+                              State & state, Workspace & workspace ) {
+	Mover<Policy>( room, tuning, controls, state, workspace ).step( dt );
+
+} // End of method: PlatformerMotion::step
+
+
+
+// The policies the step is compiled for:
+template void PlatformerMotion::step<PlatformerMotion::AnyTerrain>  ( const Room &, const PlatformerMotion::Tuning &,
+	const PlatformerMotion::Controls &, float, PlatformerMotion::State &, PlatformerMotion::Workspace & );
+template void PlatformerMotion::step<PlatformerMotion::DryTerrain>  ( const Room &, const PlatformerMotion::Tuning &,
+	const PlatformerMotion::Controls &, float, PlatformerMotion::State &, PlatformerMotion::Workspace & );
+template void PlatformerMotion::step<PlatformerMotion::FlatTerrain> ( const Room &, const PlatformerMotion::Tuning &,
+	const PlatformerMotion::Controls &, float, PlatformerMotion::State &, PlatformerMotion::Workspace & );
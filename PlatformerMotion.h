@@ -0,0 +1,327 @@
+#ifndef _PlatformerMotion_h_
+#define _PlatformerMotion_h_
+
+#include "Room.h"
+#include "Vector2D.h"
+#include "Container.h"
+
+#include <cmath>
+
+/**
+* The movement model of platformer characters: walking and swimming,
+* climbing slopes, jumping, falling, floating on the water's surface and
+* dropping through thin floors.
+*
+* The model only reads the Room, so characters can be stepped from
+* several threads at once, as long as each thread has its own
+* <tt>Workspace</tt>.
+*
+* The tuning parameters are kept apart from the characters' state, in
+* profiles that any number of characters can share. The terrain features
+* the model deals with (water, slopes and thin floors) are chosen at
+* compile time, with a <tt>Terrain</tt> policy: <tt>step()</tt> picks
+* <tt>AnyTerrain</tt> or <tt>DryTerrain</tt> depending on whether the
+* character can ever be underwater, and callers that know more about
+* their characters can call <tt>step<Terrain>()</tt> directly.
+*
+* @code
+*           ___
+* topLeft  |   | topRight
+*          |   |
+*          |   |
+*  botLeft |___| botRight
+*            ^
+*           pos
+* @endcode
+*
+* @see Platformer, PlatformerSystem
+*/
+class PlatformerMotion
+{
+public:
+	/**
+	* The tuning parameters of a character.
+	*/
+	struct Tuning
+	{
+		/** The character's width, in pixels.
+		* @see HEIGHT */
+		float WIDTH;
+
+		/** The character's height, in pixels.
+		* @see WIDTH */
+		float HEIGHT;
+
+		/** The character's maximum walk speed, in pixels/second.
+		* (Specify a number greater than zero; the object will adjust the sign
+		* as needed.) */
+		float WALK_SPEED;
+
+		/** This factor is used to slow down the character when he is walking
+		* up a slope with 26-degree inclination. Specify a number in the range
+		* [0, 1].
+		* @code
+		* CLIMB_26_SLOPE_SLOWDOWN = 1.0; // Walks at normal speed when climbing 26-degree slopes
+		* @endcode
+		*
+		* @see CLIMB_45_SLOPE_SLOWDOWN
+		*/
+		float CLIMB_26_SLOPE_SLOWDOWN;
+
+		/** This factor is used to slow down the character when he is walking
+		* up a slope with 45-degree inclination. Specify a number in the range
+		* [0, 1].
+		* @code
+		* CLIMB_45_SLOPE_SLOWDOWN = 0.5; // Walks at half speed when climbing 45-degree slopes
+		* @endcode
+		*
+		* @see CLIMB_26_SLOPE_SLOWDOWN
+		*/
+		float CLIMB_45_SLOPE_SLOWDOWN;
+
+		/** The acceleration applied to the X speed as the player keeps
+		* pressing the walk keys, in pixels/second<sup>2</sup>. (Specify
+		* numbers greater than zero; the object will adjust the sign as
+		* needed.)
+		*
+		* @see WALK_DECELERATION */
+		float WALK_ACCELERATION;
+
+		/** The deceleration applied to the X speed as the player releases
+		* walk keys, in pixels/second<sup>2</sup>. (Specify numbers greater
+		* than zero; the object will adjust the sign as needed.)
+		*
+		* @see WALK_ACCELERATION */
+		float WALK_DECELERATION;
+
+		/** The Y speed applied when the player jumps on the ground, in
+		* pixels/second. (Specify a number greater than zero; the object will
+		* adjust the sign as needed.)
+		*
+		* @see WATER_JUMP_STRENGTH */
+		float JUMP_STRENGTH;
+
+		/** The Y speed applied when the player jumps on the water's surface,
+		* in pixels/second. (Specify a number greater than zero; the object
+		* will adjust the sign as needed.)
+		*
+		* @see JUMP_STRENGTH */
+		float WATER_JUMP_STRENGTH;
+
+		/** The acceleration applied to the Y speed when the player is falling,
+		* in pixels/second<sup>2</sup>. */
+		float GRAVITY;
+
+		/** When falling, the Y speed will be clamped to this value. */
+		float MAX_FALL_SPEED;
+
+		/** This indicates how much of the character will be submerged when
+		* floating on the water's surface.
+		*
+		* @code
+		*      ____
+		*     |    |
+		* ~~~~~~~~~~~~~~~~ /
+		*     |    |       |
+		*     |    |       | Subm. height
+		*     |    |       |
+		*     |____|       /
+		*
+		* @endcode
+		*/
+		float SUBMERSION_HEIGHT;
+
+		/** "Reverse gravity" applied to the character when underwater, in
+		* pixels/second<sup>2</sup>.
+		* (Specify a number greater than zero; the object will adjust the
+		* sign as needed.) */
+		float BUOYANCY;
+
+		/** When floating upwards the Y speed will be clamped to this value.
+		* (Specify a number greater than zero; the object will adjust the
+		* sign as needed.)
+		*
+		* @see MAX_SINK_SPEED */
+		float MAX_FLOAT_SPEED;
+
+		/** When sinking downwards the Y speed will be clamped to this value.
+		* (Specify a number greater than zero; the object will adjust the
+		* sign as needed.)
+		*
+		* @see MAX_FLOAT_SPEED */
+		float MAX_SINK_SPEED;
+
+		/** The character's maximum swimming X speed, in pixels/second.
+		* (Specify a number greater than zero; the object will adjust the
+		* sign as needed.)
+		*/
+		float SWIM_SPEED;
+
+		/** The acceleration applied to the X speed as the player keeps
+		* pressing the walk keys while underwater, in
+		* pixels/second<sup>2</sup>. (Specify numbers greater than zero; the
+		* object will adjust the signs as needed.)
+		*
+		* @see SWIM_DECELERATION */
+		float SWIM_ACCELERATION;
+
+		/** The deceleration applied to the X speed as the player releases
+		* walk keys while underwater, in pixels/second<sup>2</sup>. (Specify
+		* numbers greater than zero; the object will adjust the signs as
+		* needed.)
+		*
+		* @see SWIM_ACCELERATION */
+		float SWIM_DECELERATION;
+
+		/** You may turn off the underwater mechanics by setting this flag to
+		* false. The character will behave as though there were no water at
+		* all. */
+		bool FLOAT_ON_WATER_SURFACE;
+
+		/**
+		* Sets the default values.
+		*/
+		Tuning ();
+	};
+
+	/**
+	* The terrain features handled by the model. Leaving a feature out
+	* compiles its tests out of the step:
+	*
+	* - <tt>WATER</tt>: Swimming, and floating on the water's surface.
+	* - <tt>SLOPES</tt>: Climbing and walking down slopes; without them,
+	*   anything the character's side runs into is a wall.
+	* - <tt>THIN_FLOORS</tt>: Standing on thin floors, and dropping through
+	*   them with DOWN + JUMP; without them, the character falls through.
+	*/
+	template <bool WATER, bool SLOPES, bool THIN_FLOORS>
+	struct Terrain
+	{
+		static const bool water      = WATER;
+		static const bool slopes     = SLOPES;
+		static const bool thinFloors = THIN_FLOORS;
+	};
+
+	/** Every terrain feature. */
+	typedef Terrain<true,  true,  true>  AnyTerrain;
+
+	/** Everything but water: For rooms without water, or characters that
+	* don't float on it. */
+	typedef Terrain<false, true,  true>  DryTerrain;
+
+	/** Plain blocks only. */
+	typedef Terrain<false, false, false> FlatTerrain;
+
+	/**
+	* The buttons held for one step.
+	*/
+	struct Controls
+	{
+		/** Directional input. */
+		bool left, right, down;
+
+		/** True in the step when JUMP is pressed. */
+		bool jumpPress;
+
+		/** True as long as JUMP is kept pressed. */
+		bool jump;
+
+		/**
+		* All buttons are released.
+		*/
+		Controls () : left(false), right(false), down(false), jumpPress(false), jump(false) {}
+	};
+
+	/**
+	* Everything the model keeps about a character between steps.
+	*/
+	struct State
+	{
+		Vector2D pos, vel;
+
+		/** The fraction of a pixel walked, but not moved yet. */
+		float accDX;
+
+		/** Which way the character should be facing when its sprites are
+		* rendered. */
+		bool isFacingLeft;
+
+		/** Which segments are touching walls, floors and ceilings. */
+		bool rightContact, leftContact, topContact, bottomContact;
+
+		/** The contact probes' results, as last probed: They're valid while
+		* the character stays at contactCachePos, in contactCacheRoom, and
+		* the room's obstacle layer keeps its version. probedThinFloor is
+		* whether the bottom segment rests on a thin floor; the thin-floor
+		* test reads it rather than querying the room. */
+		bool         probedRight, probedLeft, probedTop, probedBottom, probedThinFloor;
+		bool         contactCacheValid;
+		Vector2D     contactCachePos;
+		const Room * contactCacheRoom;
+		unsigned int contactCacheVersion;
+
+		/**
+		* A character at rest at (0, 0), touching nothing.
+		*/
+		State ();
+	};
+
+	/**
+	* Scratch space for the Room queries of a step. Each thread stepping
+	* characters needs its own.
+	*/
+	struct Workspace
+	{
+		Room::Scratch       scratch;
+		Container<Vector2D> contacts;
+	};
+
+	/**
+	* The default tuning profile, shared by all characters created without
+	* one of their own.
+	*/
+	static const Tuning & defaultTuning ();
+
+	/**
+	* Advances the character by <tt>dt</tt> seconds, over the terrain
+	* features it can run into: Water is left out if the room has none, or
+	* the character doesn't float on it.
+	*/
+	static void step ( const Room & room, const Tuning & tuning, const Controls & controls, float dt,
+	                   State & state, Workspace & workspace );
+
+	/**
+	* Advances the character by <tt>dt</tt> seconds, over the terrain
+	* features of the <tt>Policy</tt>, one of the <tt>Terrain</tt>
+	* typedefs above (the step is instantiated for those three only).
+	*/
+	template <typename Policy>
+	static void step ( const Room & room, const Tuning & tuning, const Controls & controls, float dt,
+	                   State & state, Workspace & workspace );
+
+	/**
+	* @return true if the character is submerged.
+	*/
+	static inline bool isUnderwater ( const Room & room, const Tuning & tuning, const State & state ) {
+		return room.hasWater() ? (state.pos.y > room.waterLevel + tuning.SUBMERSION_HEIGHT) : false;
+	}
+
+	/**
+	* @return true if the character is floating on the water's surface.
+	*/
+	static inline bool isFloatingOnWaterSurface ( const Room & room, const Tuning & tuning, const State & state ) {
+		if ( !tuning.FLOAT_ON_WATER_SURFACE )
+			return false;
+		else
+		if ( std::abs(state.vel.y) > EPSILON )
+			return false;
+		else
+		if ( std::abs(state.pos.y - (room.waterLevel + tuning.SUBMERSION_HEIGHT)) > EPSILON )
+			return false;
+		else
+			return true;
+	}
+
+};
+
+#endif
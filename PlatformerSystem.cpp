@@ -0,0 +1,295 @@
+#include "PlatformerSystem.h"
+
+#include <algorithm>
+
+
+PlatformerSystem::PlatformerSystem ( const Room & _room, int threadCount )
+	// Initialize members:
+	: room(_room),
+	  generation(0),
+	  busy(0),
+	  quit(false),
+	  stepDt(0)
+{
+	nextChunk = 0;
+
+	if ( threadCount <= 0 )
+		threadCount = std::max( 1, (int) std::thread::hardware_concurrency() );
+
+	workspaces.resize( threadCount );
+
+	for ( int k = 1; k < threadCount; k++ )
+		workers.push_back( std::thread( &PlatformerSystem::workerLoop, this, k ) );
+
+} // End of method: PlatformerSystem::PlatformerSystem
+
+
+
+
+
+
+PlatformerSystem::~PlatformerSystem () {
+	{
+		std::lock_guard<std::mutex> lock( mutex );
+		quit = true;
+	}
+	wake.notify_all();
+
+	for ( size_t k = 0; k < workers.size(); k++ )
+		workers[k].join();
+
+} // End of method: PlatformerSystem::~PlatformerSystem
+
+
+
+
+
+
+int PlatformerSystem::addTuning ( const PlatformerMotion::Tuning & tuning ) {
+	tunings.push_back( tuning );
+
+	return (int) tunings.size() - 1;
+
+} // End of method: PlatformerSystem::addTuning
+
+
+
+
+
+
+int PlatformerSystem::add ( int tuning, const Vector2D & pos ) {
+	tuningIndex.push_back( tuning );
+	controlList.push_back( PlatformerMotion::Controls() );
+	posX.push_back( pos.x );
+	posY.push_back( pos.y );
+	velX.push_back( 0 );
+	velY.push_back( 0 );
+	accDX.push_back( 0 );
+	facingLeft.push_back( 0 );
+	contacts.push_back( 0 );
+	cacheValid.push_back( 0 );
+	cacheContacts.push_back( 0 );
+	cacheX.push_back( 0 );
+	cacheY.push_back( 0 );
+	cacheVersion.push_back( 0 );
+
+	return getCount() - 1;
+
+} // End of method: PlatformerSystem::add
+
+
+
+
+
+
+void PlatformerSystem::remove ( int index ) {
+	int last = getCount() - 1;
+
+	// Move the last character into the slot:
+	if ( index != last ) {
+		tuningIndex[index]   = tuningIndex[last];
+		controlList[index]   = controlList[last];
+		posX[index]          = posX[last];
+		posY[index]          = posY[last];
+		velX[index]          = velX[last];
+		velY[index]          = velY[last];
+		accDX[index]         = accDX[last];
+		facingLeft[index]    = facingLeft[last];
+		contacts[index]      = contacts[last];
+		cacheValid[index]    = cacheValid[last];
+		cacheContacts[index] = cacheContacts[last];
+		cacheX[index]        = cacheX[last];
+		cacheY[index]        = cacheY[last];
+		cacheVersion[index]  = cacheVersion[last];
+	}
+
+	tuningIndex.pop_back();
+	controlList.pop_back();
+	posX.pop_back();
+	posY.pop_back();
+	velX.pop_back();
+	velY.pop_back();
+	accDX.pop_back();
+	facingLeft.pop_back();
+	contacts.pop_back();
+	cacheValid.pop_back();
+	cacheContacts.pop_back();
+	cacheX.pop_back();
+	cacheY.pop_back();
+	cacheVersion.pop_back();
+
+} // End of method: PlatformerSystem::remove
+
+
+
+
+
+
+void PlatformerSystem::clear () {
+	tuningIndex.clear();
+	controlList.clear();
+	posX.clear();
+	posY.clear();
+	velX.clear();
+	velY.clear();
+	accDX.clear();
+	facingLeft.clear();
+	contacts.clear();
+	cacheValid.clear();
+	cacheContacts.clear();
+	cacheX.clear();
+	cacheY.clear();
+	cacheVersion.clear();
+
+} // End of method: PlatformerSystem::clear
+
+
+
+
+
+
+void PlatformerSystem::setPos ( int index, const Vector2D & pos ) {
+	posX[index]       = pos.x;
+	posY[index]       = pos.y;
+	velX[index]       = 0;
+	velY[index]       = 0;
+	accDX[index]      = 0;
+	cacheValid[index] = 0;
+
+} // End of method: PlatformerSystem::setPos
+
+
+
+
+
+
+void PlatformerSystem::step ( float dt ) {
+	stepDt    = dt;
+	nextChunk = 0;
+
+	// Not worth waking up the workers for a couple of chunks:
+	if ( workers.empty() || getCount() <= CHUNK_SIZE ) {
+		runChunks( workspaces[0] );
+	}
+	else {
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			generation++;
+			busy = (int) workers.size();
+		}
+		wake.notify_all();
+
+		// Lend a hand, then wait for the workers to finish:
+		runChunks( workspaces[0] );
+
+		std::unique_lock<std::mutex> lock( mutex );
+		done.wait( lock, [this] { return busy == 0; } );
+	}
+
+	// JUMP is only pressed for one step:
+	for ( size_t i = 0; i < controlList.size(); i++ )
+		controlList[i].jumpPress = false;
+
+} // End of method: PlatformerSystem::step
+
+
+
+
+
+
+void PlatformerSystem::runChunks ( PlatformerMotion::Workspace & workspace ) {
+	int count = getCount();
+
+	for ( ;; ) {
+		int first = (nextChunk++) * CHUNK_SIZE;
+		if ( first >= count )
+			break;
+
+		stepRange( first, std::min( first + CHUNK_SIZE, count ), workspace );
+	}
+
+} // End of method: PlatformerSystem::runChunks
+
+
+
+
+
+
+void PlatformerSystem::stepRange ( int first, int last, PlatformerMotion::Workspace & workspace ) {
+	PlatformerMotion::State state;
+
+	for ( int i = first; i < last; i++ ) {
+		// Gather the character's state from the arrays...
+		state.pos                 = Vector2D( posX[i], posY[i] );
+		state.vel                 = Vector2D( velX[i], velY[i] );
+		state.accDX               = accDX[i];
+		state.isFacingLeft        = (facingLeft[i] != 0);
+		state.rightContact        = (contacts[i] & CONTACT_RIGHT)  != 0;
+		state.leftContact         = (contacts[i] & CONTACT_LEFT)   != 0;
+		state.topContact          = (contacts[i] & CONTACT_TOP)    != 0;
+		state.bottomContact       = (contacts[i] & CONTACT_BOTTOM) != 0;
+		state.probedRight         = (cacheContacts[i] & CONTACT_RIGHT)  != 0;
+		state.probedLeft          = (cacheContacts[i] & CONTACT_LEFT)   != 0;
+		state.probedTop           = (cacheContacts[i] & CONTACT_TOP)    != 0;
+		state.probedBottom        = (cacheContacts[i] & CONTACT_BOTTOM) != 0;
+		state.probedThinFloor     = (cacheContacts[i] & CACHED_THIN_FLOOR) != 0;
+		state.contactCacheValid   = (cacheValid[i] != 0);
+		state.contactCachePos     = Vector2D( cacheX[i], cacheY[i] );
+		state.contactCacheRoom    = &room;
+		state.contactCacheVersion = cacheVersion[i];
+
+		PlatformerMotion::step( room, tunings[tuningIndex[i]], controlList[i], stepDt, state, workspace );
+
+		// ...and scatter it back:
+		posX[i]          = state.pos.x;
+		posY[i]          = state.pos.y;
+		velX[i]          = state.vel.x;
+		velY[i]          = state.vel.y;
+		accDX[i]         = state.accDX;
+		facingLeft[i]    = state.isFacingLeft;
+		contacts[i]      = (state.rightContact  ? CONTACT_RIGHT  : 0) |
+		                   (state.leftContact   ? CONTACT_LEFT   : 0) |
+		                   (state.topContact    ? CONTACT_TOP    : 0) |
+		                   (state.bottomContact ? CONTACT_BOTTOM : 0);
+		cacheContacts[i] = (state.probedRight     ? CONTACT_RIGHT  : 0) |
+		                   (state.probedLeft      ? CONTACT_LEFT   : 0) |
+		                   (state.probedTop       ? CONTACT_TOP    : 0) |
+		                   (state.probedBottom    ? CONTACT_BOTTOM : 0) |
+		                   (state.probedThinFloor ? CACHED_THIN_FLOOR : 0);
+		cacheValid[i]    = state.contactCacheValid;
+		cacheX[i]        = state.contactCachePos.x;
+		cacheY[i]        = state.contactCachePos.y;
+		cacheVersion[i]  = state.contactCacheVersion;
+	}
+
+} // End of method: PlatformerSystem::stepRange
+
+
+
+
+
+
+void PlatformerSystem::workerLoop ( int workspace ) {
+	unsigned int seen = 0;
+
+	for ( ;; ) {
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			wake.wait( lock, [this, seen] { return quit || generation != seen; } );
+
+			if ( quit )
+				return;
+
+			seen = generation;
+		}
+
+		runChunks( workspaces[workspace] );
+
+		{
+			std::lock_guard<std::mutex> lock( mutex );
+			if ( --busy == 0 )
+				done.notify_one();
+		}
+	}
+
+} // End of method: PlatformerSystem::workerLoop
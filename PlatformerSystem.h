@@ -0,0 +1,178 @@
+#ifndef _PlatformerSystem_h_
+#define _PlatformerSystem_h_
+
+#include "PlatformerMotion.h"
+#include "Room.h"
+#include "Vector2D.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+* Steps a crowd of platformer characters (e.g., patrolling NPCs) through
+* the same movement model as the player, in a single batch per frame.
+*
+* The characters' state is kept in contiguous arrays, one per field, and
+* their tuning parameters are shared: Characters are created from a
+* tuning profile registered with <tt>addTuning()</tt>. Each frame, the
+* characters are split into chunks that worker threads step in
+* parallel, all of them querying the same Room, which must not change
+* during <tt>step()</tt>. The results don't depend on the number of
+* threads.
+*
+* Characters are identified by their index, from 0 to
+* <tt>getCount() - 1</tt>.
+*
+* @see PlatformerMotion
+*/
+class PlatformerSystem
+{
+public:
+	/** Contact flags, as returned by <tt>getContacts()</tt>. */
+	enum Contact
+	{
+		CONTACT_RIGHT  = 1,
+		CONTACT_LEFT   = 2,
+		CONTACT_TOP    = 4,
+		CONTACT_BOTTOM = 8
+	};
+
+	/**
+	* Creates an empty system for the room. The characters are stepped by
+	* <tt>threadCount</tt> threads, including the one calling
+	* <tt>step()</tt>; 0 means one per hardware thread.
+	*/
+	PlatformerSystem ( const Room & room, int threadCount = 0 );
+
+	~PlatformerSystem ();
+
+	/**
+	* Registers a tuning profile, for characters to be created from.
+	*
+	* @return The profile's index.
+	*/
+	int addTuning ( const PlatformerMotion::Tuning & tuning );
+
+	/**
+	* Creates a character at rest at <tt>pos</tt>, using the profile
+	* <tt>tuning</tt>.
+	*
+	* @return The character's index.
+	*/
+	int add ( int tuning, const Vector2D & pos );
+
+	/**
+	* Removes a character. The last character takes its index.
+	*/
+	void remove ( int index );
+
+	/**
+	* Removes all characters; the tuning profiles are kept.
+	*/
+	void clear ();
+
+	/**
+	* @return The number of characters.
+	*/
+	inline int getCount () const {
+		return (int) posX.size();
+	}
+
+	/**
+	* @return The number of threads stepping the characters.
+	*/
+	inline int getThreadCount () const {
+		return (int) workers.size() + 1;
+	}
+
+	/**
+	* The character's buttons, for the next step. <tt>jumpPress</tt> is
+	* released after every step; the other buttons are kept until changed.
+	*/
+	inline PlatformerMotion::Controls & controls ( int index ) {
+		return controlList[index];
+	}
+
+	inline Vector2D getPos ( int index ) const {
+		return Vector2D( posX[index], posY[index] );
+	}
+
+	inline Vector2D getVel ( int index ) const {
+		return Vector2D( velX[index], velY[index] );
+	}
+
+	inline bool isFacingLeft ( int index ) const {
+		return facingLeft[index] != 0;
+	}
+
+	/**
+	* @return The character's <tt>Contact</tt> flags.
+	*/
+	inline int getContacts ( int index ) const {
+		return contacts[index];
+	}
+
+	/**
+	* Moves a character (e.g., to respawn it), stopping it.
+	*/
+	void setPos ( int index, const Vector2D & pos );
+
+	/**
+	* Advances all characters by <tt>dt</tt> seconds.
+	*/
+	void step ( float dt );
+
+private:
+	/** Characters per chunk of work. */
+	static const int CHUNK_SIZE = 32;
+
+	/** The thin-floor probe's flag in <tt>cacheContacts</tt>, next to the
+	* contact flags. */
+	static const unsigned char CACHED_THIN_FLOOR = 16;
+
+	const Room & room;
+
+	std::vector<PlatformerMotion::Tuning> tunings;
+
+	// The characters:
+	std::vector<int>                        tuningIndex;
+	std::vector<PlatformerMotion::Controls> controlList;
+	std::vector<float>                      posX, posY, velX, velY, accDX;
+	std::vector<unsigned char>              facingLeft, contacts;
+
+	// The contact probes' cache (see PlatformerMotion::State), with the
+	// contact flags and CACHED_THIN_FLOOR; it's always for this room:
+	std::vector<unsigned char>              cacheValid, cacheContacts;
+	std::vector<float>                      cacheX, cacheY;
+	std::vector<unsigned int>               cacheVersion;
+
+	// The worker threads, and the step they're working on. Workspace 0
+	// belongs to the thread calling step().
+	std::vector<std::thread>                 workers;
+	std::vector<PlatformerMotion::Workspace> workspaces;
+	std::mutex                               mutex;
+	std::condition_variable                  wake, done;
+	unsigned int                             generation;
+	int                                      busy;
+	bool                                     quit;
+	float                                    stepDt;
+	std::atomic<int>                         nextChunk;
+
+	/**
+	* Takes chunks of characters and steps them, until there are none left.
+	*/
+	void runChunks ( PlatformerMotion::Workspace & workspace );
+
+	/**
+	* Steps the characters first .. last - 1.
+	*/
+	void stepRange ( int first, int last, PlatformerMotion::Workspace & workspace );
+
+	void workerLoop ( int workspace );
+
+};
+
+#endif
@@ -54,12 +54,30 @@ void Player::handleEvent(const sf::Event& event, CommandQueue& commands)
 
 void Player::handleRealtimeInput(CommandQueue& commands)
 {
+	triggerActions(getRealtimeActions(), commands);
+}
+
+unsigned int Player::getRealtimeActions() const
+{
+	unsigned int actions = 0;
+
 	// Traverse all assigned keys and check if they are pressed
 	FOREACH(auto pair, mKeyBinding)
 	{
-		// If key is pressed, lookup action and trigger corresponding command
 		if (sf::Keyboard::isKeyPressed(pair.first) && isRealtimeAction(pair.second))
-			commands.push(mActionBinding[pair.second]);
+			actions |= 1u << pair.second;
+	}
+
+	return actions;
+}
+
+void Player::triggerActions(unsigned int actions, CommandQueue& commands)
+{
+	// Trigger the command of each active action
+	for (int action = 0; action < ActionCount; ++action)
+	{
+		if (actions & (1u << action))
+			commands.push(mActionBinding[static_cast<Action>(action)]);
 	}
 }
 
@@ -31,6 +31,11 @@ public:
 	void					handleEvent(const sf::Event& event, CommandQueue& commands);
 	void					handleRealtimeInput(CommandQueue& commands);
 
+	// Realtime actions as a bit mask (bit n set if Action n is active), so
+	// that the input of each frame can be recorded and played back
+	unsigned int			getRealtimeActions() const;
+	void					triggerActions(unsigned int actions, CommandQueue& commands);
+
 	void					assignKey(Action action, sf::Keyboard::Key key);
 	sf::Keyboard::Key		getAssignedKey(Action action) const;
 
@@ -1,4 +1,5 @@
 #include "Projectile.h"
+#include "NodePool.h"
 #include "EmitterNode.h"
 #include "DataTables.h"
 #include "Utility.h"
@@ -17,9 +18,14 @@ namespace
 Projectile::Projectile(Type type, const TextureManager& textures)
 : Entity(1)
 , mType(type)
-, mSprite(textures.get(Table[type].texture), Table[type].textureRect)
+, mSprite()
 , mTargetDirection()
 {
+	// Headless worlds have no textures: the rect still gives the bounds
+	mSprite.setTextureRect(Table[type].textureRect);
+	if (const sf::Texture* texture = textures.find(Table[type].texture))
+		mSprite.setTexture(*texture);
+
 	centerOrigin(mSprite);
 
 	// Add particle system for missiles
@@ -90,4 +96,14 @@ float Projectile::getMaxSpeed() const
 int Projectile::getDamage() const
 {
 	return Table[mType].damage;
-}
\ No newline at end of file
+}
+
+void* Projectile::operator new(std::size_t size)
+{
+	return NodePool<Projectile>::allocate(size);
+}
+
+void Projectile::operator delete(void* block, std::size_t size)
+{
+	NodePool<Projectile>::deallocate(block, size);
+}
@@ -30,6 +30,10 @@ class Projectile : public Entity
 		float					getMaxSpeed() const;
 		int						getDamage() const;
 
+		// Storage recycled through NodePool
+		static void*			operator new(std::size_t size);
+		static void				operator delete(void* block, std::size_t size);
+
 	
 	private:
 		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
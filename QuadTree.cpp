@@ -1,53 +1,108 @@
 #include "QuadTree.h"
 
-#include <list>
+#include <algorithm>
 
-#include <LTBL/QuadTree/QuadTreeNode.h>
-#include <LTBL/QuadTree/QuadTree.h>
-
-#include <SFML/OpenGL.hpp>
+#include <assert.h>
 
 namespace qdt
 {
+	namespace
+	{
+		void RenderRegion(sf::RenderTarget &target, sf::RenderStates states, const sf::FloatRect &region, const sf::Color &color)
+		{
+			sf::RectangleShape shape;
+			shape.setPosition(sf::Vector2f(region.left, region.top));
+			shape.setSize(sf::Vector2f(region.width, region.height));
+			shape.setFillColor(sf::Color::Transparent);
+			shape.setOutlineColor(color);
+			shape.setOutlineThickness(1.0f);
+
+			target.draw(shape, states);
+		}
+	}
+
+	QuadTree::QuadTree()
+		: m_numAdded(0)
+	{
+	}
+
+	QuadTree::~QuadTree()
+	{
+		ReleaseOccupants();
+	}
+
 	void QuadTree::OnRemoval()
 	{
 	}
 
 	void QuadTree::SetQuadTree(QuadTreeOccupant* pOc)
 	{
+		assert(pOc->m_pQuadTree == NULL);
+
 		pOc->m_pQuadTree = this;
+		pOc->m_pQuadTreeNode = NULL;
+		pOc->m_addOrder = m_numAdded++;
+	}
+
+	void QuadTree::RemoveOutsideRoot(QuadTreeOccupant* pOc)
+	{
+		std::vector<QuadTreeOccupant*>::iterator it = std::find(m_outsideRoot.begin(), m_outsideRoot.end(), pOc);
+
+		assert(it != m_outsideRoot.end());
+
+		*it = m_outsideRoot.back();
+		m_outsideRoot.pop_back();
+	}
+
+	void QuadTree::ReleaseOccupants()
+	{
+		std::vector<QuadTreeOccupant*> occupants(m_outsideRoot);
+
+		if(m_pRootNode)
+			m_pRootNode->GetAllOccupantsBelow(occupants);
+
+		for(std::size_t i = 0; i < occupants.size(); i++)
+		{
+			occupants[i]->m_pQuadTree = NULL;
+			occupants[i]->m_pQuadTreeNode = NULL;
+		}
+
+		m_outsideRoot.clear();
+		m_pRootNode.reset();
 	}
 
-	void QuadTree::Query_Region(const AABB &region, std::vector<QuadTreeOccupant*> &result)
+	void QuadTree::Query_Region(const sf::FloatRect &region, std::vector<QuadTreeOccupant*> &result)
 	{
 		// Query outside root elements
-		for(std::unordered_set<QuadTreeOccupant*>::iterator it = m_outsideRoot.begin(); it != m_outsideRoot.end(); it++)
+		for(std::size_t i = 0; i < m_outsideRoot.size(); i++)
 		{
-			QuadTreeOccupant* pOc = *it;
+			QuadTreeOccupant* pOc = m_outsideRoot[i];
 
-			if(region.Intersects(pOc->m_aabb))
+			if(region.intersects(pOc->m_aabb))
 			{
 				// Intersects, add to list
 				result.push_back(pOc);
 			}
 		}
 
-		std::list<QuadTreeNode*> open;
+		if(!m_pRootNode)
+			return;
 
-		open.push_back(m_pRootNode.get());
+		m_open.clear();
+		m_open.push_back(m_pRootNode.get());
 
-		while(!open.empty())
+		while(!m_open.empty())
 		{
 			// Depth-first (results in less memory usage), remove objects from open list
-			QuadTreeNode* pCurrent = open.back();
-			open.pop_back();
+			QuadTreeNode* pCurrent = m_open.back();
+			m_open.pop_back();
 
 			// Add occupants if they are in the region
-			for(std::unordered_set<QuadTreeOccupant*>::iterator it = pCurrent->m_pOccupants.begin(); it != pCurrent->m_pOccupants.end(); it++)
+			for(std::size_t i = 0; i < pCurrent->m_pOccupants.size(); i++)
 			{
-				QuadTreeOccupant* pOc = *it;
+				QuadTreeOccupant* pOc = pCurrent->m_pOccupants[i];
 
-				if(region.Intersects(pOc->m_aabb))
+				if(region.intersects(pOc->m_aabb))
 				{
 					// Intersects, add to list
 					result.push_back(pOc);
@@ -55,58 +110,48 @@ namespace qdt
 			}
 
 			// Add children to open list if they intersect the region
-			if(pCurrent->m_hasChildren)
+			if(pCurrent->m_children)
 			{
-				for(int x = 0; x < 2; x++)
-					for(int y = 0; y < 2; y++)
-					{
-						if(region.Intersects((*pCurrent->m_children)[x][y].m_region))
-							open.push_back(&(*pCurrent->m_children)[x][y]);
-					}
+				for(int i = 0; i < 4; i++)
+				{
+					if(region.intersects(pCurrent->m_children[i].m_region))
+						m_open.push_back(&pCurrent->m_children[i]);
+				}
 			}
 		}
 	}
 
-	void QuadTree::DebugRender()
+	void QuadTree::DebugRender(sf::RenderTarget &target, sf::RenderStates states)
 	{
 		// Render outside root AABB's
-		glColor3f(0.5f, 0.2f, 0.1f);
+		for(std::size_t i = 0; i < m_outsideRoot.size(); i++)
+			RenderRegion(target, states, m_outsideRoot[i]->m_aabb, sf::Color(128, 51, 26));
 
-		for(std::unordered_set<QuadTreeOccupant*>::iterator it = m_outsideRoot.begin(); it != m_outsideRoot.end(); it++)
-			(*it)->m_aabb.DebugRender();
+		if(!m_pRootNode)
+			return;
 
 		// Now draw the tree
-		std::list<QuadTreeNode*> open;
+		m_open.clear();
+		m_open.push_back(m_pRootNode.get());
 
-		open.push_back(m_pRootNode.get());
-
-		while(!open.empty())
+		while(!m_open.empty())
 		{
 			// Depth-first (results in less memory usage), remove objects from open list
-			QuadTreeNode* pCurrent = open.back();
-			open.pop_back();
+			QuadTreeNode* pCurrent = m_open.back();
+			m_open.pop_back();
 
 			// Render node region AABB
-			glColor3f(0.4f, 0.9f, 0.7f);
-
-			pCurrent->m_region.DebugRender();
-
-			glColor3f(0.5f, 0.2f, 0.2f);
+			RenderRegion(target, states, pCurrent->m_region, sf::Color(102, 230, 179));
 
 			// Render occupants
-			for(std::unordered_set<QuadTreeOccupant*>::iterator it = pCurrent->m_pOccupants.begin(); it != pCurrent->m_pOccupants.end(); it++)
-			{
-				QuadTreeOccupant* pOc = *it;
-
-				pOc->m_aabb.DebugRender();
-			}
+			for(std::size_t i = 0; i < pCurrent->m_pOccupants.size(); i++)
+				RenderRegion(target, states, pCurrent->m_pOccupants[i]->m_aabb, sf::Color(128, 51, 51));
 
-			// Add children to open list if they are visible
-			if(pCurrent->m_hasChildren)
+			// Add children to open list
+			if(pCurrent->m_children)
 			{
-				for(int x = 0; x < 2; x++)
-					for(int y = 0; y < 2; y++)
-						open.push_back(&(*pCurrent->m_children)[x][y]);
+				for(int i = 0; i < 4; i++)
+					m_open.push_back(&pCurrent->m_children[i]);
 			}
 		}
 	}
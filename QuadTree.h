@@ -2,9 +2,11 @@
 #define QDT_QUADTREE_H
 
 #include "QuadTreeNode.h"
-#include "QuadTreeOccupant.h
+#include "QuadTreeOccupant.h"
 
-#include <unordered_set>
+#include <SFML\Graphics.hpp>
+
+#include <vector>
 #include <memory>
 
 namespace qdt
@@ -13,26 +15,46 @@ namespace qdt
 	class QuadTree
 	{
 	protected:
-		std::unordered_set<QuadTreeOccupant*> m_outsideRoot;
+		std::vector<QuadTreeOccupant*> m_outsideRoot;
 
 		std::unique_ptr<QuadTreeNode> m_pRootNode;
 
+		unsigned int m_numAdded;
+
+		// Scratch space for the queries, kept between them
+		std::vector<QuadTreeNode*> m_open;
+
 		// Called whenever something is removed, an action can be defined by derived classes
 		// Defaults to doing nothing
 		virtual void OnRemoval();
 
+		// Makes pOc an occupant of this tree; derived classes then place it
 		void SetQuadTree(QuadTreeOccupant* pOc);
 
+		void RemoveOutsideRoot(QuadTreeOccupant* pOc);
+
+		// Forgets all occupants (they are not in any tree afterwards)
+		void ReleaseOccupants();
+
 	public:
+		QuadTree();
+		virtual ~QuadTree();
+
 		virtual void Add(QuadTreeOccupant* pOc) = 0;
 
-		void Query_Region(const AABB &region, std::vector<QuadTreeOccupant*> &result);
+		// Appends the occupants whose AABB intersects the region to result, without
+		// clearing it first
+		void Query_Region(const sf::FloatRect &region, std::vector<QuadTreeOccupant*> &result);
 
-		void DebugRender();
+		void DebugRender(sf::RenderTarget &target, sf::RenderStates states);
 
 		friend class QuadTreeNode;
 		friend class QuadTreeOccupant;
+
+	private:
+		QuadTree(const QuadTree&);
+		QuadTree &operator=(const QuadTree&);
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
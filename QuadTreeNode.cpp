@@ -1,8 +1,8 @@
-#include <LTBL/QuadTree/QuadTreeNode.h>
+#include "QuadTreeNode.h"
 
-#include <list>
+#include "QuadTree.h"
 
-#include <LTBL/QuadTree/QuadTree.h>
+#include <algorithm>
 
 #include <assert.h>
 
@@ -14,24 +14,26 @@ namespace qdt
 	int QuadTreeNode::maxNumLevels = 20;
 	float QuadTreeNode::m_oversizeMultiplier = 1.2f;
 
-	QuadTreeNode::QuadTreeNode()
-		: m_hasChildren(false), m_numOccupantsBelow(0)
+	bool Contains(const sf::FloatRect &outer, const sf::FloatRect &inner)
 	{
+		return inner.left >= outer.left && inner.top >= outer.top
+			&& inner.left + inner.width <= outer.left + outer.width
+			&& inner.top + inner.height <= outer.top + outer.height;
 	}
 
-	QuadTreeNode::QuadTreeNode(const AABB &region, int level, QuadTreeNode* pParent, QuadTree* pQuadTree)
-		: m_pParent(pParent), m_pQuadTree(pQuadTree),
-		m_hasChildren(false), m_region(region), m_level(level), m_numOccupantsBelow(0)
+	QuadTreeNode::QuadTreeNode()
+		: m_pParent(NULL), m_pQuadTree(NULL),
+		m_level(0), m_numOccupantsBelow(0)
 	{
 	}
 
-	QuadTreeNode::~QuadTreeNode()
+	QuadTreeNode::QuadTreeNode(const sf::FloatRect &region, int level, QuadTreeNode* pParent, QuadTree* pQuadTree)
+		: m_pParent(pParent), m_pQuadTree(pQuadTree),
+		m_region(region), m_level(level), m_numOccupantsBelow(0)
 	{
-		if(m_hasChildren)
-			DestroyChildren();
 	}
 
-	void QuadTreeNode::Create(const AABB &region, int level, QuadTreeNode* pParent, QuadTree* pQuadTree)
+	void QuadTreeNode::Create(const sf::FloatRect &region, int level, QuadTreeNode* pParent, QuadTree* pQuadTree)
 	{
 		m_region = region;
 		m_level = level;
@@ -39,48 +41,45 @@ namespace qdt
 		m_pQuadTree = pQuadTree;
 	}
 
-	inline QuadTreeNode* QuadTreeNode::GetChild(const Point2i position)
-	{
-		return &(*m_children)[position.x][position.y];
-	}
-
-	void QuadTreeNode::GetPossibleOccupantPosition(QuadTreeOccupant* pOc, Point2i &point)
+	QuadTreeNode* QuadTreeNode::GetPossibleChild(const QuadTreeOccupant* pOc)
 	{
 		// Compare the center of the AABB of the occupant to that of this node to determine
 		// which child it may (possibly, not certainly) fit in
-		const Vec2f &occupantCenter(pOc->m_aabb.GetCenter());
-		const Vec2f &nodeRegionCenter(m_region.GetCenter());
+		float occupantCenterX = pOc->m_aabb.left + pOc->m_aabb.width / 2.0f;
+		float occupantCenterY = pOc->m_aabb.top + pOc->m_aabb.height / 2.0f;
 
-		if(occupantCenter.x > nodeRegionCenter.x)
-			point.x = 1;
-		else
-			point.x = 0;
+		int x = occupantCenterX > m_region.left + m_region.width / 2.0f ? 1 : 0;
+		int y = occupantCenterY > m_region.top + m_region.height / 2.0f ? 1 : 0;
 
-		if(occupantCenter.y > nodeRegionCenter.y)
-			point.y = 1;
-		else
-			point.y = 0;
+		return &m_children[x * 2 + y];
 	}
 
 	void QuadTreeNode::AddToThisLevel(QuadTreeOccupant* pOc)
 	{
 		pOc->m_pQuadTreeNode = this;
 
-		m_pOccupants.insert(pOc);
+		m_pOccupants.push_back(pOc);
 	}
 
-	bool QuadTreeNode::AddToChildren(QuadTreeOccupant* pOc)
+	void QuadTreeNode::RemoveFromThisLevel(QuadTreeOccupant* pOc)
 	{
-		assert(m_hasChildren);
+		std::vector<QuadTreeOccupant*>::iterator it = std::find(m_pOccupants.begin(), m_pOccupants.end(), pOc);
 
-		Point2i position;
+		assert(it != m_pOccupants.end());
+
+		// Order within a node doesn't matter, swap with the last one
+		*it = m_pOccupants.back();
+		m_pOccupants.pop_back();
+	}
 
-		GetPossibleOccupantPosition(pOc, position);
+	bool QuadTreeNode::AddToChildren(QuadTreeOccupant* pOc)
+	{
+		assert(m_children);
 
-		QuadTreeNode* pChild = GetChild(position);
+		QuadTreeNode* pChild = GetPossibleChild(pOc);
 
 		// See if the occupant fits in the child at the selected position
-		if(pChild->m_region.Contains(pOc->m_aabb))
+		if(Contains(pChild->m_region, pOc->m_aabb))
 		{
 			// Fits, so can add to the child and finish
 			pChild->Add(pOc);
@@ -93,97 +92,73 @@ namespace qdt
 
 	void QuadTreeNode::Partition()
 	{
-		assert(!m_hasChildren);
+		assert(!m_children);
 
-		const Vec2f &halfRegionDims(m_region.GetHalfDims());
-		const Vec2f &regionLowerBound(m_region.GetLowerBound());
-		const Vec2f &regionCenter(m_region.GetCenter());
+		float halfWidth = m_region.width / 2.0f;
+		float halfHeight = m_region.height / 2.0f;
 
-		int nextLowerLevel = m_level - 1;
+		// Children overlap, scaled up by the oversize multiplier around their centers,
+		// so that occupants on the boundaries still fit in one. They are clipped to
+		// this node's region, so that every occupant below it lies within it
+		float childWidth = halfWidth * m_oversizeMultiplier;
+		float childHeight = halfHeight * m_oversizeMultiplier;
 
-		m_children = new std::vector<std::vector<QuadTreeNode>>();
-
-		// Create the children nodes
-		(*m_children).resize(2);
+		m_children.reset(new QuadTreeNode[4]);
 
 		for(int x = 0; x < 2; x++)
-		{
-			(*m_children)[x].resize(2);
-
 			for(int y = 0; y < 2; y++)
 			{
-				Vec2f offset(x * halfRegionDims.x, y * halfRegionDims.y);
-
-				AABB childAABB(regionLowerBound + offset, regionCenter + offset);
+				float centerX = m_region.left + (x + 0.5f) * halfWidth;
+				float centerY = m_region.top + (y + 0.5f) * halfHeight;
 
-				childAABB.SetHalfDims(childAABB.GetHalfDims() * m_oversizeMultiplier);
+				sf::FloatRect childRegion(centerX - childWidth / 2.0f, centerY - childHeight / 2.0f, childWidth, childHeight);
+				m_region.intersects(childRegion, childRegion);
 
-				// Scale up AABB by the oversize multiplier
-
-				(*m_children)[x][y].Create(childAABB, nextLowerLevel, this, m_pQuadTree);
+				m_children[x * 2 + y].Create(childRegion, m_level + 1, this, m_pQuadTree);
 			}
-		}
-
-		m_hasChildren = true;
-	}
-
-	void QuadTreeNode::DestroyChildren()
-	{
-		assert(m_hasChildren);
 
-		delete m_children;
+		// Push the occupants that fit down into the children
+		std::vector<QuadTreeOccupant*> occupants;
+		occupants.swap(m_pOccupants);
 
-		m_hasChildren = false;
+		for(std::size_t i = 0; i < occupants.size(); i++)
+			if(!AddToChildren(occupants[i]))
+				AddToThisLevel(occupants[i]);
 	}
 
 	void QuadTreeNode::Merge()
 	{
-		if(m_hasChildren)
+		if(m_children)
 		{
 			// Place all occupants at lower levels into this node
-			GetOccupants(m_pOccupants);
+			for(int i = 0; i < 4; i++)
+				m_children[i].GetAllOccupantsBelow(m_pOccupants);
 
-			DestroyChildren();
+			for(std::size_t i = 0; i < m_pOccupants.size(); i++)
+				m_pOccupants[i]->m_pQuadTreeNode = this;
+
+			m_children.reset();
 		}
 	}
 
-	void QuadTreeNode::GetOccupants(std::unordered_set<QuadTreeOccupant*> &occupants)
+	void QuadTreeNode::MergeUpwards(QuadTreeNode* pStop)
 	{
-		// Iteratively parse subnodes in order to collect all occupants below this node
-		std::list<QuadTreeNode*> open;
-
-		open.push_back(this);
+		QuadTreeNode* pMerge = NULL;
 
-		while(!open.empty())
+		for(QuadTreeNode* pNode = this; pNode != pStop; pNode = pNode->m_pParent)
 		{
-			// Depth-first (results in less memory usage), remove objects from open list
-			QuadTreeNode* pCurrent = open.back();
-			open.pop_back();
-
-			// Get occupants
-			for(std::unordered_set<QuadTreeOccupant*>::iterator it = pCurrent->m_pOccupants.begin(); it != pCurrent->m_pOccupants.end(); it++)
-			{
-				// Assign new node
-				(*it)->m_pQuadTreeNode = this;
-
-				// Add to this node
-				occupants.insert(*it);
-			}
-
-			// If the node has children, add them to the open list
-			if(pCurrent->m_hasChildren)
-			{
-				for(int x = 0; x < 2; x++)
-					for(int y = 0; y < 2; y++)
-						open.push_back(&(*pCurrent->m_children)[x][y]);
-			}
+			if(pNode->m_children && pNode->m_numOccupantsBelow < minNumOccupants)
+				pMerge = pNode;
 		}
+
+		if(pMerge != NULL)
+			pMerge->Merge();
 	}
 
 	void QuadTreeNode::GetAllOccupantsBelow(std::vector<QuadTreeOccupant*> &occupants)
 	{
 		// Iteratively parse subnodes in order to collect all occupants below this node
-		std::list<QuadTreeNode*> open;
+		std::vector<QuadTreeNode*> open;
 
 		open.push_back(this);
 
@@ -194,48 +169,60 @@ namespace qdt
 			open.pop_back();
 
 			// Get occupants
-			for(std::unordered_set<QuadTreeOccupant*>::iterator it = pCurrent->m_pOccupants.begin(); it != pCurrent->m_pOccupants.end(); it++)
-				// Add to this node
-				occupants.push_back(*it);
+			occupants.insert(occupants.end(), pCurrent->m_pOccupants.begin(), pCurrent->m_pOccupants.end());
 
 			// If the node has children, add them to the open list
-			if(pCurrent->m_hasChildren)
+			if(pCurrent->m_children)
 			{
-				for(int x = 0; x < 2; x++)
-					for(int y = 0; y < 2; y++)
-						open.push_back(&(*pCurrent->m_children)[x][y]);
+				for(int i = 0; i < 4; i++)
+					open.push_back(&pCurrent->m_children[i]);
 			}
 		}
 	}
 
 	void QuadTreeNode::Update(QuadTreeOccupant* pOc)
 	{
-		// Remove, may be re-added to this node later
-		m_pOccupants.erase(pOc);
+		if(Contains(m_region, pOc->m_aabb))
+		{
+			// Still fits here, but may now fit into a child
+			if(m_children && Contains(GetPossibleChild(pOc)->m_region, pOc->m_aabb))
+			{
+				RemoveFromThisLevel(pOc);
+
+				GetPossibleChild(pOc)->Add(pOc);
+			}
+
+			return;
+		}
 
-		// Propogate upwards, looking for a node that has room (the current one may still have room)
+		RemoveFromThisLevel(pOc);
+
+		// Propogate upwards, looking for a node that can contain the occupant
 		QuadTreeNode* pNode = this;
 
-		while(pNode != NULL)
+		while(pNode != NULL && !Contains(pNode->m_region, pOc->m_aabb))
 		{
 			pNode->m_numOccupantsBelow--;
 
-			// If has room for 1 more, found a spot
-			if(pNode->m_region.Contains(pOc->m_aabb))
-				break;
-
 			pNode = pNode->m_pParent;
 		}
 
 		// If no node that could contain the occupant was found, add to outside root set
 		if(pNode == NULL)
 		{
-			m_pQuadTree->m_outsideRoot.insert(pOc);
+			m_pQuadTree->m_outsideRoot.push_back(pOc);
 
 			pOc->m_pQuadTreeNode = NULL;
 		}
-		else // Add to the selected node
+		else // Add to the selected node (which counted the occupant already)
+		{
+			pNode->m_numOccupantsBelow--;
+
 			pNode->Add(pOc);
+		}
+
+		// May destroy this node
+		MergeUpwards(pNode);
 	}
 
 	void QuadTreeNode::Remove(QuadTreeOccupant* pOc)
@@ -243,24 +230,14 @@ namespace qdt
 		assert(!m_pOccupants.empty());
 
 		// Remove from node
-		m_pOccupants.erase(pOc);
-
-		// Propogate upwards, merging if there are enough occupants in the node
-		QuadTreeNode* pNode = this;
+		RemoveFromThisLevel(pOc);
 
-		while(pNode != NULL)
-		{
+		// Propogate upwards
+		for(QuadTreeNode* pNode = this; pNode != NULL; pNode = pNode->m_pParent)
 			pNode->m_numOccupantsBelow--;
 
-			if(pNode->m_numOccupantsBelow >= minNumOccupants)
-			{
-				pNode->Merge();
-
-				break;
-			}
-
-			pNode = pNode->m_pParent;
-		}
+		// May destroy this node
+		MergeUpwards(NULL);
 	}
 
 	void QuadTreeNode::Add(QuadTreeOccupant* pOc)
@@ -268,7 +245,7 @@ namespace qdt
 		m_numOccupantsBelow++;
 
 		// See if the occupant fits into any children (if there are any)
-		if(m_hasChildren)
+		if(m_children)
 		{
 			if(AddToChildren(pOc))
 				return; // Fit, can stop
@@ -294,7 +271,7 @@ namespace qdt
 		return m_pQuadTree;
 	}
 
-	const AABB &QuadTreeNode::GetRegion()
+	const sf::FloatRect &QuadTreeNode::GetRegion()
 	{
 		return m_region;
 	}
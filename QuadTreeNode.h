@@ -1,49 +1,50 @@
 #ifndef QDT_QUADTREENODE_H
 #define QDT_QUADTREENODE_H
 
-#include <LTBL/Constructs/AABB.h>
-#include <LTBL/Constructs/Point2i.h>
-#include <LTBL/QuadTree/QuadTreeOccupant.h>
+#include "QuadTreeOccupant.h"
+
+#include <SFML\Graphics.hpp>
 
 #include <vector>
-#include <unordered_set>
 #include <memory>
 
 namespace qdt
 {
+	// True if inner lies entirely within outer
+	bool Contains(const sf::FloatRect &outer, const sf::FloatRect &inner);
+
 	class QuadTreeNode
 	{
 	private:
-		class QuadTreeNode* m_pParent;
-		class QuadTree* m_pQuadTree;
+		QuadTreeNode* m_pParent;
+		QuadTree* m_pQuadTree;
 
-		// Cannot use a unique_ptr, since the vector requires copy ctor/assignment ops
-		std::vector<std::vector<QuadTreeNode>>* m_children;
-		bool m_hasChildren;
+		// The four children, at [x * 2 + y], or NULL
+		std::unique_ptr<QuadTreeNode[]> m_children;
 
-		std::unordered_set<class QuadTreeOccupant*> m_pOccupants;
+		std::vector<QuadTreeOccupant*> m_pOccupants;
 
-		AABB m_region;
+		sf::FloatRect m_region;
 
 		int m_level;
 
 		int m_numOccupantsBelow;
 
-		inline QuadTreeNode* GetChild(const Point2i position);
-
-		void GetPossibleOccupantPosition(QuadTreeOccupant* pOc, Point2i &point);
+		QuadTreeNode* GetPossibleChild(const QuadTreeOccupant* pOc);
 
 		void AddToThisLevel(QuadTreeOccupant* pOc);
+		void RemoveFromThisLevel(QuadTreeOccupant* pOc);
 
 		// Returns true if occupant was added to children
 		bool AddToChildren(QuadTreeOccupant* pOc);
 
-		void GetOccupants(std::unordered_set<QuadTreeOccupant*> &occupants);
-
 		void Partition();
-		void DestroyChildren();
 		void Merge();
 
+		// Merges the highest node from this one up to (not including) pStop that
+		// has too few occupants below it
+		void MergeUpwards(QuadTreeNode* pStop);
+
 		void Update(QuadTreeOccupant* pOc);
 		void Remove(QuadTreeOccupant* pOc);
 
@@ -55,17 +56,16 @@ namespace qdt
 		static float m_oversizeMultiplier;
 
 		QuadTreeNode();
-		QuadTreeNode(const AABB &region, int level, QuadTreeNode* pParent = NULL, QuadTree* pQuadTree = NULL);
-		~QuadTreeNode();
+		QuadTreeNode(const sf::FloatRect &region, int level, QuadTreeNode* pParent = NULL, QuadTree* pQuadTree = NULL);
 
 		// For use after using default constructor
-		void Create(const AABB &region, int level, QuadTreeNode* pParent = NULL, QuadTree* pQuadTree = NULL);
+		void Create(const sf::FloatRect &region, int level, QuadTreeNode* pParent = NULL, QuadTree* pQuadTree = NULL);
 
 		QuadTree* GetTree();
 
 		void Add(QuadTreeOccupant* pOc);
 
-		const AABB &GetRegion();
+		const sf::FloatRect &GetRegion();
 
 		void GetAllOccupantsBelow(std::vector<QuadTreeOccupant*> &occupants);
 
@@ -74,4 +74,4 @@ namespace qdt
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
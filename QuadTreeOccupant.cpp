@@ -1,20 +1,23 @@
-#include <LTBL/QuadTree/QuadTreeOccupant.h>
+#include "QuadTreeOccupant.h"
 
-#include <LTBL/QuadTree/QuadTreeNode.h>
-#include <LTBL/QuadTree/QuadTree.h>
-
-#include <LTBL/Constructs/Vec2f.h>
+#include "QuadTreeNode.h"
+#include "QuadTree.h"
 
 #include <assert.h>
 
 namespace qdt
 {
 	QuadTreeOccupant::QuadTreeOccupant()
-		: m_aabb(Vec2f(0.0f, 0.0f), Vec2f(1.0f, 1.0f)),
-		m_pQuadTreeNode(NULL), m_pQuadTree(NULL)
+		: m_pQuadTreeNode(NULL), m_pQuadTree(NULL), m_addOrder(0),
+		m_aabb(0.0f, 0.0f, 1.0f, 1.0f)
 	{
 	}
 
+	QuadTreeOccupant::~QuadTreeOccupant()
+	{
+		RemoveFromTree();
+	}
+
 	void QuadTreeOccupant::TreeUpdate()
 	{
 		if(m_pQuadTree == NULL)
@@ -25,10 +28,10 @@ namespace qdt
 			// If fits in the root now, add it
 			QuadTreeNode* pRootNode = m_pQuadTree->m_pRootNode.get();
 
-			if(pRootNode->m_region.Contains(m_aabb))
+			if(pRootNode != NULL && Contains(pRootNode->m_region, m_aabb))
 			{
 				// Remove from outside root and add to tree
-				m_pQuadTree->m_outsideRoot.erase(this);
+				m_pQuadTree->RemoveOutsideRoot(this);
 
 				pRootNode->Add(this);
 			}
@@ -39,21 +42,35 @@ namespace qdt
 
 	void QuadTreeOccupant::RemoveFromTree()
 	{
+		if(m_pQuadTree == NULL)
+			return;
+
 		if(m_pQuadTreeNode == NULL)
 		{
 			// Not in a node, should be outside root then
-			assert(m_pQuadTree != NULL);
-
-			m_pQuadTree->m_outsideRoot.erase(this);
-
-			m_pQuadTree->OnRemoval();
+			m_pQuadTree->RemoveOutsideRoot(this);
 		}
 		else
 			m_pQuadTreeNode->Remove(this);
+
+		m_pQuadTree->OnRemoval();
+
+		m_pQuadTreeNode = NULL;
+		m_pQuadTree = NULL;
 	}
 
-	const AABB &QuadTreeOccupant::GetAABB()
+	const sf::FloatRect &QuadTreeOccupant::GetAABB() const
 	{
 		return m_aabb;
 	}
-}
\ No newline at end of file
+
+	QuadTree* QuadTreeOccupant::GetTree() const
+	{
+		return m_pQuadTree;
+	}
+
+	unsigned int QuadTreeOccupant::GetAddOrder() const
+	{
+		return m_addOrder;
+	}
+}
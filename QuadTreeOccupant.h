@@ -1,31 +1,44 @@
 #ifndef QDT_QUADTREEOCCUPANT_H
 #define QDT_QUADTREEOCCUPANT_H
 
-#include <LTBL/QuadTree/QuadTreeNode.h>
-#include <LTBL/Constructs/AABB.h>
+#include <SFML\Graphics.hpp>
 
 namespace qdt
 {
+	class QuadTreeNode;
+	class QuadTree;
+
+	// Something with bounds, to be found by region in a QuadTree. Set m_aabb,
+	// and call TreeUpdate() whenever it changes; leaves its tree when destroyed
 	class QuadTreeOccupant
 	{
 	private:
-		class QuadTreeNode* m_pQuadTreeNode;
-		class QuadTree* m_pQuadTree;
+		QuadTreeNode* m_pQuadTreeNode;
+		QuadTree* m_pQuadTree;
+
+		unsigned int m_addOrder;
 
 	protected:
-		AABB m_aabb;
+		sf::FloatRect m_aabb;
 
 	public:
 		QuadTreeOccupant();
+		virtual ~QuadTreeOccupant();
 
 		void TreeUpdate();
 		void RemoveFromTree();
 
-		const AABB &GetAABB();
+		const sf::FloatRect &GetAABB() const;
+
+		// The tree it's in, or NULL
+		QuadTree* GetTree() const;
+
+		// Order in which the occupants were added to their tree, to sort query results
+		unsigned int GetAddOrder() const;
 
 		friend class QuadTreeNode;
 		friend class QuadTree;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,205 @@
+#include "Replay.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cassert>
+
+namespace
+{
+	// File layout: header, then the actions of every tick, then the checksums
+	const char			Magic[4]	= { 'W', 'L', 'R', 'P' };
+	const unsigned int	Version		= 1;
+
+	template <typename T>
+	void write(std::ofstream& file, T value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool read(std::ifstream& file, T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+
+	// Bytes left between the read position and the end of the file
+	std::streamoff remainingBytes(std::ifstream& file)
+	{
+		std::streampos position = file.tellg();
+		file.seekg(0, std::ios::end);
+		std::streamoff remaining = file.tellg() - position;
+		file.seekg(position);
+
+		return remaining;
+	}
+}
+
+Replay::Replay()
+: mRecording(false)
+, mState(States::None)
+, mSeed(0)
+, mTimePerTick(sf::seconds(1.f/60.f))
+, mChecksumInterval(DefaultChecksumInterval)
+, mActions()
+, mChecksums()
+{
+}
+
+void Replay::startRecording(sf::Time timePerTick, unsigned int checksumInterval)
+{
+	assert(checksumInterval > 0);
+
+	mRecording = true;
+	mTimePerTick = timePerTick;
+	mChecksumInterval = checksumInterval;
+}
+
+bool Replay::isRecording() const
+{
+	return mRecording;
+}
+
+void Replay::beginSession(States::ID state)
+{
+	mState = state;
+	mActions.clear();
+	mChecksums.clear();
+
+	// Restart the random sequence, so that playback can reproduce it
+	mSeed = getRandomSeed();
+	setRandomSeed(mSeed);
+}
+
+void Replay::recordActions(unsigned int actions)
+{
+	mActions.push_back(actions);
+}
+
+bool Replay::needsChecksum() const
+{
+	return !mActions.empty() && mActions.size() % mChecksumInterval == 0;
+}
+
+void Replay::recordChecksum(unsigned int checksum)
+{
+	mChecksums.push_back(checksum);
+}
+
+States::ID Replay::getState() const
+{
+	return mState;
+}
+
+unsigned long Replay::getSeed() const
+{
+	return mSeed;
+}
+
+sf::Time Replay::getTimePerTick() const
+{
+	return mTimePerTick;
+}
+
+unsigned int Replay::getChecksumInterval() const
+{
+	return mChecksumInterval;
+}
+
+std::size_t Replay::getTickCount() const
+{
+	return mActions.size();
+}
+
+unsigned int Replay::getActions(std::size_t tick) const
+{
+	return mActions[tick];
+}
+
+std::size_t Replay::getChecksumCount() const
+{
+	return mChecksums.size();
+}
+
+unsigned int Replay::getChecksum(std::size_t index) const
+{
+	return mChecksums[index];
+}
+
+bool Replay::loadFromFile(const std::string& filename)
+{
+	std::ifstream file(filename, std::ios::binary);
+	if (!file)
+		return false;
+
+	char magic[4];
+	unsigned int version, state, interval, tickCount, checksumCount;
+	unsigned long long seed;
+	long long microseconds;
+
+	if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, Magic))
+		return false;
+
+	if (!read(file, version) || version != Version)
+		return false;
+
+	if (!read(file, state) || !read(file, seed) || !read(file, microseconds) || !read(file, interval) || interval == 0)
+		return false;
+
+	// The counts come from the file: check them against its size before
+	// allocating, so that a truncated or corrupt file is rejected
+	if (!read(file, tickCount))
+		return false;
+
+	if (static_cast<unsigned long long>(tickCount) * sizeof(unsigned int) + sizeof(checksumCount) > static_cast<unsigned long long>(remainingBytes(file)))
+		return false;
+
+	std::vector<unsigned int> actions(tickCount);
+	for (unsigned int i = 0; i < tickCount; ++i)
+		if (!read(file, actions[i]))
+			return false;
+
+	if (!read(file, checksumCount) || checksumCount > tickCount / interval)
+		return false;
+
+	if (static_cast<unsigned long long>(checksumCount) * sizeof(unsigned int) != static_cast<unsigned long long>(remainingBytes(file)))
+		return false;
+
+	std::vector<unsigned int> checksums(checksumCount);
+	for (unsigned int i = 0; i < checksumCount; ++i)
+		if (!read(file, checksums[i]))
+			return false;
+
+	mState = static_cast<States::ID>(state);
+	mSeed = static_cast<unsigned long>(seed);
+	mTimePerTick = sf::microseconds(microseconds);
+	mChecksumInterval = interval;
+	mActions.swap(actions);
+	mChecksums.swap(checksums);
+
+	return true;
+}
+
+bool Replay::saveToFile(const std::string& filename) const
+{
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+		return false;
+
+	file.write(Magic, sizeof(Magic));
+	write(file, Version);
+	write(file, static_cast<unsigned int>(mState));
+	write(file, static_cast<unsigned long long>(mSeed));
+	write(file, static_cast<long long>(mTimePerTick.asMicroseconds()));
+	write(file, mChecksumInterval);
+
+	write(file, static_cast<unsigned int>(mActions.size()));
+	for (std::size_t i = 0; i < mActions.size(); ++i)
+		write(file, mActions[i]);
+
+	write(file, static_cast<unsigned int>(mChecksums.size()));
+	for (std::size_t i = 0; i < mChecksums.size(); ++i)
+		write(file, mChecksums[i]);
+
+	return static_cast<bool>(file);
+}
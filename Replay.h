@@ -0,0 +1,63 @@
+#ifndef _Replay_h_
+#define _Replay_h_
+
+#include "StateIdentifiers.h"
+
+#include <SFML\System.hpp>
+
+#include <string>
+#include <vector>
+
+// Input of a play session, tick by tick, to be played back deterministically.
+//
+// A session records the realtime actions (see Player::getRealtimeActions())
+// triggered in each fixed tick of a game state, the seed of the random number
+// generator, and a checksum of the world every few ticks; played back with
+// the same seed and input, the world must go through the same states.
+class Replay
+{
+public:
+	static const unsigned int	DefaultChecksumInterval = 60;
+
+public:
+							Replay();
+
+	// Recording
+	void					startRecording(sf::Time timePerTick, unsigned int checksumInterval = DefaultChecksumInterval);
+	bool					isRecording() const;
+
+	// Called by the recorded state when it's created; restarts the session
+	// and the random number generator
+	void					beginSession(States::ID state);
+	void					recordActions(unsigned int actions);
+	bool					needsChecksum() const;
+	void					recordChecksum(unsigned int checksum);
+
+	// Playback
+	States::ID				getState() const;
+	unsigned long			getSeed() const;
+	sf::Time				getTimePerTick() const;
+	unsigned int			getChecksumInterval() const;
+
+	std::size_t				getTickCount() const;
+	unsigned int			getActions(std::size_t tick) const;
+
+	// Checksum n is taken after tick (n + 1) * interval - 1
+	std::size_t				getChecksumCount() const;
+	unsigned int			getChecksum(std::size_t index) const;
+
+	bool					loadFromFile(const std::string& filename);
+	bool					saveToFile(const std::string& filename) const;
+
+private:
+	bool					mRecording;
+	States::ID				mState;
+	unsigned long			mSeed;
+	sf::Time				mTimePerTick;
+	unsigned int			mChecksumInterval;
+
+	std::vector<unsigned int>	mActions;
+	std::vector<unsigned int>	mChecksums;
+};
+
+#endif
@@ -0,0 +1,112 @@
+#include "ReplayRunner.h"
+#include "World.h"
+#include "Environment.h"
+#include "Player.h"
+#include "PlayerPlatformer.h"
+#include "Utility.h"
+
+#include <stdexcept>
+
+namespace
+{
+	// Same size as the application's window: The view decides what spawns
+	// and what gets destroyed
+	const sf::Vector2f ViewSize(800.f, 600.f);
+}
+
+ReplayRunner::Result::Result()
+: ticks(0)
+, checksums(0)
+, deterministic(true)
+, firstMismatch(0)
+, elapsed()
+{
+}
+
+ReplayRunner::ReplayRunner()
+: mTarget()
+, mTextureManager()
+, mFontManager()
+{
+}
+
+ReplayRunner::Result ReplayRunner::run(const Replay& replay)
+{
+	Result result;
+	sf::Clock clock;
+
+	// Create the state's simulation, then restart the random sequence where
+	// the recorded session did (see Replay::beginSession())
+	switch (replay.getState())
+	{
+		case States::Game:
+		{
+			// Without fonts, even after a Test replay loaded some: texts
+			// would create glyph textures
+			FontManager noFonts;
+			World world(ViewSize, noFonts);
+			Player player;
+			setRandomSeed(replay.getSeed());
+			playBack(world, player, replay, result);
+			break;
+		}
+
+		case States::Test:
+		{
+			loadRenderResources();
+			Environment environment(*mTarget, mTextureManager, mFontManager);
+			PlayerPlatformer player;
+			setRandomSeed(replay.getSeed());
+			playBack(environment, player, replay, result);
+			break;
+		}
+
+		default:
+			throw std::runtime_error("ReplayRunner::run - No simulation for the replay's state");
+	}
+
+	result.elapsed = clock.getElapsedTime();
+	return result;
+}
+
+void ReplayRunner::loadRenderResources()
+{
+	if (mTarget)
+		return;
+
+	std::unique_ptr<sf::RenderTexture> target(new sf::RenderTexture());
+	if (!target->create(static_cast<unsigned int>(ViewSize.x), static_cast<unsigned int>(ViewSize.y)))
+		throw std::runtime_error("ReplayRunner::loadRenderResources - Failed to create the render target");
+
+	mFontManager.load(Fonts::Main, 			"../resources/Sansation.ttf");
+	mTextureManager.load(Textures::Player,	"../resources/Textures/Player.png");
+	mTarget = std::move(target);
+}
+
+template <typename Simulation, typename Input>
+void ReplayRunner::playBack(Simulation& simulation, Input& input, const Replay& replay, Result& result)
+{
+	const sf::Time dt = replay.getTimePerTick();
+	const std::size_t interval = replay.getChecksumInterval();
+
+	// Same order as the states' update(): simulate, then queue the input
+	for (std::size_t tick = 0; tick < replay.getTickCount(); ++tick)
+	{
+		simulation.update(dt);
+		input.triggerActions(replay.getActions(tick), simulation.getCommandQueue());
+
+		std::size_t index = (tick + 1) / interval - 1;
+		if ((tick + 1) % interval == 0 && index < replay.getChecksumCount())
+		{
+			if (simulation.getChecksum() != replay.getChecksum(index) && result.deterministic)
+			{
+				result.deterministic = false;
+				result.firstMismatch = tick;
+			}
+
+			++result.checksums;
+		}
+
+		++result.ticks;
+	}
+}
@@ -0,0 +1,52 @@
+#ifndef _ReplayRunner_h_
+#define _ReplayRunner_h_
+
+#include "ResourceManager.h"
+#include "ResourceIdentifiers.h"
+#include "Replay.h"
+
+#include <SFML\Graphics.hpp>
+#include <memory>
+
+// Plays a Replay back without a window: The recorded state's simulation
+// (World for States::Game, Environment for States::Test) is fed the recorded
+// actions tick by tick, as fast as possible, and nothing is rendered. The
+// world's checksums are compared against the recorded ones as it goes.
+//
+// Game replays run headless (no render target, textures or fonts, hence no
+// GL context). Environment still needs render resources for its map and
+// animations: they're only created for the first Test replay.
+class ReplayRunner : private sf::NonCopyable
+{
+public:
+	struct Result
+	{
+		Result();
+
+		std::size_t			ticks;
+		std::size_t			checksums;
+		bool				deterministic;
+		std::size_t			firstMismatch;	// Tick of the first wrong checksum
+		sf::Time			elapsed;
+	};
+
+public:
+							ReplayRunner();
+
+	// Throws std::runtime_error if the replay's state can't be played back
+	Result					run(const Replay& replay);
+
+private:
+	template <typename Simulation, typename Input>
+	void					playBack(Simulation& simulation, Input& input, const Replay& replay, Result& result);
+
+	void					loadRenderResources();
+
+private:
+	// Stands in for the window (same size, never displayed), for Environment
+	std::unique_ptr<sf::RenderTexture>	mTarget;
+	TextureManager			mTextureManager;
+	FontManager				mFontManager;
+};
+
+#endif
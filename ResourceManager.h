@@ -26,6 +26,10 @@ public:
 	Resource&		get(Identifier id);
 	const Resource&	get(Identifier id) const;
 
+	// nullptr if the resource isn't loaded
+	Resource*		find(Identifier id);
+	const Resource*	find(Identifier id) const;
+
 private:
 	void			insertResource(Identifier id, std::unique_ptr<Resource> resource);
 };
@@ -42,6 +42,20 @@ const Resource& ResourceManager<Resource, Identifier>::get(Identifier id) const
 	return *found->second;
 }
 
+template<typename Resource, typename Identifier>
+Resource* ResourceManager<Resource, Identifier>::find(Identifier id)
+{
+	auto found = mResourceMap.find(id);
+	return (found != mResourceMap.end()) ? found->second.get() : nullptr;
+}
+
+template<typename Resource, typename Identifier>
+const Resource* ResourceManager<Resource, Identifier>::find(Identifier id) const
+{
+	auto found = mResourceMap.find(id);
+	return (found != mResourceMap.end()) ? found->second.get() : nullptr;
+}
+
 template <typename Resource, typename Identifier>
 void ResourceManager<Resource, Identifier>::insertResource(Identifier id, std::unique_ptr<Resource> resource) 
 {
@@ -1,36 +1,14 @@
 #include "Room.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <cmath>
 
-// 
-// Block coordinates:
-// 
-#define BLOCK_N_X  (blockSize/2)
-#define BLOCK_N_Y  0
-
-#define BLOCK_NE_X (blockSize)
-#define BLOCK_NE_Y 0
-
-#define BLOCK_E_X  (blockSize)
-#define BLOCK_E_Y  (blockSize/2)
-
-#define BLOCK_SE_X (blockSize)
-#define BLOCK_SE_Y (blockSize)
-
-#define BLOCK_S_X  (blockSize/2)
-#define BLOCK_S_Y  (blockSize)
-
-#define BLOCK_SW_X 0
-#define BLOCK_SW_Y (blockSize)
-
-#define BLOCK_W_X  0
-#define BLOCK_W_Y  (blockSize/2)
-
-#define BLOCK_NW_X 0
-#define BLOCK_NW_Y 0
-
-#define BLOCK_CENTER_X (blockSize/2)
-#define BLOCK_CENTER_Y (blockSize/2)
+// Batched queries classify four points at a time when SSE2 is available:
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ROOM_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -95,11 +73,145 @@ static inline float degreeAngle ( float x, float y ) {
 
 
 
+// Given the normal of a surface, tells which kind of surface it is:
+static inline Room::SlopeClass slopeClass ( const Vector2D & normal ) {
+	static const float margin = 0.1f;
+	
+	float nx = fabsf( normal.x );
+	float ny = fabsf( normal.y );
+	
+	if ( nx < margin )
+		return Room::SLOPE_FLAT;
+	
+	if ( ny < margin )
+		return Room::SLOPE_WALL;
+	
+	// Slope: Compare the normal's inclination against the known slopes.
+	float ratio = nx / ny;
+	
+	if ( fabsf( ratio - 0.5f ) < margin )
+		return Room::SLOPE_26;
+	
+	if ( fabsf( ratio - 1.0f ) < margin )
+		return Room::SLOPE_45;
+	
+	return Room::SLOPE_OTHER;
+} // End of function: slopeClass
+
+
+
+
+// Scratch space for queries that aren't given one; each thread gets its own,
+// so concurrent queries never share it:
+static Room::Scratch & threadScratch () {
+	static thread_local Room::Scratch scratch;
+	
+	return scratch;
+} // End of function: threadScratch
+
+
+
+// Tells whether all blocks touched by the rectangle from (x1, y1) to
+// (x2, y2) are empty, using the obstacle layer's occupancy bitmap. The
+// rectangle is grown by one pixel, since the intersection tests tolerate
+// segments that stop just short of a block's edge, and the range of blocks
+// covers both the rounding down of the block walks and the truncation of
+// the static point test.
+static inline bool regionEmpty ( const Room & room, float x1, float y1, float x2, float y2 ) {
+	float size = (float) room.blockSize;
+	
+	return room.obstacleLayer.isEmpty(
+		(int) floorf( (std::min( y1, y2 ) - 1.0f) / size ), (int) floorf( (std::min( x1, x2 ) - 1.0f) / size ),
+		(int) ((std::max( y1, y2 ) + 1.0f) / size),         (int) ((std::max( x1, x2 ) + 1.0f) / size) );
+} // End of function: regionEmpty
+
+
+
+// The table of pixel column px in block (i, j); outside of the matrix, the
+// empty border's:
+static inline const RoomBlockGeometry::Column & columnAt ( const Room & room, int i, int j, int px ) {
+	return room.blockGeometry.column(
+		room.obstacleLayer.at( room.obstacleLayer.clampRow(i), room.obstacleLayer.clampColumn(j) ), px );
+} // End of function: columnAt
+
+
+
+// Visits the horizontal span from x1 to x2 at the sides of every pixel column
+// it covers or touches, clipped to the span's ends. visit( j, px, f ) is given
+// the block column, the pixel column inside of the block, and the position
+// inside of the pixel column (0 to 1).
+template <class Visitor>
+static inline void visitSpan ( const Room & room, float x1, float x2, Visitor visit ) {
+	if ( x1 > x2 )
+		std::swap( x1, x2 );
+	
+	int first = (int) ceilf( x1 ) - 1;
+	int last  = (int) floorf( x2 );
+	
+	// Like the point test, a span starting right on a block's left side
+	// doesn't reach into the block before:
+	if ( (float) (first + 1) == x1 && (first + 1) % room.blockSize == 0 )
+		first++;
+	
+	for ( int p = first; p <= last; p++ ) {
+		// Round down, for negative columns as well:
+		int j  = (p >= 0 ? p / room.blockSize : -((room.blockSize - 1 - p) / room.blockSize));
+		int px = p - j * room.blockSize;
+		
+		visit( j, px, std::max( x1 - p, 0.0f ) );
+		visit( j, px, std::min( x2 - p, 1.0f ) );
+	}
+} // End of function: visitSpan
+
+
+
+
+#ifdef ROOM_USE_SSE2
+// Vectorized static point test: Tests four points at once against the
+// room's obstacle layer, and returns a 4-bit mask with one bit set for each
+// colliding point.
+static inline int pointCollision4 ( const Room & room, __m128 x, __m128 y ) {
+	__m128 size = _mm_set1_ps( (float) room.blockSize );
+	
+	// Find the obstacle blocks, truncating just like the scalar version:
+	__m128i i = _mm_cvttps_epi32( _mm_div_ps( y, size ) );
+	__m128i j = _mm_cvttps_epi32( _mm_div_ps( x, size ) );
+	
+	// Transform the coordinates so they're relative to the blocks' top-left
+	// corners:
+	x = _mm_sub_ps( x, _mm_mul_ps( _mm_cvtepi32_ps( j ), size ) );
+	y = _mm_sub_ps( y, _mm_mul_ps( _mm_cvtepi32_ps( i ), size ) );
+	
+	// Fetch the shapes (points outside of the matrix land on the empty
+	// border, so they don't collide):
+	int is[4], js[4];
+	_mm_storeu_si128( (__m128i *) is, i );
+	_mm_storeu_si128( (__m128i *) js, j );
+	
+	const RoomBlockGeometry::Shape * shapes[4];
+	for ( int k = 0; k < 4; k++ ) {
+		const ObstacleGrid & grid = room.obstacleLayer;
+		shapes[k] = &room.blockGeometry.shape( grid.at( grid.clampRow( is[k] ), grid.clampColumn( js[k] ) ) );
+	}
+	
+	// Test all four half-planes of the four shapes:
+	__m128 inside[4];
+	for ( int p = 0; p < 4; p++ ) {
+		__m128 a = _mm_setr_ps( shapes[0]->planes[p].a, shapes[1]->planes[p].a, shapes[2]->planes[p].a, shapes[3]->planes[p].a );
+		__m128 b = _mm_setr_ps( shapes[0]->planes[p].b, shapes[1]->planes[p].b, shapes[2]->planes[p].b, shapes[3]->planes[p].b );
+		__m128 c = _mm_setr_ps( shapes[0]->planes[p].c, shapes[1]->planes[p].c, shapes[2]->planes[p].c, shapes[3]->planes[p].c );
+		
+		// b * y > a * x + c
+		inside[p] = _mm_cmpgt_ps( _mm_mul_ps( b, y ), _mm_add_ps( _mm_mul_ps( a, x ), c ) );
+	}
+	
+	__m128 result = _mm_or_ps( _mm_and_ps( inside[0], inside[1] ),
+	                           _mm_and_ps( inside[2], inside[3] ) );
+	
+	return _mm_movemask_ps( result );
+} // End of function: pointCollision4
+#endif
 
-// Compares numbers with an error margin:
-inline static bool marginCmp ( float val1, float val2, float error ) {
-	return ( abs(val1 - val2) <= abs(error) );
-}
 
 
 
@@ -116,6 +228,7 @@ Room::Room ( int _blockSize, int _roomWidth, int _roomHeight, int _waterLevel, i
 	  roomWidth(_roomWidth),
 	  roomHeight(_roomHeight),
 	  obstacleLayer(_roomHeight, _roomWidth),
+	  blockGeometry(_blockSize),
 	  waterLevel( _waterLevel ),
 	  defaultObjLayer( _defaultObjLayer )
 {
@@ -143,138 +256,26 @@ Room::~Room () {
 
 
 
+void Room::buildEdgeMesh () {
+	edgeMesh.build( obstacleLayer, blockGeometry, blockSize );
+} // End of method: Room::buildEdgeMesh
 
-bool Room::pointCollision ( float x, float y ) {
+
+
+
+bool Room::pointCollision ( float x, float y ) const {
 	// Find the obstacle block at (x, y):
 	int i = (int) (y / blockSize);
 	int j = (int) (x / blockSize);
 	
-	// Outside of matrix?
-	if ( i < 0 || i >= obstacleLayer.rows ||
-	     j < 0 || j >= obstacleLayer.columns ) {
-		// Not colliding!
-		return false;
-	}
-	else {
-		// Transform the (x, y) coordinates so they're relative to the block's
-		// top-left corner:
-		x -= j * blockSize;
-		y -= i * blockSize;
-		
-		// Get the obstacle block, and test it:
-		switch ( obstacleLayer.cell(i, j) ) {
-			case RoomBlock::BLK_SE_BLOCK:
-				return (x > BLOCK_CENTER_X && y > BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_W_E_BOTTOM:
-				return (y > BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_SW_BLOCK:
-				return (x < BLOCK_CENTER_X && y > BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_NW_MISSING:
-				return !(x <= BLOCK_CENTER_X && y <= BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_NE_MISSING:
-				return !(x >= BLOCK_CENTER_X && y <= BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_SW_NE_BOTTOM:
-				return (y > (-x + blockSize));
-				
-			case RoomBlock::BLK_NW_SE_BOTTOM:
-				return (y > x);
-				
-			case RoomBlock::BLK_SW_E_BOTTOM:
-				return (y > (-x/2 + blockSize));
-				
-			case RoomBlock::BLK_W_NE_BOTTOM:
-				return (y > (-x/2 + (float) blockSize/2));
-				
-			case RoomBlock::BLK_NW_E_BOTTOM:
-				return (y > (x/2));
-				
-			case RoomBlock::BLK_W_SE_BOTTOM:
-				return (y > (x/2 + (float) blockSize/2));
-				
-			case RoomBlock::BLK_N_S_RIGHT:
-				return (x > BLOCK_CENTER_X);
-				
-			case RoomBlock::BLK_FULL:
-				return true;
-				
-			case RoomBlock::BLK_N_S_LEFT:
-				return (x < BLOCK_CENTER_X);
-				
-			case RoomBlock::BLK_SW_MISSING:
-				return !(x <= BLOCK_CENTER_X && y >= BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_SE_MISSING:
-				return !(x >= BLOCK_CENTER_X && y >= BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_NW_SE_TOP:
-				return (y < x);
-				
-			case RoomBlock::BLK_SW_NE_TOP:
-				return (y < -x + blockSize);
-				
-			case RoomBlock::BLK_NW_E_TOP:
-				return (y < x/2);
-				
-			case RoomBlock::BLK_W_SE_TOP:
-				return (y < (x/2 + (float) blockSize/2));
-				
-			case RoomBlock::BLK_SW_E_TOP:
-				return (y < (-x/2 + blockSize));
-				
-			case RoomBlock::BLK_W_NE_TOP:
-				return (y < (-x/2 + (float) blockSize/2));
-				
-			case RoomBlock::BLK_NE_BLOCK:
-				return (x > BLOCK_CENTER_X && y < BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_W_E_TOP:
-				return (y < BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_NW_BLOCK:
-				return (x < BLOCK_CENTER_X && y < BLOCK_CENTER_Y);
-				
-			case RoomBlock::BLK_S_E_BOTTOM:
-				return (y > -x + 3.0f * blockSize / 2.0f);
-				
-			case RoomBlock::BLK_W_N_BOTTOM:
-				return (y > -x + (float) blockSize / 2);
-				
-			case RoomBlock::BLK_N_E_BOTTOM:
-				return (y > x - (float) blockSize / 2);
-				
-			case RoomBlock::BLK_W_S_BOTTOM:
-				return (y > x + (float) blockSize / 2);
-				
-			case RoomBlock::BLK_N_E_TOP:
-				return (y < x - (float) blockSize / 2);
-				
-			case RoomBlock::BLK_W_S_TOP:
-				return (y < x + (float) blockSize / 2);
-				
-			case RoomBlock::BLK_S_E_TOP:
-				return (y < -x + 3.0f * blockSize / 2.0f);
-				
-			case RoomBlock::BLK_W_N_TOP:
-				return (y < -x + (float) blockSize / 2.0f);
-				
-			case RoomBlock::BLK_THINFLOOR_HI:
-				return false;
-				
-			case RoomBlock::BLK_THINFLOOR_MID:
-				return false;
-				
-			case RoomBlock::BLK_THINFLOOR_LO:
-				return false;
-				
-			default:
-				return false;
-		}
-	}
+	// Transform the (x, y) coordinates so they're relative to the block's
+	// top-left corner:
+	x -= j * blockSize;
+	y -= i * blockSize;
+	
+	// Get the obstacle block, and test it (outside of the matrix, the empty
+	// border is found, so there's no collision):
+	return blockGeometry.shape( obstacleLayer.at( obstacleLayer.clampRow(i), obstacleLayer.clampColumn(j) ) ).contains( x, y );
 } // End of method: Room::pointCollision (static point)
 
 
@@ -283,8 +284,12 @@ bool Room::pointCollision ( float x, float y ) {
 
 
 bool Room::pointCollision ( float x1, float y1, float x2, float y2, bool touchThinFloor,
-                            Vector2D * contact, Vector2D * normal ) {
+                            Vector2D * contact, Vector2D * normal ) const {
 
+	// Nothing but empty space in the way?
+	if ( regionEmpty( *this, x1, y1, x2, y2 ) )
+		return false;
+	
 	// Maybe, point1 is already colliding...
 	if ( pointCollision( x1, y1 ) ) {
 		// Set it as the contact point:
@@ -307,8 +312,12 @@ bool Room::pointCollision ( float x1, float y1, float x2, float y2, bool touchTh
 	if ( x1 == x2 && y1 == y2 )
 		return false;
 	
-	// The movement's angle relative to the X axis, in degrees:
-	float angle = degreeAngle( x2 - x1, y2 - y1 );
+	// The movement's direction; tiny components are ignored, so that almost
+	// vertical (or horizontal) movements won't touch the edges parallel to
+	// them:
+	Vector2D direction( x2 - x1, y2 - y1 );
+	if ( fabsf(direction.x) < EPSILON ) direction.x = 0;
+	if ( fabsf(direction.y) < EPSILON ) direction.y = 0;
 	
 	bool leftToRight = (x1 < x2);
 	bool rightToLeft = (x1 > x2);
@@ -328,6549 +337,406 @@ bool Room::pointCollision ( float x1, float y1, float x2, float y2, bool touchTh
 		float blkX = (float) j * blockSize;
 		float blkY = (float) i * blockSize;
 		
-		// Index inside of matrix?
-		if ( i >= 0 && i < obstacleLayer.rows &&
-		     j >= 0 && j < obstacleLayer.columns ) {
-			// Extend a line from point1 to point2, and test for intersection
-			// against the obstacle layer:
-			switch ( obstacleLayer.cell(i, j) ) {
-				case RoomBlock::BLK_SE_BLOCK:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-					                   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-					                   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-				case RoomBlock::BLK_W_E_BOTTOM:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-				case RoomBlock::BLK_SW_BLOCK:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-					                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
+		// Extend a line from point1 to point2, and test for intersection
+		// against the block's edges (outside of the matrix, the empty border
+		// is found, which has no edges):
+		const RoomBlockGeometry::Shape & shape =
+			blockGeometry.shape( obstacleLayer.at( obstacleLayer.clampRow(i), obstacleLayer.clampColumn(j) ) );
+		
+		const RoomBlockGeometry::Edge * closest = NULL;
+		Vector2D closestContact;
+		float    closestDist = 0;
+		
+		for ( int e = 0; e < shape.edgeCount; e++ ) {
+			const RoomBlockGeometry::Edge & edge = shape.edges[e];
+			
+			// Only edges facing the movement may be crossed, and thin
+			// floors may be ignored altogether:
+			if ( direction * edge.normal >= 0 || (edge.thinFloor && !touchThinFloor) )
+				continue;
+			
+			Vector2D tmpContact;
+			if ( Geom::segmentIntersection( x1, y1,
+			                   x2, y2,
+			                   blkX + edge.p1.x, blkY + edge.p1.y,
+			                   blkX + edge.p2.x, blkY + edge.p2.y,
+			                   &tmpContact ) ) {
+				// A convex block can only be entered through one edge:
+				if ( shape.convex ) {
+					closest        = &edge;
+					closestContact = tmpContact;
 					break;
-					
-				case RoomBlock::BLK_NW_MISSING: {
-					// This is a lot more complicated, since it's a non-convex
-					// polygon.
-					
-					// Store all the intersections and their normals in a list:
-					static Container<Vector2D> contacts;
-					static Container<Vector2D> normals;
-					
-					contacts.removeAll();
-					normals.removeAll();
-					
-					static Vector2D tmpContact;
-					
-					// Top segments:
-					if ( angle > 180 && angle < 360 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-						
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-					}
-					
-					// Left segments:
-					if ( (angle >= 0 && angle < 90) || (angle > 270 && angle < 360) ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_CENTER_X,  blkY + BLOCK_CENTER_Y,
-						                   blkX + BLOCK_N_X,       blkY + BLOCK_N_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-					}
-					// Bottom segment:
-					if ( angle > 0 && angle < 180 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-					}
-					// Right segment:
-					if ( angle > 90 && angle < 270 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-					}
-					
-					
-					// Have we found *any* contacts?
-					if ( contacts.getCount() > 0 ) {
-						
-						// Find the closest contact point to point1:
-						Vector2D p1 = Vector2D( x1, y1 );
-						
-						int   index = 0;
-						float dist  = (contacts[0] - p1).length();
-						
-						int pInx;
-						for ( pInx = 1; pInx < contacts.getCount(); pInx++ ) {
-							float newDist = (contacts[pInx] - p1).length();
-							
-							if ( newDist < dist ) {
-								index = pInx;
-								dist  = newDist;
-							}
-						}
-						
-						// Return the parameters:
-						if ( contact )
-							*contact = contacts[index];
-						if ( normal )
-							*normal = normals[index];
-						
-						return true;
-					}
-					// No collision:
-					else
-						break;
 				}
 				
-					
-				case RoomBlock::BLK_NE_MISSING: {
-					// This is a lot more complicated, since it's a non-convex
-					// polygon.
-					
-					// Store all the intersections and their normals in a list:
-					static Container<Vector2D> contacts;
-					static Container<Vector2D> normals;
-					
-					contacts.removeAll();
-					normals.removeAll();
-					
-					static Vector2D tmpContact;
-					
-					// Top segments:
-					if ( angle > 180 && angle < 360 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-						
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-					}
-					
-					// Left segment:
-					if ( (angle >= 0 && angle < 90) || (angle > 270 && angle < 360) ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-					}
-					// Bottom segment:
-					if ( angle > 0 && angle < 180 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-					}
-					// Right segments:
-					if ( angle > 90 && angle < 270 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-					}
-					
-					
-					// Have we found *any* contacts?
-					if ( contacts.getCount() > 0 ) {
-						
-						// Find the closest contact point to point1:
-						Vector2D p1 = Vector2D( x1, y1 );
-						
-						int   index = 0;
-						float dist  = (contacts[0] - p1).length();
-						
-						for ( int pInx = 1; pInx < contacts.getCount(); pInx++ ) {
-							float newDist = (contacts[pInx] - p1).length();
-							
-							if ( newDist < dist ) {
-								index = pInx;
-								dist  = newDist;
-							}
-						}
-						
-						// Return the parameters:
-						if ( contact )
-							*contact = contacts[index];
-						if ( normal )
-							*normal = normals[index];
-						
-						return true;
-					}
-					// No collision:
-					else
-						break;
+				// Otherwise, keep the contact closest to point1:
+				float dist = (tmpContact - Vector2D( x1, y1 )).length();
+				
+				if ( !closest || dist < closestDist ) {
+					closest        = &edge;
+					closestContact = tmpContact;
+					closestDist    = dist;
 				}
-					
+			}
+		}
+		
+		if ( closest ) {
+			if ( contact )
+				*contact = closestContact;
+			if ( normal )
+				*normal = closest->normal;
+			
+			return true;
+		}
+		
+		// If we've reached point2's block and still no collisions... give up.
+		if ( i == iFinal && j == jFinal )
+			return false;
+		
+		// Go to next block!
+		
+		bool changed = false;
+		
+		// Left edge:
+		if ( rightToLeft &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY,
+			               blkX,             blkY + blockSize,
+			               NULL ) ) {
+			j--;
+			changed = true;
+		}
+		
+		// Right edge:
+		if ( leftToRight &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX + blockSize, blkY,
+			               blkX + blockSize, blkY + blockSize,
+			               NULL ) ) {
+			j++;
+			changed = true;
+		}
+		
+		// Top edge:
+		if ( bottomToTop &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY,
+			               blkX + blockSize, blkY,
+			               NULL ) ) {
+			i--;
+			changed = true;
+		}
+		
+		// Bottom edge:
+		if ( topToBottom &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY + blockSize,
+			               blkX + blockSize, blkY + blockSize,
+			               NULL ) ) {
+			i++;
+			changed = true;
+		}
+		
+		// No intersection against any of the borders?
+		if ( !changed )
+			// We've technically reached the final block, even though the
+			// indices (i, j) are different from (iFinal, jFinal).
+			return false;
+	}
+	
+} // End of method: Room::pointCollision (moving point)
 
-				case RoomBlock::BLK_SW_NE_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( ((angle >= 0 && angle < 45) || (angle > 225 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_SE_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( (angle > 135 && angle < 315) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-				
-				
-				case RoomBlock::BLK_SW_E_BOTTOM:
-					// 26 top-left oblique segment:
-					if ( ((angle >= 0 && angle < 26) || (angle > 207 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = -2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_BOTTOM:
-					// 26 top-left oblique segment:
-					if ( ((angle >= 0 && angle < 26) || (angle > 207 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = -2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_BOTTOM:
-					// 26 top-right oblique segment:
-					if ( (angle > 153 && angle < 334) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = -2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_BOTTOM:
-					// 26 top-right oblique segment:
-					if ( (angle > 153 && angle < 334) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = -2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_RIGHT:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-					                   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_FULL:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_LEFT:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-					                   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_MISSING: {
-					// This is a lot more complicated, since it's a non-convex
-					// polygon.
-					
-					// Store all the intersections and their normals in a list:
-					static Container<Vector2D> contacts;
-					static Container<Vector2D> normals;
-					
-					contacts.removeAll();
-					normals.removeAll();
-					
-					static Vector2D tmpContact;
-					
-					// Top segment:
-					if ( angle > 180 && angle < 360 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-					}
-					
-					// Left segments:
-					if ( (angle >= 0 && angle < 90) || (angle > 270 && angle < 360) ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-					}
-					// Bottom segments:
-					if ( angle > 0 && angle < 180 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-					}
-					// Right segment:
-					if ( angle > 90 && angle < 270 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-					}
-					
-					
-					// Have we found *any* contacts?
-					if ( contacts.getCount() > 0 ) {
-						
-						// Find the closest contact point to point1:
-						Vector2D p1 = Vector2D( x1, y1 );
-						
-						int   index = 0;
-						float dist  = (contacts[0] - p1).length();
-						
-						for ( int pInx = 1; pInx < contacts.getCount(); pInx++ ) {
-							float newDist = (contacts[pInx] - p1).length();
-							
-							if ( newDist < dist ) {
-								index = pInx;
-								dist  = newDist;
-							}
-						}
-						
-						// Return the parameters:
-						if ( contact )
-							*contact = contacts[index];
-						if ( normal )
-							*normal = normals[index];
-						
-						return true;
-					}
-					// No collision:
-					else
-						break;
-				}
-					
-					
-				case RoomBlock::BLK_SE_MISSING: {
-					// This is a lot more complicated, since it's a non-convex
-					// polygon.
-					
-					// Store all the intersections and their normals in a list:
-					static Container<Vector2D> contacts;
-					static Container<Vector2D> normals;
-					
-					contacts.removeAll();
-					normals.removeAll();
-					
-					static Vector2D tmpContact;
-					
-					// Top segment:
-					if ( angle > 180 && angle < 360 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, -1) );
-						}
-					}
-					
-					// Left segment:
-					if ( (angle >= 0 && angle < 90) || (angle > 270 && angle < 360) ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(-1, 0) );
-						}
-					}
-					// Bottom segments:
-					if ( angle > 0 && angle < 180 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						                   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(0, 1) );
-						}
-					}
-					// Right segments:
-					if ( angle > 90 && angle < 270 ) {
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						                   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-						if ( Geom::segmentIntersection( x1, y1,
-						                   x2, y2,
-						                   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						                   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-						                   &tmpContact ) ) {
-							contacts.add( tmpContact );
-							normals.add( Vector2D(1, 0) );
-						}
-					}
-					
-					
-					// Have we found *any* contacts?
-					if ( contacts.getCount() > 0 ) {
-						
-						// Find the closest contact point to point1:
-						Vector2D p1 = Vector2D( x1, y1 );
-						
-						int   index = 0;
-						float dist  = (contacts[0] - p1).length();
-						
-						for ( int pInx = 1; pInx < contacts.getCount(); pInx++ ) {
-							float newDist = (contacts[pInx] - p1).length();
-							
-							if ( newDist < dist ) {
-								index = pInx;
-								dist  = newDist;
-							}
-						}
-						
-						// Return the parameters:
-						if ( contact )
-							*contact = contacts[index];
-						if ( normal )
-							*normal = normals[index];
-						
-						return true;
-					}
-					// No collision:
-					else
-						break;
-				}
-					
-					
-				case RoomBlock::BLK_NW_SE_TOP:
-					// 45 bott-left oblique segment:
-					if ( ((angle >= 0 && angle < 135) || (angle > 315 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_NE_TOP:
-					// 45 bott-right oblique segment:
-					if ( (angle > 45 && angle < 225) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_TOP:
-					// 26 bott-left oblique segment:
-					if ( ((angle >= 0 && angle < 153) || (angle > 334 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_TOP:
-					// 26 bott-left oblique segment:
-					if ( ((angle >= 0 && angle < 153) || (angle > 334 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_E_TOP:
-					// 26 bott-right oblique segment:
-					if ( (angle > 26 && angle < 207) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_TOP:
-					// 26 bott-right oblique segment:
-					if ( (angle > 26 && angle < 207) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 2;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NE_BLOCK:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						               blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_E_TOP:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-						               blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_BLOCK:
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( ((angle >= 0 && angle < 45) || (angle > 225 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-						               blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-						               blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( ((angle >= 0 && angle < 45) || (angle > 225 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-						               blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-						               contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-					                   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( (angle > 135 && angle < 315) && 
-					     Geom::segmentIntersection( x1, y1,
-					                   x2, y2,
-					                   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-					                   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-					                   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( (angle > 135 && angle < 315) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = -1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_TOP:
-					// 45 bott-left oblique segment:
-					if ( ((angle >= 0 && angle < 135) || (angle > 315 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_TOP:
-					// 45 bott-left oblique segment:
-					if ( ((angle >= 0 && angle < 135) || (angle > 315 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_TOP:
-					// 45 bott-right oblique segment:
-					if ( (angle > 45 && angle < 225) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( (angle > 0 && angle < 180) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = 1;
-						}
-						
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( (angle > 90 && angle < 270) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_TOP:
-					// 45 bott-right oblique segment:
-					if ( (angle > 45 && angle < 225) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 1;
-							normal->y = 1;
-							normal->normalize();
-						}
-						
-						return true;
-					}
-					// Top segment:
-					else
-					if ( (angle > 180 && angle < 360) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( ((angle >= 0 && angle < 90) || (angle > 270 && angle < 360)) && 
-						 Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = -1;
-							normal->y = 0;
-						}
-						
-						return true;
-					}
-					// No collision:
-					break;
-				
-					
-				case RoomBlock::BLK_THINFLOOR_HI:
-					// Crossed from top to bottom?
-					if ( touchThinFloor &&
-					     (angle > 180 && angle < 360) &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					break;
-					
-				case RoomBlock::BLK_THINFLOOR_MID:
-					// Crossed from top to bottom?
-					if ( touchThinFloor &&
-					     (angle > 180 && angle < 360) &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					break;
-				
-				case RoomBlock::BLK_THINFLOOR_LO:
-					// Crossed from top to bottom?
-					if ( touchThinFloor &&
-					     (angle > 180 && angle < 360) &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y - 1,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y - 1,
-									   contact ) ) {
-						if ( normal ) {
-							normal->x = 0;
-							normal->y = -1;
-						}
-						
-						return true;
-					}
-					break;
-				
-			}
-		}
-		
-		// If we've reached point2's block and still no collisions... give up.
-		if ( i == iFinal && j == jFinal )
-			return false;
-		
-		// Go to next block!
-		
-		bool toLeft = false, toRight = false, toTop = false, toBott = false;
-		
-		// Left edge:
-		if ( rightToLeft &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-			               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-			               NULL ) ) {
-			j--;
-			toLeft = true;
-		}
-		
-		// Right edge:
-		if ( leftToRight &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-			               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-			               NULL ) ) {
-			j++;
-			toRight = true;
-		}
-		
-		// Top edge:
-		if ( bottomToTop &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-			               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-			               NULL ) ) {
-			i--;
-			toTop = true;
-		}
-		
-		// Bottom edge:
-		if ( topToBottom &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-			               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-			               NULL ) ) {
-			i++;
-			toBott = true;
-		}
-		
-//		// This is tricky: If *two* of the above conditions were checked, it
-//		// means the point is crossing one of the block's edges. This may cause
-//		// the collision detection to lose awareness of its surrounding blocks,
-//		// since we'll be jumping to a cell that's not immediately adjacent to
-//		// the current block.
-//		// 
-//		// So, here's what I'm going to do: Split the point in two, offsetting
-//		// them by a half-pixel to ensure they'll fall on different borders, and
-//		// then combine their results.
-//		if ( (toLeft && toTop) || (toTop && toRight) || (toRight && toBott) || (toBott && toLeft) ) {
-//			Vector2D offset;
-//			
-//			if ( toLeft && toTop ) {
-//				offset.x = 1; offset.y = -1;
-//			}
-//			else if ( toTop && toRight ) {
-//				offset.x = 1; offset.y = 1;
-//			}
-//			else if ( toRight && toBott ) {
-//				offset.x = -1; offset.y = 1;
-//			}
-//			else {
-//				offset.x = -1; offset.y = -1;
-//			}
-//			
-//			Vector2D contact1, normal1;
-//			bool p1 = pointCollision( x1 + offset.y, y1 + offset.y, x2 + offset.x, y2 + offset.y, &contact1, &normal1 );
-//			
-//			Vector2D contact2, normal2;
-//			bool p2 = pointCollision( x1 - offset.y, y1 - offset.y, x2 - offset.x, y2 - offset.y, &contact2, &normal2 );
-//			
-//			// Both collided?
-//			if ( p1 && p2 ) {
-//				// Set the contact as the average contact of both contacts, and
-//				// the normal as the sum of both normals.
-//				if ( contact ) {
-//					*contact = contact1 + contact2;
-//					*contact /= 2;
-//				}
-//				if ( normal ) {
-//					*normal = normal1 + normal2;
-//					normal->normalize();
-//				}
-//				
-//				return true;
-//			}
-//			// Just p1 collided?
-//			else if ( p1 ) {
-//				if ( contact )
-//					*contact = contact1;
-//				if ( normal )
-//					*normal = normal1;
-//				
-//				return true;
-//			}
-//			// Just p2 collided?
-//			else if ( p2 ) {
-//				if ( contact )
-//					*contact = contact2;
-//				if ( normal )
-//					*normal = normal2;
-//				
-//				return true;
-//			}
-//			// Neither collided?
-//			else
-//				return false;
-//			
-//		}
-		
-		
-		// No intersection against any of the borders?
-		if ( !toLeft && !toRight && !toTop && !toBott )
-			// We've technically reached the final block, even though the
-			// indices (i, j) are different from (iFinal, jFinal).
-			return false;
-	}
-	
-} // End of method: Room::pointCollision (moving point)
-
-
-
-
-
-
-bool Room::segmentCollision ( float x1, float y1, float x2, float y2, bool falling ) {
-
-	// Extremities colliding?
-	if ( pointCollision( x1, y1 ) || pointCollision( x2, y2 ) )
-		return true;
-	
-	bool leftToRight = (x1 < x2);
-	bool rightToLeft = (x1 > x2);
-	bool topToBottom = (y1 < y2);
-	bool bottomToTop = (y1 > y2);
-	
-	
-	// Point2's block: The loop will end when we reach it.
-	int iFinal = (int) floorf( y2 / blockSize );
-	int jFinal = (int) floorf( x2 / blockSize );
-	
-	// Start out at point1's block:
-	int i = (int) floorf( y1 / blockSize );
-	int j = (int) floorf( x1 / blockSize );
-	
-	while ( true ) {
-		// The current block's top-left coordinates:
-		float blkX = (float) j * blockSize;
-		float blkY = (float) i * blockSize;
-		
-		
-		// Index inside of matrix?
-		if ( i >= 0 && i < obstacleLayer.rows &&
-		     j >= 0 && j < obstacleLayer.columns ) {
-			
-			// Extend a line from point1 to point2, and test for intersection
-			// against the obstacle layer:
-			switch ( obstacleLayer.cell(i, j) ) {
-				
-				case RoomBlock::BLK_SE_BLOCK:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_E_BOTTOM:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_BLOCK:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_MISSING:
-					// Top segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-						               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_CENTER_X,  blkY + BLOCK_CENTER_Y,
-						               blkX + BLOCK_N_X,       blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NE_MISSING:
-					// Top segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segments:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_NE_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_SE_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-				
-				
-				case RoomBlock::BLK_SW_E_BOTTOM:
-					// 26 top-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_BOTTOM:
-					// 26 top-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_BOTTOM:
-					// 26 top-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_BOTTOM:
-					// 26 top-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_RIGHT:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_FULL:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_LEFT:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_MISSING:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-						               blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-						               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SE_MISSING:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segments:
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-						               NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-						               x2, y2,
-						               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-						               NULL ) ) {
-						return true;
-					}
-					// Right segments:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   blkX + BLOCK_S_X,      blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_SE_TOP:
-					// 45 bott-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_NE_TOP:
-					// 45 bott-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_TOP:
-					// 26 bott-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_TOP:
-					// 26 bott-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_SW_E_TOP:
-					// 26 bott-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_TOP:
-					// 26 bott-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NE_BLOCK:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   blkX + BLOCK_E_X,      blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_E_TOP:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_NW_BLOCK:
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,      blkY + BLOCK_W_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,      blkY + BLOCK_N_Y,
-									   blkX + BLOCK_CENTER_X, blkY + BLOCK_CENTER_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_BOTTOM:
-					// 45 top-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_BOTTOM:
-					// 45 top-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_TOP:
-					// 45 bott-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_TOP:
-					// 45 bott-left oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_TOP:
-					// 45 bott-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_S_X, blkY + BLOCK_S_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Bottom segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-									   blkX + BLOCK_S_X,  blkY + BLOCK_S_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Right segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   blkX + BLOCK_E_X,  blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_TOP:
-					// 45 bott-right oblique segment:
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_N_X, blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Top segment:
-					else
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_N_X,  blkY + BLOCK_N_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// Left segment:
-					else 
-					if ( Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_W_X,  blkY + BLOCK_W_Y,
-									   NULL ) ) {
-						return true;
-					}
-					// No collision:
-					break;
-					
-					
-				case RoomBlock::BLK_THINFLOOR_HI:
-					// Crossed from top to bottom?
-					if ( falling &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-									   blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-									   NULL ) ) {
-						return true;
-					}
-					break;
-					
-				case RoomBlock::BLK_THINFLOOR_MID:
-					// Crossed from top to bottom?
-					if ( falling &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_W_X, blkY + BLOCK_W_Y,
-									   blkX + BLOCK_E_X, blkY + BLOCK_E_Y,
-									   NULL ) ) {
-						return true;
-					}
-					break;
-				
-				case RoomBlock::BLK_THINFLOOR_LO:
-					// Crossed from top to bottom?
-					if ( falling &&
-					     Geom::segmentIntersection( x1, y1,
-									   x2, y2,
-									   blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y - 1,
-									   blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y - 1,
-									   NULL ) ) {
-						return true;
-					}
-					break;
-				
-			}
-		}
-		
-		// If we've reached point2's block and still no collisions... give up.
-		if ( i == iFinal && j == jFinal )
-			return false;
-		
-		// Go to next block!
-		
-		bool changed = false;
-		
-		// Left edge:
-		if ( rightToLeft &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-			               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-			               NULL ) ) {
-			j--;
-			changed = true;
-		}
-		
-		// Right edge:
-		if ( leftToRight &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-			               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-			               NULL ) ) {
-			j++;
-			changed = true;
-		}
-		
-		// Top edge:
-		if ( bottomToTop &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_NW_X, blkY + BLOCK_NW_Y,
-			               blkX + BLOCK_NE_X, blkY + BLOCK_NE_Y,
-			               NULL ) ) {
-			i--;
-			changed = true;
-		}
-		
-		// Bottom edge:
-		if ( topToBottom &&
-		     Geom::segmentIntersection( x1, y1,
-			               x2, y2,
-			               blkX + BLOCK_SW_X, blkY + BLOCK_SW_Y,
-			               blkX + BLOCK_SE_X, blkY + BLOCK_SE_Y,
-			               NULL ) ) {
-			i++;
-			changed = true;
-		}
-		
-		// No intersection against any of the borders?
-		if ( !changed )
-			// We've technically reached the final block, even though the
-			// indices (i, j) are different from (iFinal, jFinal).
-			return false;
-	}
-	
-} // End of method: Room::segmentCollision (static segment)	
-
-
-
-
-
-
-
-bool Room::segmentCollision ( float x1, float y1, float x2, float y2, float dx, float dy, bool touchThinFloor,
-                              Container<Vector2D> * contacts, Container<Vector2D> * normals, Vector2D * validDisplacement ) {
-	
-	// Pathological case: The segment is colliding right off the start:
-	if ( segmentCollision( x1, y1, x2, y2, (touchThinFloor && dy >= 0) ) ) {
-		// For the contact point, use the segment's center:
-		if ( contacts ) {
-			contacts->removeAll();
-			contacts->add( Vector2D( (x1 + x2)/2, (y1 + y2)/2) );
-		}
-		
-		// For the normal, use a vector pointing in the displacement's opposite
-		// direction:
-		if ( normals ) {
-			normals->removeAll();
-			Vector2D n = Vector2D( -dx, -dy);
-			n.normalize();
-			normals->add( n );
-		}
-		
-		// No valid displacement!
-		if ( validDisplacement ) {
-			validDisplacement->x = validDisplacement->y = 0;
-		}
-		
-		return true;
-	}
-	
-	// Pathological case: Segment with length zero.
-	if ( sqrtf( (x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2) ) < EPSILON ) {
-		// It's a point!
-		Vector2D tmpContact, tmpNormal;
-		
-		if ( pointCollision( x1, y1, x1 + dx, y1 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
-			if ( contacts ) {
-				contacts->removeAll();
-				contacts->add( tmpContact );
-			}
-
-			if ( normals ) {
-				normals->removeAll();
-				normals->add( tmpNormal );
-			}
-			
-			if ( validDisplacement ) {
-				validDisplacement->x = tmpContact.x - x1;
-				validDisplacement->y = tmpContact.y - y1;
-			}
-			
-			return true;
-		}
-		else
-			return false;
-	}
-	
-	
-	// These containers will store the candidates for collision.
-	static Container<Vector2D> contactCandidates;
-	static Container<Vector2D> normalCandidates;
-
-	contactCandidates.removeAll();
-	normalCandidates.removeAll();
-	
-	// If the segment hasn't moved, there was no collision:
-	if ( dx == 0 && dy == 0 )
-		return false;
-	
-	// The segment's angle relative to the X-axis (as if it were a moving point
-	// from (x1,y1) -> (x2,y2)):
-	float segmAngle = degreeAngle( x2 - x1, y2 - y1 );
-	
-	
-	// Here's the plan:
-	// The obvious choices are the points where the segment's extremities touch
-	// the obstacle layer, so these will be included in the list of candidates
-	// right away.
-	// 
-	// There is also a possibility that the segment will touch a "corner" in
-	// the obstacle layer; thus, I will test *all* the corners in the segment's
-	// path to determine which ones are candidate for collision.
-	Vector2D tmpContact, tmpNormal;
-	
-	// "Obvious" candidates:
-	// Extremity 1:
-	if ( pointCollision( x1, y1, x1 + dx, y1 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
-		contactCandidates.add( tmpContact );
-		normalCandidates.add( tmpNormal );
-	}
-	
-	// Extremity 2:
-	if ( pointCollision( x2, y2, x2 + dx, y2 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
-		contactCandidates.add( tmpContact );
-		normalCandidates.add( tmpNormal );
-	}
-	
-	
-	// Now, find all "corners."
-	// A polygon representing the segment's path:
-	static Container<Vector2D> pathPolygon;
-	while ( pathPolygon.getCount() < 4 )
-		pathPolygon.add( Vector2D() );
-	
-	pathPolygon[0].x = x1;      pathPolygon[0].y = y1;
-	pathPolygon[1].x = x2;      pathPolygon[1].y = y2;
-	pathPolygon[2].x = x2 + dx; pathPolygon[2].y = y2 + dy;
-	pathPolygon[3].x = x1 + dx; pathPolygon[3].y = y1 + dy;
-	
-	// Examine a matrix that covers the segment's path:
-	int startI = (int) (std::min(std::min(y1, y2), std::min(y1 + dy, y2 + dy))) / blockSize;
-	int startJ = (int) (std::min(std::min(x1, x2), std::min(x1 + dx, x2 + dx))) / blockSize;
-	int finalI = (int) (std::max(std::max(y1, y2), std::max(y1 + dy, y2 + dy))) / blockSize;
-	int finalJ = (int) (std::max(std::max(x1, x2), std::max(x1 + dx, x2 + dx))) / blockSize;
-	
-	if ( startI <  0                     ) startI = 0;
-	if ( startI >= obstacleLayer.rows    ) startI = obstacleLayer.rows - 1;
-	if ( finalI <  0                     ) finalI = 0;
-	if ( finalI >= obstacleLayer.rows    ) finalI = obstacleLayer.rows - 1;
-	if ( startJ <  0                     ) startJ = 0;
-	if ( startJ >= obstacleLayer.columns ) startJ = obstacleLayer.columns - 1;
-	if ( finalJ <  0                     ) finalJ = 0;
-	if ( finalJ >= obstacleLayer.columns ) finalJ = obstacleLayer.columns - 1;
-	
-#define ANG_ERR 1.0f
-	
-	for ( int i = startI; i <= finalI; i++ ) {
-		for ( int j = startJ; j <= finalJ; j++ ) {
-			// The current block's top-left coordinates:
-			float blkX = (float) (j * blockSize);
-			float blkY = (float) (i * blockSize);
-			
-			// Add all "corners" to the list of contact candidates:
-			switch ( obstacleLayer.cell(i, j) ) {
-				
-				case RoomBlock::BLK_SE_BLOCK:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_CENTER_X;
-					tmpContact.y = blkY + BLOCK_CENTER_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90.0f, ANG_ERR) ||
-						     marginCmp(segmAngle, 270.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0.0f, ANG_ERR) ||
-						          marginCmp(segmAngle, 180.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90.0f, ANG_ERR) ||
-						     marginCmp(segmAngle, 270.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90.0f, ANG_ERR) ||
-						     marginCmp(segmAngle, 270.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0.0f, ANG_ERR) ||
-						          marginCmp(segmAngle, 180.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90.0f, ANG_ERR) ||
-						     marginCmp(segmAngle, 270.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0.0f, ANG_ERR) ||
-						          marginCmp(segmAngle, 180.0f, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_E_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_BLOCK:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_CENTER_X;
-					tmpContact.y = blkY + BLOCK_CENTER_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_MISSING:
-					// Top-left1:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-left2:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NE_MISSING:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right1:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Top-right2:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_NE_BOTTOM:
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.382683f, -0.92388f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, 0.382683f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_SE_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, -0.92388f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, 0.382683f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_E_BOTTOM:
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.525731f, -0.850651f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.973249f, 0.229753f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_BOTTOM:
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.525731f, -0.850651f ) );
-					}
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.850651f, -0.525731f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.525731f, -0.850651f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.850651f, -0.525731f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.525731f, -0.850651f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.973249f, 0.229753f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_RIGHT:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_FULL:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_N_S_LEFT:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_MISSING:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left1:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					// Bottom-left2:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SE_MISSING:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right1:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-right2:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_SE_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, -0.382683f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.382683f, 0.92388f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_NE_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Horizontal segment?
-						if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// Vertical segment?
-						else if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						          marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, -0.382683f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, 0.92388f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_E_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.973249f, -0.229753f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.525731f, 0.850651f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_SE_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Horizontal segment?
-						if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// Vertical segment?
-						else if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						          marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.850651f, 0.525731f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle, 154, ANG_ERR) ||
-						          marginCmp(segmAngle, 334, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.525731f, 0.850651f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_SW_E_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Horizontal segment?
-						if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// Vertical segment?
-						else if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						          marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.850651f, 0.525731f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.525731f, 0.850651f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_NE_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Horizontal segment?
-						if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// Vertical segment?
-						else if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						          marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.973249f, -0.229753f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 26 degree segment?
-						else if ( marginCmp(segmAngle,  26, ANG_ERR) ||
-						          marginCmp(segmAngle, 206, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 2 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.525731f, 0.850651f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NE_BLOCK:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_CENTER_X;
-					tmpContact.y = blkY + BLOCK_CENTER_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_E_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_NW_BLOCK:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_CENTER_X;
-					tmpContact.y = blkY + BLOCK_CENTER_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_BOTTOM:
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.382683f, -0.92388f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, 0.382683f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_BOTTOM:
-					// Top-left1:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, -0.92388f ) );
-					}
-					// Top-left2:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, -0.382683f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right1:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.382683f, -0.92388f ) );
-					}
-					// Top-right2:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, -0.382683f ) );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_BOTTOM:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, -0.92388f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, 0.382683f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_N_E_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, -0.382683f ) );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.382683f, 0.92388f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_S_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right:
-					tmpContact.x = blkX + BLOCK_SE_X;
-					tmpContact.y = blkY + BLOCK_SE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-					}
-					// Bottom-left1:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.92388f, 0.382683f ) );
-					}
-					// Bottom-left2:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle, 135, ANG_ERR) ||
-						          marginCmp(segmAngle, 315, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, 0.92388f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_S_E_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_NE_X;
-					tmpContact.y = blkY + BLOCK_NE_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						else
-							normalCandidates.add( Vector2D( 1, -1 ).unit() );
-					}
-					// Bottom-right1:
-					tmpContact.x = blkX + BLOCK_S_X;
-					tmpContact.y = blkY + BLOCK_S_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, 0.382683f ) );
-					}
-					// Bottom-right2:
-					tmpContact.x = blkX + BLOCK_E_X;
-					tmpContact.y = blkY + BLOCK_E_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, 0.382683f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_SW_X;
-					tmpContact.y = blkY + BLOCK_SW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						else
-							normalCandidates.add( Vector2D( -1, 1 ).unit() );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_W_N_TOP:
-					// Top-left:
-					tmpContact.x = blkX + BLOCK_NW_X;
-					tmpContact.y = blkY + BLOCK_NW_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Horizontal segment?
-						if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						     marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// Vertical segment?
-						else if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						          marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						else
-							normalCandidates.add( Vector2D( -1, -1 ).unit() );
-					}
-					// Top-right:
-					tmpContact.x = blkX + BLOCK_N_X;
-					tmpContact.y = blkY + BLOCK_N_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, -1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( 0.92388f, -0.382683f ) );
-					}
-					// Bottom-left:
-					tmpContact.x = blkX + BLOCK_W_X;
-					tmpContact.y = blkY + BLOCK_W_Y;
-					if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-						contactCandidates.add( tmpContact );
-						
-						// Vertical segment?
-						if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-						     marginCmp(segmAngle, 270, ANG_ERR) )
-							normalCandidates.add( Vector2D( -1, 0 ) );
-						// Horizontal segment?
-						else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-						          marginCmp(segmAngle, 180, ANG_ERR) )
-							normalCandidates.add( Vector2D( 0, 1 ) );
-						// 45 degree segment?
-						else if ( marginCmp(segmAngle,  45, ANG_ERR) ||
-						          marginCmp(segmAngle, 225, ANG_ERR) )
-							normalCandidates.add( Vector2D( 1, 1 ).unit() );
-						else
-							normalCandidates.add( Vector2D( -0.382683f, 0.92388f ) );
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_THINFLOOR_HI:
-					// Only test if the segment's moving from top to bottom:
-					if ( touchThinFloor && dy >= 0 ) {
-						// Top-left:
-						tmpContact.x = blkX + BLOCK_NW_X;
-						tmpContact.y = blkY + BLOCK_NW_Y;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( -1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						}
-						// Top-right:
-						tmpContact.x = blkX + BLOCK_NE_X;
-						tmpContact.y = blkY + BLOCK_NE_Y;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( 1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						}
-					}
-					break;
-					
-					
-				case RoomBlock::BLK_THINFLOOR_MID:
-					// Only test if the segment's moving from top to bottom:
-					if ( touchThinFloor && dy >= 0 ) {
-						// Top-left:
-						tmpContact.x = blkX + BLOCK_W_X;
-						tmpContact.y = blkY + BLOCK_W_Y;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( -1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						}
-						// Top-right:
-						tmpContact.x = blkX + BLOCK_E_X;
-						tmpContact.y = blkY + BLOCK_E_Y;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( 1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						}
-					}
-					break;
-					
-					
-					case RoomBlock::BLK_THINFLOOR_LO:
-					// Only test if the segment's moving from top to bottom:
-					if ( touchThinFloor && dy >= 0 ) {
-						// Bottom-left:
-						tmpContact.x = blkX + BLOCK_SW_X;
-						tmpContact.y = blkY + BLOCK_SW_Y - 1;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( -1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( -1, -1 ).unit() );
-						}
-						// Bottom-right:
-						tmpContact.x = blkX + BLOCK_SE_X;
-						tmpContact.y = blkY + BLOCK_SE_Y - 1;
-						if ( Geom::insidePolygon( tmpContact, pathPolygon ) ) {
-							contactCandidates.add( tmpContact );
-							
-							// Vertical segment?
-							if ( marginCmp(segmAngle,  90, ANG_ERR) ||
-								 marginCmp(segmAngle, 270, ANG_ERR) )
-								normalCandidates.add( Vector2D( 1, 0 ) );
-							// Horizontal segment?
-							else if ( marginCmp(segmAngle,   0, ANG_ERR) ||
-									  marginCmp(segmAngle, 180, ANG_ERR) )
-								normalCandidates.add( Vector2D( 0, -1 ) );
-							else
-								normalCandidates.add( Vector2D( 1, -1 ).unit() );
-						}
-					}
-					break;
-					
-					
-				default:
-					break;
+
+
+
+
+
+bool Room::segmentCollision ( float x1, float y1, float x2, float y2, bool falling ) const {
+
+	// Nothing but empty space around?
+	if ( regionEmpty( *this, x1, y1, x2, y2 ) )
+		return false;
+	
+	// Extremities colliding?
+	if ( pointCollision( x1, y1 ) || pointCollision( x2, y2 ) )
+		return true;
+	
+	return segmentCrossesObstacle( x1, y1, x2, y2, falling );
+} // End of method: Room::segmentCollision (static segment)
+
+
+
+
+
+
+bool Room::segmentCrossesObstacle ( float x1, float y1, float x2, float y2, bool falling ) const {
+	
+	bool leftToRight = (x1 < x2);
+	bool rightToLeft = (x1 > x2);
+	bool topToBottom = (y1 < y2);
+	bool bottomToTop = (y1 > y2);
+	
+	
+	// Point2's block: The loop will end when we reach it.
+	int iFinal = (int) floorf( y2 / blockSize );
+	int jFinal = (int) floorf( x2 / blockSize );
+	
+	// Start out at point1's block:
+	int i = (int) floorf( y1 / blockSize );
+	int j = (int) floorf( x1 / blockSize );
+	
+	while ( true ) {
+		// The current block's top-left coordinates:
+		float blkX = (float) j * blockSize;
+		float blkY = (float) i * blockSize;
+		
+		// Extend a line from point1 to point2, and test for intersection
+		// against the block's edges (outside of the matrix, the empty border
+		// is found, which has no edges):
+		const RoomBlockGeometry::Shape & shape =
+			blockGeometry.shape( obstacleLayer.at( obstacleLayer.clampRow(i), obstacleLayer.clampColumn(j) ) );
+		
+		for ( int e = 0; e < shape.edgeCount; e++ ) {
+			const RoomBlockGeometry::Edge & edge = shape.edges[e];
+			
+			// Thin floors only count when crossed from top to bottom:
+			if ( edge.thinFloor && !falling )
+				continue;
+			
+			if ( Geom::segmentIntersection( x1, y1,
+			                   x2, y2,
+			                   blkX + edge.p1.x, blkY + edge.p1.y,
+			                   blkX + edge.p2.x, blkY + edge.p2.y,
+			                   NULL ) ) {
+				return true;
+			}
+		}
+		
+		// If we've reached point2's block and still no collisions... give up.
+		if ( i == iFinal && j == jFinal )
+			return false;
+		
+		// Go to next block!
+		
+		bool changed = false;
+		
+		// Left edge:
+		if ( rightToLeft &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY,
+			               blkX,             blkY + blockSize,
+			               NULL ) ) {
+			j--;
+			changed = true;
+		}
+		
+		// Right edge:
+		if ( leftToRight &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX + blockSize, blkY,
+			               blkX + blockSize, blkY + blockSize,
+			               NULL ) ) {
+			j++;
+			changed = true;
+		}
+		
+		// Top edge:
+		if ( bottomToTop &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY,
+			               blkX + blockSize, blkY,
+			               NULL ) ) {
+			i--;
+			changed = true;
+		}
+		
+		// Bottom edge:
+		if ( topToBottom &&
+		     Geom::segmentIntersection( x1, y1,
+			               x2, y2,
+			               blkX,             blkY + blockSize,
+			               blkX + blockSize, blkY + blockSize,
+			               NULL ) ) {
+			i++;
+			changed = true;
+		}
+		
+		// No intersection against any of the borders?
+		if ( !changed )
+			// We've technically reached the final block, even though the
+			// indices (i, j) are different from (iFinal, jFinal).
+			return false;
+	}
+	
+} // End of method: Room::segmentCrossesObstacle
+
+
+
+
+
+
+bool Room::segmentCollision ( float x1, float y1, float x2, float y2, float dx, float dy, bool touchThinFloor,
+                              Container<Vector2D> * contacts, Container<Vector2D> * normals, Vector2D * validDisplacement,
+                              Scratch * scratch ) const {
+	
+	// Nothing but empty space in the segment's path?
+	if ( regionEmpty( *this, std::min( x1, x2 ) + std::min( dx, 0.0f ), std::min( y1, y2 ) + std::min( dy, 0.0f ),
+	                         std::max( x1, x2 ) + std::max( dx, 0.0f ), std::max( y1, y2 ) + std::max( dy, 0.0f ) ) )
+		return false;
+	
+	// Pathological case: The segment is colliding right off the start:
+	if ( segmentCollision( x1, y1, x2, y2, (touchThinFloor && dy >= 0) ) ) {
+		// For the contact point, use the segment's center:
+		if ( contacts ) {
+			contacts->removeAll();
+			contacts->add( Vector2D( (x1 + x2)/2, (y1 + y2)/2) );
+		}
+		
+		// For the normal, use a vector pointing in the displacement's opposite
+		// direction:
+		if ( normals ) {
+			normals->removeAll();
+			Vector2D n = Vector2D( -dx, -dy);
+			n.normalize();
+			normals->add( n );
+		}
+		
+		// No valid displacement!
+		if ( validDisplacement ) {
+			validDisplacement->x = validDisplacement->y = 0;
+		}
+		
+		return true;
+	}
+	
+	// Pathological case: Segment with length zero.
+	if ( sqrtf( (x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2) ) < EPSILON ) {
+		// It's a point!
+		Vector2D tmpContact, tmpNormal;
+		
+		if ( pointCollision( x1, y1, x1 + dx, y1 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
+			if ( contacts ) {
+				contacts->removeAll();
+				contacts->add( tmpContact );
+			}
+
+			if ( normals ) {
+				normals->removeAll();
+				normals->add( tmpNormal );
+			}
+			
+			if ( validDisplacement ) {
+				validDisplacement->x = tmpContact.x - x1;
+				validDisplacement->y = tmpContact.y - y1;
+			}
+			
+			return true;
+		}
+		else
+			return false;
+	}
+	
+	
+	// These containers will store the candidates for collision:
+	if ( !scratch )
+		scratch = &threadScratch();
+	
+	Container<Vector2D> & contactCandidates = scratch->contactCandidates;
+	Container<Vector2D> & normalCandidates  = scratch->normalCandidates;
+
+	contactCandidates.removeAll();
+	normalCandidates.removeAll();
+	
+	// If the segment hasn't moved, there was no collision:
+	if ( dx == 0 && dy == 0 )
+		return false;
+	
+	// The segment's angle relative to the X-axis (as if it were a moving point
+	// from (x1,y1) -> (x2,y2)):
+	float segmAngle = degreeAngle( x2 - x1, y2 - y1 );
+	
+	
+	// Here's the plan:
+	// The obvious choices are the points where the segment's extremities touch
+	// the obstacle layer, so these will be included in the list of candidates
+	// right away.
+	// 
+	// There is also a possibility that the segment will touch a "corner" in
+	// the obstacle layer; thus, I will test *all* the corners in the segment's
+	// path to determine which ones are candidate for collision.
+	Vector2D tmpContact, tmpNormal;
+	
+	// "Obvious" candidates:
+	// Extremity 1:
+	if ( pointCollision( x1, y1, x1 + dx, y1 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
+		contactCandidates.add( tmpContact );
+		normalCandidates.add( tmpNormal );
+	}
+	
+	// Extremity 2:
+	if ( pointCollision( x2, y2, x2 + dx, y2 + dy, touchThinFloor, &tmpContact, &tmpNormal ) ) {
+		contactCandidates.add( tmpContact );
+		normalCandidates.add( tmpNormal );
+	}
+	
+	
+	// Now, find all "corners."
+	// A polygon representing the segment's path:
+	Vector2D pathPolygon[4];
+	
+	pathPolygon[0].x = x1;      pathPolygon[0].y = y1;
+	pathPolygon[1].x = x2;      pathPolygon[1].y = y2;
+	pathPolygon[2].x = x2 + dx; pathPolygon[2].y = y2 + dy;
+	pathPolygon[3].x = x1 + dx; pathPolygon[3].y = y1 + dy;
+	
+	// Examine a matrix that covers the segment's path:
+	int startI = (int) (std::min(std::min(y1, y2), std::min(y1 + dy, y2 + dy))) / blockSize;
+	int startJ = (int) (std::min(std::min(x1, x2), std::min(x1 + dx, x2 + dx))) / blockSize;
+	int finalI = (int) (std::max(std::max(y1, y2), std::max(y1 + dy, y2 + dy))) / blockSize;
+	int finalJ = (int) (std::max(std::max(x1, x2), std::max(x1 + dx, x2 + dx))) / blockSize;
+	
+	if ( startI <  0                     ) startI = 0;
+	if ( startI >= obstacleLayer.rows    ) startI = obstacleLayer.rows - 1;
+	if ( finalI <  0                     ) finalI = 0;
+	if ( finalI >= obstacleLayer.rows    ) finalI = obstacleLayer.rows - 1;
+	if ( startJ <  0                     ) startJ = 0;
+	if ( startJ >= obstacleLayer.columns ) startJ = obstacleLayer.columns - 1;
+	if ( finalJ <  0                     ) finalJ = 0;
+	if ( finalJ >= obstacleLayer.columns ) finalJ = obstacleLayer.columns - 1;
+	
+	// Which of the corners' normals to use depends on the segment's slope:
+	RoomBlockGeometry::AngleClass angleClass = RoomBlockGeometry::angleClass( segmAngle );
+	
+	// Thin floors only count when moving from top to bottom:
+	bool thinFloorSolid = (touchThinFloor && dy >= 0);
+	
+	for ( int i = startI; i <= finalI; i++ ) {
+		for ( int j = startJ; j <= finalJ; j++ ) {
+			// The current block's top-left coordinates:
+			float blkX = (float) (j * blockSize);
+			float blkY = (float) (i * blockSize);
+			
+			// Add all "corners" to the list of contact candidates:
+			const RoomBlockGeometry::Shape & shape = blockGeometry.shape( obstacleLayer.at(i, j) );
+			
+			for ( int c = 0; c < shape.cornerCount; c++ ) {
+				const RoomBlockGeometry::Corner & corner = shape.corners[c];
+				
+				if ( corner.thinFloor && !thinFloorSolid )
+					continue;
+				
+				tmpContact.x = blkX + corner.point.x;
+				tmpContact.y = blkY + corner.point.y;
+				if ( Geom::insidePolygon( tmpContact, pathPolygon, 4 ) ) {
+					contactCandidates.add( tmpContact );
+					normalCandidates.add( corner.normals[angleClass] );
+				}
 			}
 		}
 	}
@@ -6896,7 +762,7 @@ bool Room::segmentCollision ( float x1, float y1, float x2, float y2, float dx,
 		// vCoord = -(p.x * u.y - u.x * p.y) / (u.x * v.y - v.x * u.y)
 		
 		// Start with the first...
-		Vector2D & cPoint   = contactCandidates[0] - p1;
+		Vector2D cPoint     = contactCandidates[0] - p1;
 		float shortestV     = -(cPoint.x * u.y - u.x * cPoint.y) / (u.x * v.y - v.x * u.y);
 		
 		for ( int pInx = 1; pInx < contactCandidates.getCount(); pInx++ ) {
@@ -6999,4 +865,497 @@ SEARCH:
 	else
 		return false;
 	
-} // End of method: Room::segmentCollision (linear moving segment)	
+} // End of method: Room::segmentCollision (linear moving segment)
+
+
+
+
+
+
+bool Room::boxSweep ( float left, float top, float right, float bottom, float dx, float dy, bool touchThinFloor,
+                      SweepResult * result, Scratch * scratch ) const {
+	float length = sqrtf( dx * dx + dy * dy );
+	
+	// If the box hasn't moved, there was no collision:
+	if ( length < EPSILON )
+		return false;
+	
+	// Nothing but empty space in the box's path?
+	if ( regionEmpty( *this, left + std::min( dx, 0.0f ), top + std::min( dy, 0.0f ),
+	                         right + std::max( dx, 0.0f ), bottom + std::max( dy, 0.0f ) ) )
+		return false;
+	
+	// The leading sides: Up to one vertical and one horizontal.
+	float sides[2][4];
+	int   nSides = 0;
+	
+	if ( dx != 0 ) {
+		float x = (dx > 0 ? right : left);
+		sides[nSides][0] = x; sides[nSides][1] = top;
+		sides[nSides][2] = x; sides[nSides][3] = bottom;
+		nSides++;
+	}
+	
+	if ( dy != 0 ) {
+		float y = (dy > 0 ? bottom : top);
+		sides[nSides][0] = left;  sides[nSides][1] = y;
+		sides[nSides][2] = right; sides[nSides][3] = y;
+		nSides++;
+	}
+	
+	// Sweep each side, and keep the earliest contact:
+	if ( !scratch )
+		scratch = &threadScratch();
+	
+	Container<Vector2D> & contacts = scratch->contacts;
+	Container<Vector2D> & normals  = scratch->normals;
+	Vector2D validDisplacement;
+	
+	bool  hit      = false;
+	float bestTime = 1.0f;
+	Vector2D bestContact, bestNormal;
+	
+	// The edge mesh can only be used if it matches the obstacle layer:
+	bool useMesh = edgeMesh.isUpToDate( obstacleLayer );
+	
+	for ( int s = 0; s < nSides; s++ ) {
+		float    time;
+		Vector2D contact, normal;
+		
+		if ( useMesh ) {
+			// Colliding right off the start? Edges can't tell.
+			if ( segmentCollision( sides[s][0], sides[s][1], sides[s][2], sides[s][3], (touchThinFloor && dy >= 0) ) ) {
+				time    = 0;
+				contact = Vector2D( (sides[s][0] + sides[s][2])/2, (sides[s][1] + sides[s][3])/2 );
+				normal  = Vector2D( -dx, -dy ).unit();
+			}
+			else if ( !edgeMesh.sweep( sides[s][0], sides[s][1], sides[s][2], sides[s][3], dx, dy, touchThinFloor,
+			                           &time, &contact, &normal ) )
+				continue;
+		}
+		else {
+			if ( !segmentCollision( sides[s][0], sides[s][1], sides[s][2], sides[s][3], dx, dy, touchThinFloor,
+			                        &contacts, &normals, &validDisplacement, scratch ) )
+				continue;
+			
+			// Project the valid displacement onto the movement:
+			time = (validDisplacement * Vector2D( dx, dy )) / (length * length);
+			if ( time < 0 )
+				time = 0;
+			if ( time > 1.0f )
+				time = 1.0f;
+			
+			// All the contacts happen at the same time; combine their
+			// normals:
+			contact = contacts[0];
+			normal  = Vector2D( 0, 0 );
+			for ( int n = 0; n < normals.getCount(); n++ )
+				normal += normals[n];
+			normal.normalize();
+		}
+		
+		if ( !hit || time < bestTime ) {
+			hit         = true;
+			bestTime    = time;
+			bestContact = contact;
+			bestNormal  = normal;
+		}
+	}
+	
+	if ( hit && result ) {
+		result->time    = bestTime;
+		result->contact = bestContact;
+		result->normal  = bestNormal;
+		result->slope   = slopeClass( bestNormal );
+	}
+	
+	return hit;
+	
+} // End of method: Room::boxSweep
+
+
+
+
+
+
+bool Room::raycast ( float x, float y, float dirX, float dirY, float maxDistance, bool touchThinFloor,
+                     RaycastResult * result ) const {
+	// Normalize the direction, so the ray's parameter is a distance:
+	float dirLength = sqrtf( dirX * dirX + dirY * dirY );
+	
+	if ( dirLength < EPSILON || maxDistance < 0 )
+		return false;
+	
+	dirX /= dirLength;
+	dirY /= dirLength;
+	
+	// Nothing but empty space in the way?
+	if ( regionEmpty( *this, x, y, x + dirX * maxDistance, y + dirY * maxDistance ) )
+		return false;
+	
+	// Maybe the ray starts inside an obstacle...
+	if ( pointCollision( x, y ) ) {
+		if ( result ) {
+			result->distance = 0;
+			result->contact  = Vector2D( x, y );
+			result->normal   = Vector2D( -dirX, -dirY );
+			result->block    = obstacleLayer.at( obstacleLayer.clampRow( (int) (y / blockSize) ),
+			                                     obstacleLayer.clampColumn( (int) (x / blockSize) ) );
+		}
+		
+		return true;
+	}
+	
+	float size = (float) blockSize;
+	
+	// Start out at the origin's block:
+	int i = (int) floorf( y / size );
+	int j = (int) floorf( x / size );
+	
+	int stepI = (dirY > 0 ? 1 : (dirY < 0 ? -1 : 0));
+	int stepJ = (dirX > 0 ? 1 : (dirX < 0 ? -1 : 0));
+	
+	// Distance along the ray to the next row and column boundaries, and
+	// between consecutive boundaries:
+	float nextI  = (stepI != 0 ? ((i + (stepI > 0 ? 1 : 0)) * size - y) / dirY : FLT_MAX);
+	float nextJ  = (stepJ != 0 ? ((j + (stepJ > 0 ? 1 : 0)) * size - x) / dirX : FLT_MAX);
+	float deltaI = (stepI != 0 ? size / fabsf( dirY ) : FLT_MAX);
+	float deltaJ = (stepJ != 0 ? size / fabsf( dirX ) : FLT_MAX);
+	
+	float enter = 0;
+	
+	while ( true ) {
+		// Where the ray leaves the current block:
+		float exit = std::min( std::min( nextI, nextJ ), maxDistance );
+		
+		// Outside of the matrix, the empty border is found, which has no
+		// edges:
+		RoomBlock::Type type = obstacleLayer.at( obstacleLayer.clampRow(i), obstacleLayer.clampColumn(j) );
+		const RoomBlockGeometry::Shape & shape = blockGeometry.shape( type );
+		
+		// Test the ray against the block's edges, keeping the nearest hit
+		// inside of the block:
+		const RoomBlockGeometry::Edge * closest = NULL;
+		float closestDist = 0;
+		
+		float blkX = (float) j * size;
+		float blkY = (float) i * size;
+		
+		for ( int e = 0; e < shape.edgeCount; e++ ) {
+			const RoomBlockGeometry::Edge & edge = shape.edges[e];
+			
+			// Only edges facing the ray may be hit, and thin floors may be
+			// ignored altogether:
+			if ( dirX * edge.normal.x + dirY * edge.normal.y >= 0 || (edge.thinFloor && !touchThinFloor) )
+				continue;
+			
+			// Solve origin + t * dir = p1 + s * (p2 - p1):
+			float ex    = edge.p2.x - edge.p1.x;
+			float ey    = edge.p2.y - edge.p1.y;
+			float denom = dirX * ey - dirY * ex;
+			
+			if ( fabsf( denom ) < 1e-6f )
+				continue;
+			
+			float wx = blkX + edge.p1.x - x;
+			float wy = blkY + edge.p1.y - y;
+			float t  = (wx * ey - wy * ex) / denom;
+			
+			// The hit must lie inside of this block, and be the nearest so
+			// far:
+			if ( t < enter - EPSILON || t > exit + EPSILON || (closest && t >= closestDist) )
+				continue;
+			
+			float s = (wx * dirY - wy * dirX) / denom;
+			
+			if ( s < 0 || s > 1.0f )
+				continue;
+			
+			closest     = &edge;
+			closestDist = t;
+		}
+		
+		if ( closest && closestDist <= maxDistance + EPSILON ) {
+			closestDist = std::max( 0.0f, std::min( closestDist, maxDistance ) );
+			
+			if ( result ) {
+				result->distance = closestDist;
+				result->contact  = Vector2D( x + dirX * closestDist, y + dirY * closestDist );
+				result->normal   = closest->normal;
+				result->block    = type;
+			}
+			
+			return true;
+		}
+		
+		// Go to the next block!
+		if ( nextJ < nextI ) {
+			j     += stepJ;
+			enter  = nextJ;
+			nextJ += deltaJ;
+		}
+		else {
+			i     += stepI;
+			enter  = nextI;
+			nextI += deltaI;
+		}
+		
+		// Reached the maximum distance and still no collisions... give up.
+		if ( enter > maxDistance + EPSILON )
+			return false;
+		
+		// Left the matrix, never to come back?
+		if ( (i < 0 && stepI <= 0) || (i >= obstacleLayer.rows    && stepI >= 0) ||
+		     (j < 0 && stepJ <= 0) || (j >= obstacleLayer.columns && stepJ >= 0) )
+			return false;
+	}
+	
+} // End of method: Room::raycast
+
+
+
+
+
+
+bool Room::groundHeight ( float x1, float x2, float y, float maxDistance, bool touchThinFloor, float * height ) const {
+	// Nothing but empty space below?
+	if ( regionEmpty( *this, x1, y, x2, y + maxDistance ) )
+		return false;
+	
+	float ground   = y + maxDistance;
+	bool  found    = false;
+	int   firstRow = std::max( (int) floorf( y / blockSize ), -1 );
+	
+	visitSpan( *this, x1, x2, [&] ( int j, int px, float f ) {
+		// Walk down the pixel column, no further than the ground found so
+		// far:
+		for ( int i = firstRow; i <= obstacleLayer.rows && i * blockSize <= ground; i++ ) {
+			const RoomBlockGeometry::Column & column = columnAt( *this, i, j, px );
+			
+			if ( !column.solid || (column.thinFloor && !touchThinFloor) )
+				continue;
+			
+			float top    = i * blockSize + column.topAt( f );
+			float bottom = i * blockSize + column.bottomAt( f );
+			
+			// Entirely above the span? (A thin floor counts as long as the
+			// span is on top of it; anything else, as long as the span
+			// touches it.)
+			if ( top < y && (column.thinFloor || bottom < y) )
+				continue;
+			
+			top = std::max( top, y );
+			if ( top <= ground ) {
+				ground = top;
+				found  = true;
+			}
+			return;
+		}
+	} );
+	
+	if ( found && height )
+		*height = ground;
+	
+	return found;
+	
+} // End of method: Room::groundHeight
+
+
+
+
+
+
+bool Room::ceilingHeight ( float x1, float x2, float y, float maxDistance, float * height ) const {
+	// Nothing but empty space above?
+	if ( regionEmpty( *this, x1, y - maxDistance, x2, y ) )
+		return false;
+	
+	float ceiling  = y - maxDistance;
+	bool  found    = false;
+	int   firstRow = std::min( (int) floorf( y / blockSize ), obstacleLayer.rows );
+	
+	visitSpan( *this, x1, x2, [&] ( int j, int px, float f ) {
+		// Walk up the pixel column, no further than the ceiling found so
+		// far:
+		for ( int i = firstRow; i >= -1 && (i + 1) * blockSize >= ceiling; i-- ) {
+			const RoomBlockGeometry::Column & column = columnAt( *this, i, j, px );
+			
+			if ( !column.solid || column.thinFloor )
+				continue;
+			
+			float top    = i * blockSize + column.topAt( f );
+			float bottom = i * blockSize + column.bottomAt( f );
+			
+			// Entirely below the span?
+			if ( top > y )
+				continue;
+			
+			bottom = std::min( bottom, y );
+			if ( bottom >= ceiling ) {
+				ceiling = bottom;
+				found   = true;
+			}
+			return;
+		}
+	} );
+	
+	if ( found && height )
+		*height = ceiling;
+	
+	return found;
+	
+} // End of method: Room::ceilingHeight
+
+
+
+
+
+
+bool Room::clearHeight ( float x1, float x2, float y, float maxDistance, float * height ) const {
+	float h      = y;
+	bool  lifted = false;
+	
+	// Rise to the top of every obstacle the span is stuck in. Once out of
+	// one, the span may be stuck in another one above it, so repeat until
+	// it's clear:
+	while ( !regionEmpty( *this, x1, h, x2, h ) ) {
+		float next  = h;
+		bool  stuck = false;
+		
+		visitSpan( *this, x1, x2, [&] ( int j, int px, float f ) {
+			int   i   = (int) floorf( h / blockSize );
+			float rel = h - i * blockSize;
+			
+			const RoomBlockGeometry::Column & column = columnAt( *this, i, j, px );
+			const RoomBlockGeometry::Column & above  = columnAt( *this, i - 1, j, px );
+			
+			bool solid = column.solid && !column.thinFloor;
+			
+			float top    = column.topAt( f );
+			float bottom = column.bottomAt( f );
+			
+			// Inside of the obstacle? (Like the point test, a full block
+			// includes its top side.)
+			bool inside = solid && ((top < rel && rel <= bottom) || (rel == 0 && top == 0 && bottom > 0));
+			
+			// Once lifted, the span has to go through whatever it touches
+			// from below, including the block above:
+			if ( lifted && rel == 0 && above.solid && !above.thinFloor && above.bottomAt( f ) >= blockSize ) {
+				i--;
+				top    = above.topAt( f );
+				inside = true;
+			}
+			
+			if ( !inside )
+				return;
+			
+			// Climb to the top of the obstacle, across the blocks it spans:
+			while ( top == 0 ) {
+				const RoomBlockGeometry::Column & upper = columnAt( *this, i - 1, j, px );
+				if ( !upper.solid || upper.thinFloor || upper.bottomAt( f ) < blockSize )
+					break;
+				
+				i--;
+				top = upper.topAt( f );
+			}
+			
+			next  = std::min( next, i * blockSize + top );
+			stuck = true;
+		} );
+		
+		// Clear already? (Stuck right on top of an obstacle, the span gets
+		// one more look, as if it had been lifted off it.)
+		if ( !stuck || (next == h && lifted) )
+			break;
+		
+		h      = next;
+		lifted = true;
+		
+		if ( y - h > maxDistance )
+			return false;
+	}
+	
+	if ( height )
+		*height = h;
+	
+	return true;
+	
+} // End of method: Room::clearHeight
+
+
+
+
+
+
+void Room::pointCollision ( const float * xs, const float * ys, int count, bool * hits ) const {
+	int k = 0;
+	
+#ifdef ROOM_USE_SSE2
+	// Four points at a time:
+	for ( ; k + 4 <= count; k += 4 ) {
+		int mask = pointCollision4( *this, _mm_loadu_ps( xs + k ), _mm_loadu_ps( ys + k ) );
+		
+		hits[k    ] = (mask & 1) != 0;
+		hits[k + 1] = (mask & 2) != 0;
+		hits[k + 2] = (mask & 4) != 0;
+		hits[k + 3] = (mask & 8) != 0;
+	}
+#endif
+	
+	// Remaining points:
+	for ( ; k < count; k++ )
+		hits[k] = pointCollision( xs[k], ys[k] );
+	
+} // End of method: Room::pointCollision (batched static points)
+
+
+
+
+
+
+void Room::pointCollision ( const float * x1s, const float * y1s, const float * x2s, const float * y2s, int count,
+                            bool touchThinFloor, bool * hits, Vector2D * contacts, Vector2D * normals ) const {
+	Vector2D contact, normal;
+	
+	for ( int k = 0; k < count; k++ ) {
+		hits[k] = pointCollision( x1s[k], y1s[k], x2s[k], y2s[k], touchThinFloor, &contact, &normal );
+		
+		if ( hits[k] ) {
+			if ( contacts )
+				contacts[k] = contact;
+			if ( normals )
+				normals[k] = normal;
+		}
+	}
+	
+} // End of method: Room::pointCollision (batched moving points)
+
+
+
+
+
+
+void Room::segmentCollision ( const float * x1s, const float * y1s, const float * x2s, const float * y2s, int count,
+                              bool touchThinFloor, bool * hits ) const {
+	int k = 0;
+	
+#ifdef ROOM_USE_SSE2
+	// Classify the extremities of four segments at a time; only the segments
+	// with both extremities outside the obstacle layer need to be walked.
+	for ( ; k + 4 <= count; k += 4 ) {
+		int mask = pointCollision4( *this, _mm_loadu_ps( x1s + k ), _mm_loadu_ps( y1s + k ) ) |
+		           pointCollision4( *this, _mm_loadu_ps( x2s + k ), _mm_loadu_ps( y2s + k ) );
+		
+		for ( int l = 0; l < 4; l++ ) {
+			int s = k + l;
+			hits[s] = ((mask >> l) & 1) != 0 ||
+			          segmentCrossesObstacle( x1s[s], y1s[s], x2s[s], y2s[s], touchThinFloor );
+		}
+	}
+#endif
+	
+	// Remaining segments:
+	for ( ; k < count; k++ )
+		hits[k] = segmentCollision( x1s[k], y1s[k], x2s[k], y2s[k], touchThinFloor );
+	
+} // End of method: Room::segmentCollision (batched static segments)
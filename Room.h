@@ -3,11 +3,13 @@
 
 
 #include "RoomBlock.h"
+#include "RoomBlockGeometry.h"
 #include "RoomBGLayer.h"
 
 #include "Container.h"
 
-#include "Matrix.h"
+#include "ObstacleGrid.h"
+#include "RoomEdgeMesh.h"
 #include "Vector2D.h"
 #include "Geom.h"
 
@@ -24,6 +26,81 @@ class Room
 public:
 	typedef std::unique_ptr<Room> Ptr;
 
+	/**
+	* Kinds of surfaces a swept box may run into, as seen from their
+	* normals.
+	*/
+	enum SlopeClass
+	{
+		/** Floors and ceilings. */
+		SLOPE_FLAT,
+		/** 26-degree slopes (two blocks wide, one block high). */
+		SLOPE_26,
+		/** 45-degree slopes. */
+		SLOPE_45,
+		/** Vertical surfaces. */
+		SLOPE_WALL,
+		/** Anything else, e.g. a contact averaged over two surfaces. */
+		SLOPE_OTHER
+	};
+
+	/**
+	* Result of a swept box query.
+	*
+	* @see boxSweep()
+	*/
+	struct SweepResult
+	{
+		/** The fraction of the displacement, in [0, 1], the box may move
+		* before it touches the obstacle layer. */
+		float time;
+
+		/** Where the box touched the obstacle layer. */
+		Vector2D contact;
+
+		/** Unit vector pointing away from the surface that was hit. */
+		Vector2D normal;
+
+		/** The kind of surface that was hit. */
+		SlopeClass slope;
+	};
+
+	/**
+	* Result of a raycast.
+	*
+	* @see raycast()
+	*/
+	struct RaycastResult
+	{
+		/** Distance from the ray's origin to the contact point. */
+		float distance;
+
+		/** Where the ray hit the obstacle layer. */
+		Vector2D contact;
+
+		/** Unit vector pointing away from the surface that was hit. */
+		Vector2D normal;
+
+		/** The type of the block that was hit. */
+		RoomBlock::Type block;
+	};
+
+	/**
+	* Scratch space for the collision queries that build temporary lists of
+	* contact points.
+	*
+	* The collision methods never modify the Room, so several threads may
+	* query the same Room at once, as long as each of them uses its own
+	* Scratch. Queries that are not given one use a thread-local instance.
+	*/
+	struct Scratch
+	{
+		Container<Vector2D> contactCandidates;
+		Container<Vector2D> normalCandidates;
+		Container<Vector2D> contacts;
+		Container<Vector2D> normals;
+	};
+
 	/** This room's obstacle block size, in pixels. */
 	const int blockSize;
 		
@@ -46,22 +123,39 @@ public:
 		
 	/** The room's obstacle matrix. Each cell represents a "block."
 	*/
-	Matrix<RoomBlock::Type> obstacleLayer;
+	ObstacleGrid obstacleLayer;
+		
+	/** The shapes of the obstacle blocks, precomputed for this room's
+	* block size. */
+	const RoomBlockGeometry blockGeometry;
+		
+	/** The outline of the obstacle layer, as fused edges; rebuilt by
+	* <tt>buildEdgeMesh()</tt>. */
+	RoomEdgeMesh edgeMesh;
 		
 		
 	/**
 	* @return This room's width, in pixels.
 	*/
-	inline int getPixelWidth () {
+	inline int getPixelWidth () const {
 		return obstacleLayer.columns * blockSize;
 	}
 
 	/**
 	* @return This room's height, in pixels.
 	*/
-	inline int getPixelHeight () {
+	inline int getPixelHeight () const {
 		return obstacleLayer.rows * blockSize;
 	}
+
+	/**
+	* @return true if the room's water surface lies within the room. Rooms
+	* without water have their level below the bottom; rooms filled with
+	* water have no surface, and don't count either.
+	*/
+	inline bool hasWater () const {
+		return waterLevel > 0 && waterLevel < getPixelHeight();
+	}
 		
 	/**
 	* @return The width of one screen in this room, in pixels.
@@ -86,7 +180,7 @@ public:
 	*         The collision of a single point against "thin floors" is
 	*         undefined, and therefore is not detected by this method.
 	*/
-	bool pointCollision ( float x, float y );
+	bool pointCollision ( float x, float y ) const;
 		
 	/**
 		* Tests the collision of a <em>moving</em> point against the obstacle
@@ -104,7 +198,7 @@ public:
 		* @return true if a collision occurred between point1 and point2.
 		*/
 	bool pointCollision ( float x1, float y1, float x2, float y2, bool touchThinFloor,
-		                    Vector2D * contact, Vector2D * normal );
+		                    Vector2D * contact, Vector2D * normal ) const;
 		
 		
 	/**
@@ -116,7 +210,7 @@ public:
 		* @return true If the segment is colliding is touching the obstacle
 		*         layer.
 		*/
-	bool segmentCollision ( float x1, float y1, float x2, float y2, bool touchThinFloor );
+	bool segmentCollision ( float x1, float y1, float x2, float y2, bool touchThinFloor ) const;
 		
 	/**
 		* Tests the collision of a moving segment against the obstacle layer.
@@ -143,10 +237,141 @@ public:
 		* The <tt>Container</tt>s will be emptied by invoking their
 		* <tt>removeAll()</tt> method before any parameters are inserted.
 		* 
+		* The candidate contacts are stored in <tt>scratch</tt>; if it is
+		* <tt>NULL</tt>, the calling thread's own scratch space is used.
+		* 
 		* @return true if a collision was detected.
 		*/
 	bool segmentCollision ( float x1, float y1, float x2, float y2, float dx, float dy, bool touchThinFloor,
-		                    Container<Vector2D> * contacts, Container<Vector2D> * normals, Vector2D * validDisplacement );
+		                    Container<Vector2D> * contacts, Container<Vector2D> * normals, Vector2D * validDisplacement,
+		                    Scratch * scratch = NULL ) const;
+		
+	/**
+		* Sweeps an axis-aligned box, delimited by <tt>left</tt>,
+		* <tt>top</tt>, <tt>right</tt> and <tt>bottom</tt>, along the
+		* displacement (dx, dy), in a single pass over the blocks in its way.
+		*
+		* Only the box's leading sides are tested, as those are the only ones
+		* that can run into the obstacle layer. The time of impact, contact,
+		* normal and kind of surface hit are stored in <tt>result</tt>, if it
+		* is not <tt>NULL</tt>.
+		*
+		* If <tt>touchThinFloor</tt> is false, thin floors will be ignored.
+		* <tt>scratch</tt> is used as in the moving segment test.
+		*
+		* While the edge mesh is up to date, the sides are swept against it
+		* instead of the blocks.
+		*
+		* @return true if the box would touch the obstacle layer along the
+		*         way.
+		*/
+	bool boxSweep ( float left, float top, float right, float bottom, float dx, float dy, bool touchThinFloor,
+		            SweepResult * result, Scratch * scratch = NULL ) const;
+		
+	/**
+		* Casts a ray from (x, y) in the direction (dirX, dirY), up to
+		* <tt>maxDistance</tt> pixels away, and finds the first obstacle it
+		* hits.
+		* 
+		* The blocks along the ray are visited in order, stepping to the
+		* nearest row or column boundary each time, so the cost depends only
+		* on the number of blocks crossed. Only the edges facing the ray may
+		* be hit; if <tt>touchThinFloor</tt> is false, thin floors will be
+		* ignored. A ray that starts inside an obstacle hits it at distance
+		* zero, with the normal pointing against the ray.
+		* 
+		* The hit's parameters are stored in <tt>result</tt>, if it is not
+		* <tt>NULL</tt>.
+		* 
+		* @return true if the ray hit the obstacle layer.
+		*/
+	bool raycast ( float x, float y, float dirX, float dirY, float maxDistance, bool touchThinFloor,
+		           RaycastResult * result ) const;
+		
+	/**
+		* Finds the ground under the horizontal span from <tt>x1</tt> to
+		* <tt>x2</tt>: the height at which the span, moving down from
+		* <tt>y</tt>, first touches the obstacle layer. If the span is
+		* already touching or inside an obstacle, that's <tt>y</tt> itself.
+		* 
+		* The blocks' column tables are read at both sides of every pixel
+		* column under the span, so no segment tests are needed; slopes are
+		* interpolated exactly. If <tt>touchThinFloor</tt> is false, thin
+		* floors will be ignored.
+		* 
+		* @return true if the ground lies within <tt>maxDistance</tt> pixels
+		*         below <tt>y</tt>; its height is then stored in
+		*         <tt>height</tt>.
+		*/
+	bool groundHeight ( float x1, float x2, float y, float maxDistance, bool touchThinFloor, float * height ) const;
+		
+	/**
+		* Finds the ceiling over the horizontal span from <tt>x1</tt> to
+		* <tt>x2</tt>: the height at which the span, moving up from
+		* <tt>y</tt>, first touches the obstacle layer. If the span is
+		* already touching or inside an obstacle, that's <tt>y</tt> itself.
+		* Thin floors never count, as with any upwards movement.
+		* 
+		* @return true if the ceiling lies within <tt>maxDistance</tt>
+		*         pixels above <tt>y</tt>; its height is then stored in
+		*         <tt>height</tt>.
+		*/
+	bool ceilingHeight ( float x1, float x2, float y, float maxDistance, float * height ) const;
+		
+	/**
+		* If the horizontal span from <tt>x1</tt> to <tt>x2</tt>, at height
+		* <tt>y</tt>, is stuck inside the obstacle layer, finds the surface of
+		* the obstacle: the lowest height above <tt>y</tt> at which the span
+		* is clear. Thin floors never count.
+		* 
+		* @return true if the span is clear at <tt>y</tt>, or becomes clear
+		*         within <tt>maxDistance</tt> pixels above it; the clear
+		*         height is then stored in <tt>height</tt>.
+		*/
+	bool clearHeight ( float x1, float x2, float y, float maxDistance, float * height ) const;
+		
+	/**
+		* Batched version of the static point test: tests <tt>count</tt>
+		* points, given as separate arrays of X and Y coordinates, and stores
+		* the results in <tt>hits</tt>.
+		* 
+		* On SSE2-capable builds, four points are classified at a time.
+		*/
+	void pointCollision ( const float * xs, const float * ys, int count, bool * hits ) const;
+		
+	/**
+		* Batched version of the moving point test: point <tt>k</tt> moves
+		* from (<tt>x1s[k]</tt>, <tt>y1s[k]</tt>) to (<tt>x2s[k]</tt>,
+		* <tt>y2s[k]</tt>).
+		* 
+		* The results are stored in <tt>hits</tt>; for every point that
+		* collided, the contact and normal are stored at the same index of
+		* <tt>contacts</tt> and <tt>normals</tt>, if these are not
+		* <tt>NULL</tt>. Entries for points that didn't collide are left
+		* unchanged.
+		*/
+	void pointCollision ( const float * x1s, const float * y1s, const float * x2s, const float * y2s, int count,
+		                    bool touchThinFloor, bool * hits, Vector2D * contacts, Vector2D * normals ) const;
+		
+	/**
+		* Batched version of the static segment test: segment <tt>k</tt> goes
+		* from (<tt>x1s[k]</tt>, <tt>y1s[k]</tt>) to (<tt>x2s[k]</tt>,
+		* <tt>y2s[k]</tt>). The results are stored in <tt>hits</tt>.
+		* 
+		* This is meant for objects that probe several segments per frame:
+		* the extremities of all segments are classified in one pass, and
+		* only the segments with both extremities outside the obstacle layer
+		* need to walk the blocks in between.
+		*/
+	void segmentCollision ( const float * x1s, const float * y1s, const float * x2s, const float * y2s, int count,
+		                    bool touchThinFloor, bool * hits ) const;
+		
+	/**
+		* Rebuilds <tt>edgeMesh</tt> from the obstacle layer. Call this once
+		* the obstacle layer is loaded, and again after editing it; until
+		* then, the sweeps fall back to testing the blocks.
+		*/
+	void buildEdgeMesh ();
 		
 	// Constructor: Creates an empty room.
 	// Water level is placed right below the room's lower border; object layer
@@ -157,6 +382,13 @@ public:
 	// Destructor: Deletes all BGLayers in this room.
 	virtual ~Room ();
 		
+private:
+	/**
+	* Walks the blocks between (x1, y1) and (x2, y2), testing the segment
+	* against their edges. The extremities themselves are not tested.
+	*/
+	bool segmentCrossesObstacle ( float x1, float y1, float x2, float y2, bool touchThinFloor ) const;
+		
 };
 
 #endif
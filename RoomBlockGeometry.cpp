@@ -0,0 +1,703 @@
+#include "RoomBlockGeometry.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 
+// Block descriptions:
+// 
+///////////////////////////////////////////////////////////////////////////////
+
+// Special half-plane descriptions: one which contains every point, and one
+// which contains none.
+#define PLANE_ALWAYS_ANCHOR (-1)
+#define PLANE_NEVER_ANCHOR  (-2)
+
+#define PLANE_ALWAYS { PLANE_ALWAYS_ANCHOR, 0, 0 }
+#define PLANE_NEVER  { PLANE_NEVER_ANCHOR,  0, 0 }
+
+
+// A half-plane crossing the anchor, tested as b * y > a * x + c:
+struct RoomBlockGeometry::PlaneDesc
+{
+	int   anchor;
+	float a, b;
+};
+
+struct RoomBlockGeometry::EdgeDesc
+{
+	Anchor p1, p2;
+	float  nx, ny;
+	bool   thinFloor;
+};
+
+// A corner's normals: vertical and horizontal segments use the first two;
+// segments parallel to the block's slope (if any) use the third, and
+// everything else uses the last one.
+struct RoomBlockGeometry::CornerDesc
+{
+	Anchor     point;
+	float      vertical[2];
+	float      horizontal[2];
+	AngleClass slope;
+	float      slopeNormal[2];
+	float      other[2];
+	bool       thinFloor;
+};
+
+struct RoomBlockGeometry::ShapeDesc
+{
+	bool       convex;
+	PlaneDesc  planes[2][2];
+	int        edgeCount;
+	EdgeDesc   edges[MAX_EDGES];
+	int        cornerCount;
+	CornerDesc corners[MAX_CORNERS];
+};
+
+
+// Transcribed from the original per-type collision tests, indexed by
+// (type - BLK_EMPTY). Edges are listed in the order the moving point tests
+// them; the second plane of a piece that only needs one is PLANE_ALWAYS, and
+// unused pieces are PLANE_NEVER.
+const RoomBlockGeometry::ShapeDesc RoomBlockGeometry::shapeDescs[SHAPE_COUNT] = {
+	// BLK_EMPTY:
+	{ false,
+	  { { PLANE_NEVER, PLANE_NEVER }, { PLANE_NEVER, PLANE_NEVER } },
+	  0, { },
+	  0, { } },
+
+	// BLK_SE_BLOCK:
+	{ true,
+	  { { { ANCHOR_CENTER,   -1,  0 }, { ANCHOR_CENTER,    0,  1 } },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_CENTER, ANCHOR_E,        0,  -1, false },
+	       { ANCHOR_CENTER, ANCHOR_S,       -1,   0, false },
+	       { ANCHOR_S,      ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_CENTER, { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_S,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_W_E_BOTTOM:
+	{ true,
+	  { { { ANCHOR_CENTER,    0,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_W,      ANCHOR_E,        0,  -1, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_SW_BLOCK:
+	{ true,
+	  { { { ANCHOR_CENTER,    1,  0 }, { ANCHOR_CENTER,    0,  1 } },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_W,      ANCHOR_CENTER,   0,  -1, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_S,        0,   1, false },
+	       { ANCHOR_S,      ANCHOR_CENTER,   1,   0, false } },
+	  4, { { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_CENTER, {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_S,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_NW_MISSING:
+	{ false,
+	  { { { ANCHOR_CENTER,   -1,  0 }, PLANE_ALWAYS },
+	    { { ANCHOR_CENTER,    0,  1 }, PLANE_ALWAYS } },
+	  6, { { ANCHOR_N,      ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_W,      ANCHOR_CENTER,   0,  -1, false },
+	       { ANCHOR_SW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_CENTER, ANCHOR_N,       -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_NE,       1,   0, false } },
+	  5, { { ANCHOR_N,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_NE_MISSING:
+	{ false,
+	  { { { ANCHOR_CENTER,    1,  0 }, PLANE_ALWAYS },
+	    { { ANCHOR_CENTER,    0,  1 }, PLANE_ALWAYS } },
+	  6, { { ANCHOR_NW,     ANCHOR_N,        0,  -1, false },
+	       { ANCHOR_CENTER, ANCHOR_E,        0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_N,      ANCHOR_CENTER,   1,   0, false },
+	       { ANCHOR_E,      ANCHOR_SE,       1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_N,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_SW_NE_BOTTOM:
+	{ true,
+	  { { { ANCHOR_SW,      -1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_SW,     ANCHOR_NE,      -1,  -1, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_NE,       1,   0, false } },
+	  3, { { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_45,    { -1, -1 }, { 0.382683f, -0.92388f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_45,    { -1, -1 }, { -0.92388f, 0.382683f }, false } } },
+
+	// BLK_NW_SE_BOTTOM:
+	{ true,
+	  { { { ANCHOR_NW,       1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_NW,     ANCHOR_SE,       1,  -1, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SW,     ANCHOR_NW,      -1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_135,   {  1, -1 }, { -0.382683f, -0.92388f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_135,   {  1, -1 }, { 0.92388f, 0.382683f }, false } } },
+
+	// BLK_SW_E_BOTTOM:
+	{ true,
+	  { { { ANCHOR_SW,    -0.5f,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_SW,     ANCHOR_E,       -1,  -2, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_E,        1,   0, false } },
+	  3, { { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_26,    { -1, -2 }, { 0.525731f, -0.850651f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_26,    { -1, -2 }, { -0.973249f, 0.229753f }, false } } },
+
+	// BLK_W_NE_BOTTOM:
+	{ true,
+	  { { { ANCHOR_W,     -0.5f,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_W,      ANCHOR_NE,      -1,  -2, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_NE,       1,   0, false } },
+	  4, { { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_26,    { -1, -2 }, { 0.525731f, -0.850651f }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_26,    { -1, -2 }, { -0.850651f, -0.525731f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_NW_E_BOTTOM:
+	{ true,
+	  { { { ANCHOR_NW,    0.5f,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_NW,     ANCHOR_E,        1,  -2, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_154,   {  1, -2 }, { -0.525731f, -0.850651f }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_154,   {  1, -2 }, { 0.850651f, -0.525731f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_W_SE_BOTTOM:
+	{ true,
+	  { { { ANCHOR_W,     0.5f,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_W,      ANCHOR_SE,       1,  -2, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false } },
+	  3, { { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_154,   {  1, -2 }, { -0.525731f, -0.850651f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_154,   {  1, -2 }, { 0.973249f, 0.229753f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_N_S_RIGHT:
+	{ true,
+	  { { { ANCHOR_CENTER,   -1,  0 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_N,      ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_N,      ANCHOR_S,       -1,   0, false },
+	       { ANCHOR_S,      ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  4, { { ANCHOR_N,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_S,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_FULL:
+	{ true,
+	  { { PLANE_ALWAYS, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_N_S_LEFT:
+	{ true,
+	  { { { ANCHOR_CENTER,    1,  0 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_NW,     ANCHOR_N,        0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_S,        0,   1, false },
+	       { ANCHOR_N,      ANCHOR_S,        1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_N,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_S,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_SW_MISSING:
+	{ false,
+	  { { { ANCHOR_CENTER,   -1,  0 }, PLANE_ALWAYS },
+	    { { ANCHOR_CENTER,    0, -1 }, PLANE_ALWAYS } },
+	  6, { { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_CENTER, ANCHOR_S,       -1,   0, false },
+	       { ANCHOR_W,      ANCHOR_CENTER,   0,   1, false },
+	       { ANCHOR_S,      ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false },
+	       { ANCHOR_S,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_SE_MISSING:
+	{ false,
+	  { { { ANCHOR_CENTER,    1,  0 }, PLANE_ALWAYS },
+	    { { ANCHOR_CENTER,    0, -1 }, PLANE_ALWAYS } },
+	  6, { { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_S,        0,   1, false },
+	       { ANCHOR_CENTER, ANCHOR_E,        0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false },
+	       { ANCHOR_CENTER, ANCHOR_S,        1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_S,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_NW_SE_TOP:
+	{ true,
+	  { { { ANCHOR_NW,      -1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_NW,     ANCHOR_SE,      -1,   1, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_SE,     ANCHOR_NE,       1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_135,   { -1,  1 }, { -0.92388f, -0.382683f }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_135,   { -1,  1 }, { 0.382683f, 0.92388f }, false } } },
+
+	// BLK_SW_NE_TOP:
+	{ true,
+	  { { { ANCHOR_SW,       1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_SW,     ANCHOR_NE,       1,   1, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_SW,     ANCHOR_NW,      -1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_45,    {  1,  1 }, { 0.92388f, -0.382683f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_45,    {  1,  1 }, { -0.382683f, 0.92388f }, false } } },
+
+	// BLK_NW_E_TOP:
+	{ true,
+	  { { { ANCHOR_NW,    -0.5f, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_NW,     ANCHOR_E,       -1,   2, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_154,   { -1,  2 }, { -0.973249f, -0.229753f }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_154,   { -1,  2 }, { 0.525731f, 0.850651f }, false } } },
+
+	// BLK_W_SE_TOP:
+	{ true,
+	  { { { ANCHOR_W,     -0.5f, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_W,      ANCHOR_SE,      -1,   2, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_154,   { -1,  2 }, { -0.850651f, 0.525731f }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_154,   { -1,  2 }, { 0.525731f, 0.850651f }, false } } },
+
+	// BLK_SW_E_TOP:
+	{ true,
+	  { { { ANCHOR_SW,    0.5f, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_SW,     ANCHOR_E,        1,   2, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_26,    {  1,  2 }, { 0.850651f, 0.525731f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_26,    {  1,  2 }, { -0.525731f, 0.850651f }, false } } },
+
+	// BLK_W_NE_TOP:
+	{ true,
+	  { { { ANCHOR_W,     0.5f, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_W,      ANCHOR_NE,       1,   2, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_26,    {  1,  2 }, { 0.973249f, -0.229753f }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_26,    {  1,  2 }, { -0.525731f, 0.850651f }, false } } },
+
+	// BLK_NE_BLOCK:
+	{ true,
+	  { { { ANCHOR_CENTER,   -1,  0 }, { ANCHOR_CENTER,    0, -1 } },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_N,      ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_N,      ANCHOR_CENTER,  -1,   0, false },
+	       { ANCHOR_CENTER, ANCHOR_E,        0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_N,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_CENTER, { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_W_E_TOP:
+	{ true,
+	  { { { ANCHOR_CENTER,    0, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_W,      ANCHOR_E,        0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_NW_BLOCK:
+	{ true,
+	  { { { ANCHOR_CENTER,    1,  0 }, { ANCHOR_CENTER,    0, -1 } },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  4, { { ANCHOR_NW,     ANCHOR_N,        0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_W,      ANCHOR_CENTER,   0,   1, false },
+	       { ANCHOR_N,      ANCHOR_CENTER,   1,   0, false } },
+	  4, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_N,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_CENTER, {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_S_E_BOTTOM:
+	{ true,
+	  { { { ANCHOR_S,       -1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_S,      ANCHOR_E,       -1,  -1, false },
+	       { ANCHOR_S,      ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_SE,     ANCHOR_E,        1,   0, false } },
+	  3, { { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_45,    { -1, -1 }, { 0.382683f, -0.92388f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_S,      { -1,  0 }, {  0,  1 }, ANGLE_45,    { -1, -1 }, { -0.92388f, 0.382683f }, false } } },
+
+	// BLK_W_N_BOTTOM:
+	{ true,
+	  { { { ANCHOR_W,       -1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  5, { { ANCHOR_W,      ANCHOR_N,       -1,  -1, false },
+	       { ANCHOR_N,      ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  5, { { ANCHOR_N,      { -1,  0 }, {  0, -1 }, ANGLE_45,    { -1, -1 }, { -0.382683f, -0.92388f }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_45,    { -1, -1 }, { -0.92388f, -0.382683f }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_N_E_BOTTOM:
+	{ true,
+	  { { { ANCHOR_N,        1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  5, { { ANCHOR_N,      ANCHOR_E,        1,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_N,        0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_E,      ANCHOR_SE,       1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_N,      {  1,  0 }, {  0, -1 }, ANGLE_135,   {  1, -1 }, { 0.382683f, -0.92388f }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_135,   {  1, -1 }, { 0.92388f, -0.382683f }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_W_S_BOTTOM:
+	{ true,
+	  { { { ANCHOR_W,        1,  1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_W,      ANCHOR_S,        1,  -1, false },
+	       { ANCHOR_W,      ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_S,        0,   1, false } },
+	  3, { { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_135,   {  1, -1 }, { -0.382683f, -0.92388f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false },
+	       { ANCHOR_S,      {  1,  0 }, {  0,  1 }, ANGLE_135,   {  1, -1 }, { 0.92388f, 0.382683f }, false } } },
+
+	// BLK_N_E_TOP:
+	{ true,
+	  { { { ANCHOR_N,       -1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_N,      ANCHOR_E,       -1,   1, false },
+	       { ANCHOR_N,      ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  3, { { ANCHOR_N,      { -1,  0 }, {  0, -1 }, ANGLE_135,   { -1,  1 }, { -0.92388f, -0.382683f }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_135,   { -1,  1 }, { 0.382683f, 0.92388f }, false } } },
+
+	// BLK_W_S_TOP:
+	{ true,
+	  { { { ANCHOR_W,       -1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  5, { { ANCHOR_W,      ANCHOR_S,       -1,   1, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false },
+	       { ANCHOR_S,      ANCHOR_SE,       0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_SE,       1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_SE,     {  1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { 1, 1 }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_135,   { -1,  1 }, { -0.92388f, 0.382683f }, false },
+	       { ANCHOR_S,      { -1,  0 }, {  0,  1 }, ANGLE_135,   { -1,  1 }, { -0.382683f, 0.92388f }, false } } },
+
+	// BLK_S_E_TOP:
+	{ true,
+	  { { { ANCHOR_S,        1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  5, { { ANCHOR_S,      ANCHOR_E,        1,   1, false },
+	       { ANCHOR_NW,     ANCHOR_NE,       0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_SW,      -1,   0, false },
+	       { ANCHOR_SW,     ANCHOR_S,        0,   1, false },
+	       { ANCHOR_NE,     ANCHOR_E,        1,   0, false } },
+	  5, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, false },
+	       { ANCHOR_S,      {  1,  0 }, {  0,  1 }, ANGLE_45,    {  1,  1 }, { 0.92388f, 0.382683f }, false },
+	       { ANCHOR_E,      {  1,  0 }, {  0,  1 }, ANGLE_45,    {  1,  1 }, { 0.92388f, 0.382683f }, false },
+	       { ANCHOR_SW,     { -1,  0 }, {  0,  1 }, ANGLE_OTHER, {  0,  0 }, { -1, 1 }, false } } },
+
+	// BLK_W_N_TOP:
+	{ true,
+	  { { { ANCHOR_W,        1, -1 }, PLANE_ALWAYS },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  3, { { ANCHOR_W,      ANCHOR_N,        1,   1, false },
+	       { ANCHOR_NW,     ANCHOR_N,        0,  -1, false },
+	       { ANCHOR_NW,     ANCHOR_W,       -1,   0, false } },
+	  3, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, false },
+	       { ANCHOR_N,      {  1,  0 }, {  0, -1 }, ANGLE_45,    {  1,  1 }, { 0.92388f, -0.382683f }, false },
+	       { ANCHOR_W,      { -1,  0 }, {  0,  1 }, ANGLE_45,    {  1,  1 }, { -0.382683f, 0.92388f }, false } } },
+
+	// BLK_THINFLOOR_HI:
+	{ true,
+	  { { PLANE_NEVER, PLANE_NEVER },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  1, { { ANCHOR_NW,     ANCHOR_NE,       0,  -1, true } },
+	  2, { { ANCHOR_NW,     { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, true },
+	       { ANCHOR_NE,     {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, true } } },
+
+	// BLK_THINFLOOR_MID:
+	{ true,
+	  { { PLANE_NEVER, PLANE_NEVER },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  1, { { ANCHOR_W,      ANCHOR_E,        0,  -1, true } },
+	  2, { { ANCHOR_W,      { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, true },
+	       { ANCHOR_E,      {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, true } } },
+
+	// BLK_THINFLOOR_LO:
+	{ true,
+	  { { PLANE_NEVER, PLANE_NEVER },
+	    { PLANE_NEVER, PLANE_NEVER } },
+	  1, { { ANCHOR_SW_THIN, ANCHOR_SE_THIN,   0,  -1, true } },
+	  2, { { ANCHOR_SW_THIN, { -1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { -1, -1 }, true },
+	       { ANCHOR_SE_THIN, {  1,  0 }, {  0, -1 }, ANGLE_OTHER, {  0,  0 }, { 1, -1 }, true } } }
+};
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 
+// Public methods:
+// 
+///////////////////////////////////////////////////////////////////////////////
+
+RoomBlockGeometry::RoomBlockGeometry ( int blockSize ) {
+	// Same rounding as the block coordinates have always used:
+	anchors[ANCHOR_NW]      = Vector2D( 0,             0             );
+	anchors[ANCHOR_N]       = Vector2D( blockSize / 2, 0             );
+	anchors[ANCHOR_NE]      = Vector2D( blockSize,     0             );
+	anchors[ANCHOR_E]       = Vector2D( blockSize,     blockSize / 2 );
+	anchors[ANCHOR_SE]      = Vector2D( blockSize,     blockSize     );
+	anchors[ANCHOR_S]       = Vector2D( blockSize / 2, blockSize     );
+	anchors[ANCHOR_SW]      = Vector2D( 0,             blockSize     );
+	anchors[ANCHOR_W]       = Vector2D( 0,             blockSize / 2 );
+	anchors[ANCHOR_CENTER]  = Vector2D( blockSize / 2, blockSize / 2 );
+	anchors[ANCHOR_SW_THIN] = Vector2D( 0,             blockSize - 1 );
+	anchors[ANCHOR_SE_THIN] = Vector2D( blockSize,     blockSize - 1 );
+	
+	for ( int s = 0; s < SHAPE_COUNT; s++ ) {
+		const ShapeDesc & desc  = shapeDescs[s];
+		Shape           & shape = shapes[s];
+		
+		shape.convex = desc.convex;
+		
+		// Half-planes:
+		for ( int p = 0; p < 4; p++ ) {
+			const PlaneDesc & pd    = desc.planes[p / 2][p % 2];
+			HalfPlane       & plane = shape.planes[p];
+			
+			plane.a = pd.a;
+			plane.b = pd.b;
+			
+			if ( pd.anchor == PLANE_ALWAYS_ANCHOR )
+				plane.c = -FLT_MAX;
+			else if ( pd.anchor == PLANE_NEVER_ANCHOR )
+				plane.c = FLT_MAX;
+			else {
+				// The line crosses the anchor:
+				const Vector2D & at = anchors[pd.anchor];
+				plane.c = pd.b * at.y - pd.a * at.x;
+			}
+		}
+		
+		// Edges:
+		shape.edgeCount = desc.edgeCount;
+		for ( int e = 0; e < desc.edgeCount; e++ ) {
+			const EdgeDesc & ed   = desc.edges[e];
+			Edge           & edge = shape.edges[e];
+			
+			edge.p1        = anchors[ed.p1];
+			edge.p2        = anchors[ed.p2];
+			edge.normal    = Vector2D( ed.nx, ed.ny ).unit();
+			edge.thinFloor = ed.thinFloor;
+		}
+		
+		// Corners:
+		shape.cornerCount = desc.cornerCount;
+		for ( int c = 0; c < desc.cornerCount; c++ ) {
+			const CornerDesc & cd     = desc.corners[c];
+			Corner           & corner = shape.corners[c];
+			
+			corner.point     = anchors[cd.point];
+			corner.thinFloor = cd.thinFloor;
+			
+			for ( int a = 0; a < ANGLE_CLASS_COUNT; a++ )
+				corner.normals[a] = Vector2D( cd.other[0], cd.other[1] ).unit();
+			
+			corner.normals[ANGLE_VERTICAL]   = Vector2D( cd.vertical[0],   cd.vertical[1]   ).unit();
+			corner.normals[ANGLE_HORIZONTAL] = Vector2D( cd.horizontal[0], cd.horizontal[1] ).unit();
+			
+			if ( cd.slope != ANGLE_OTHER )
+				corner.normals[cd.slope] = Vector2D( cd.slopeNormal[0], cd.slopeNormal[1] ).unit();
+		}
+	}
+	
+	// Pixel columns:
+	columnsPerShape = blockSize;
+	columns.resize( SHAPE_COUNT * blockSize );
+	
+	for ( int s = 0; s < SHAPE_COUNT; s++ ) {
+		const Shape & shape = shapes[s];
+		
+		for ( int px = 0; px < blockSize; px++ ) {
+			Column & column = columns[s * blockSize + px];
+			
+			column.solid     = false;
+			column.thinFloor = false;
+			
+			// Thin floors are nothing but their edge:
+			if ( shape.edgeCount == 1 && shape.edges[0].thinFloor ) {
+				column.solid     = true;
+				column.thinFloor = true;
+				column.top[0]    = column.top[1]    = shape.edges[0].p1.y;
+				column.bottom[0] = column.bottom[1] = shape.edges[0].p1.y;
+				continue;
+			}
+			
+			// Intersect the column with each piece's half-planes; the planes
+			// are straight lines, so bounding the piece at both sides of the
+			// column is enough. Whether the piece is there at all is decided
+			// at the column's center, as vertical planes always lie on a
+			// column's side.
+			for ( int p = 0; p < 4; p += 2 ) {
+				float top[3], bottom[3];
+				bool  present = true;
+				
+				for ( int side = 0; side < 3; side++ ) {
+					float x = px + (side == 2 ? 0.5f : (float) side);
+					
+					top[side]    = 0;
+					bottom[side] = (float) blockSize;
+					
+					for ( int k = p; k < p + 2; k++ ) {
+						const HalfPlane & plane = shape.planes[k];
+						
+						if ( plane.b > 0 )
+							top[side]    = std::max( top[side],    (plane.a * x + plane.c) / plane.b );
+						else if ( plane.b < 0 )
+							bottom[side] = std::min( bottom[side], (plane.a * x + plane.c) / plane.b );
+						else if ( side == 2 && !(0 > plane.a * x + plane.c) )
+							present = false;
+					}
+				}
+				
+				if ( !present || top[2] >= bottom[2] )
+					continue;
+				
+				// The pieces of a block are stacked, so the column's solid
+				// part goes from the highest top to the lowest bottom:
+				for ( int side = 0; side < 2; side++ ) {
+					if ( !column.solid ) {
+						column.top[side]    = top[side];
+						column.bottom[side] = bottom[side];
+					}
+					else {
+						column.top[side]    = std::min( column.top[side],    top[side] );
+						column.bottom[side] = std::max( column.bottom[side], bottom[side] );
+					}
+				}
+				
+				column.solid = true;
+			}
+		}
+	}
+} // End of constructor: RoomBlockGeometry
+
+
+
+
+RoomBlockGeometry::AngleClass RoomBlockGeometry::angleClass ( float degrees ) {
+	static const float margin = 1.0f;
+	
+	// The class's two (opposite) angles:
+	static const float classAngles[ANGLE_OTHER][2] = {
+		{   0, 180 },    // ANGLE_HORIZONTAL
+		{  90, 270 },    // ANGLE_VERTICAL
+		{  45, 225 },    // ANGLE_45
+		{ 135, 315 },    // ANGLE_135
+		{  26, 206 },    // ANGLE_26
+		{ 154, 334 }     // ANGLE_154
+	};
+	
+	// Vertical segments take precedence over horizontal ones:
+	static const AngleClass order[ANGLE_OTHER] = {
+		ANGLE_VERTICAL, ANGLE_HORIZONTAL, ANGLE_45, ANGLE_135, ANGLE_26, ANGLE_154
+	};
+	
+	for ( int i = 0; i < ANGLE_OTHER; i++ ) {
+		const float * angles = classAngles[order[i]];
+		
+		if ( fabsf( degrees - angles[0] ) <= margin || fabsf( degrees - angles[1] ) <= margin )
+			return order[i];
+	}
+	
+	return ANGLE_OTHER;
+} // End of method: RoomBlockGeometry::angleClass
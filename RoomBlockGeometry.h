@@ -0,0 +1,234 @@
+#ifndef _RoomBlockGeometry_h_
+#define _RoomBlockGeometry_h_
+
+
+#include "RoomBlock.h"
+#include "Vector2D.h"
+
+#include <vector>
+
+/**
+* Precomputed description of every obstacle block's shape, for a given
+* block size.
+*
+* Each <tt>RoomBlock::Type</tt> is described by three tables, all of them
+* relative to the block's top-left corner:
+* - Up to four half-planes, arranged as two pieces of two half-planes
+*   each. A point lies inside the block if it lies inside both half-planes
+*   of either piece.
+* - The block's edges, each with its outward-facing unit normal.
+* - The block's corners, each with the normal to be reported when a
+*   moving segment touches it, depending on the segment's slope.
+* - For every pixel column, where the block's solid part begins and ends,
+*   so that floors and ceilings can be found without any segment tests.
+*
+* The tables are built once, when the <tt>Room</tt> is created, so the
+* collision methods can loop over them instead of switching on the block
+* type.
+*
+* @see Room
+*/
+class RoomBlockGeometry
+{
+public:
+	/** Maximum number of edges and corners in a single block. */
+	static const int MAX_EDGES   = 6;
+	static const int MAX_CORNERS = 6;
+
+	/** Number of block types, including <tt>BLK_EMPTY</tt>. */
+	static const int SHAPE_COUNT = RoomBlock::BLK_THINFLOOR_LO - RoomBlock::BLK_EMPTY + 1;
+
+	/**
+	* Points of interest inside of a block. <tt>ANCHOR_SW_THIN</tt> and
+	* <tt>ANCHOR_SE_THIN</tt> lie one pixel above the block's bottom, which
+	* is where the low thin floor is placed.
+	*/
+	enum Anchor
+	{
+		ANCHOR_NW,
+		ANCHOR_N,
+		ANCHOR_NE,
+		ANCHOR_E,
+		ANCHOR_SE,
+		ANCHOR_S,
+		ANCHOR_SW,
+		ANCHOR_W,
+		ANCHOR_CENTER,
+		ANCHOR_SW_THIN,
+		ANCHOR_SE_THIN,
+		ANCHOR_COUNT
+	};
+
+	/**
+	* Classes of segment slopes; the normal reported at a block corner
+	* depends on which class the colliding segment belongs to.
+	*
+	* @see angleClass()
+	*/
+	enum AngleClass
+	{
+		ANGLE_HORIZONTAL,
+		ANGLE_VERTICAL,
+		ANGLE_45,
+		ANGLE_135,
+		ANGLE_26,
+		ANGLE_154,
+		ANGLE_OTHER,
+		ANGLE_CLASS_COUNT
+	};
+
+	/**
+	* A half-plane, tested as <tt>b * y > a * x + c</tt>.
+	*/
+	struct HalfPlane
+	{
+		float a, b, c;
+
+		inline bool contains ( float x, float y ) const {
+			return b * y > a * x + c;
+		}
+	};
+
+	/**
+	* One of a block's edges, from <tt>p1</tt> to <tt>p2</tt>.
+	*/
+	struct Edge
+	{
+		Vector2D p1, p2;
+
+		/** Unit vector pointing away from the block. */
+		Vector2D normal;
+
+		/** Thin floors are only solid for objects falling onto them. */
+		bool thinFloor;
+	};
+
+	/**
+	* One of a block's corners.
+	*/
+	struct Corner
+	{
+		Vector2D point;
+
+		/** The normal to use for each class of segment slope. */
+		Vector2D normals[ANGLE_CLASS_COUNT];
+
+		bool thinFloor;
+	};
+
+	/**
+	* The solid part of a block's pixel column, from <tt>top</tt> to
+	* <tt>bottom</tt>. Both are given at the column's left (index 0) and
+	* right (index 1) sides, so that slopes can be interpolated inside the
+	* column. Thin floors have no thickness: <tt>top</tt> and
+	* <tt>bottom</tt> are the same.
+	*/
+	struct Column
+	{
+		bool  solid;
+		bool  thinFloor;
+		float top[2], bottom[2];
+
+		inline float topAt ( float f ) const {
+			return top[0] + (top[1] - top[0]) * f;
+		}
+
+		inline float bottomAt ( float f ) const {
+			return bottom[0] + (bottom[1] - bottom[0]) * f;
+		}
+	};
+
+	/**
+	* The complete description of a block type.
+	*/
+	struct Shape
+	{
+		/** Convex shapes can be entered through a single edge. */
+		bool convex;
+
+		/** Two pieces of two half-planes each: planes[0..1] and
+		* planes[2..3]. */
+		HalfPlane planes[4];
+
+		int  edgeCount;
+		Edge edges[MAX_EDGES];
+
+		int    cornerCount;
+		Corner corners[MAX_CORNERS];
+
+		/**
+		* Tests a point, relative to the block's top-left corner.
+		*/
+		inline bool contains ( float x, float y ) const {
+			return (planes[0].contains( x, y ) & planes[1].contains( x, y )) |
+			       (planes[2].contains( x, y ) & planes[3].contains( x, y ));
+		}
+	};
+
+
+	/**
+	* Builds the tables for the specified block size, in pixels.
+	*/
+	RoomBlockGeometry ( int blockSize );
+
+	/**
+	* @return The shape of the specified block type. Unknown types are
+	*         treated as <tt>BLK_EMPTY</tt>.
+	*/
+	inline const Shape & shape ( RoomBlock::Type type ) const {
+		int index = (int) type - RoomBlock::BLK_EMPTY;
+
+		if ( index < 0 || index >= SHAPE_COUNT )
+			index = 0;
+
+		return shapes[index];
+	}
+
+	/**
+	* @return The block's pixel column <tt>px</tt>, counting from the
+	*         block's left side (0 to <tt>blockSize - 1</tt>).
+	*/
+	inline const Column & column ( RoomBlock::Type type, int px ) const {
+		int index = (int) type - RoomBlock::BLK_EMPTY;
+
+		if ( index < 0 || index >= SHAPE_COUNT )
+			index = 0;
+
+		return columns[index * columnsPerShape + px];
+	}
+
+	/**
+	* @return The anchor's position relative to the block's top-left
+	*         corner.
+	*/
+	inline const Vector2D & anchor ( Anchor a ) const {
+		return anchors[a];
+	}
+
+	/**
+	* Classifies a segment's slope, given its angle in degrees (as in
+	* 0 = pointing right, 90 = pointing up), with a 1 degree tolerance.
+	*/
+	static AngleClass angleClass ( float degrees );
+
+private:
+	struct PlaneDesc;
+	struct EdgeDesc;
+	struct CornerDesc;
+	struct ShapeDesc;
+
+	/** The per-type descriptions the tables are built from. */
+	static const ShapeDesc shapeDescs[SHAPE_COUNT];
+
+	Vector2D anchors[ANCHOR_COUNT];
+
+	Shape shapes[SHAPE_COUNT];
+
+	/** One column per pixel of the block size the tables were built for. */
+	int columnsPerShape;
+
+	std::vector<Column> columns;
+
+};
+
+#endif
@@ -0,0 +1,746 @@
+#include "RoomEdgeMesh.h"
+#include "Def.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <map>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Helpers:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Tolerance when fusing collinear edges, in pixels:
+static const float MERGE_TOLERANCE = 1e-3f;
+
+
+static inline float cross ( const Vector2D & a, const Vector2D & b ) {
+	return a.x * b.y - a.y * b.x;
+} // End of function: cross
+
+
+// A block edge, moved to world coordinates and described relative to the
+// line it lies on.
+struct LineEdge
+{
+	// The line: Quantized canonical normal and offset, for grouping.
+	int qnx, qny, qc;
+	bool thinFloor;
+
+	// The line's canonical normal and exact offset:
+	Vector2D lineNormal;
+	float    offset;
+
+	// The edge's extent along the line, and which way it faces (+1 if its
+	// normal is the canonical one, -1 otherwise):
+	float u1, u2;
+	int   side;
+
+	inline bool operator < ( const LineEdge & that ) const {
+		if ( thinFloor != that.thinFloor ) return thinFloor < that.thinFloor;
+		if ( qnx != that.qnx ) return qnx < that.qnx;
+		if ( qny != that.qny ) return qny < that.qny;
+		return qc < that.qc;
+	}
+
+	inline bool sameLine ( const LineEdge & that ) const {
+		return thinFloor == that.thinFloor && qnx == that.qnx && qny == that.qny && qc == that.qc;
+	}
+};
+
+
+// The start or end of an edge's extent along its line:
+struct LineEvent
+{
+	float u;
+	int   side;
+	int   delta;
+
+	inline bool operator < ( const LineEvent & that ) const {
+		return u < that.u;
+	}
+};
+
+
+// Finds where the ray origin + t * dir (t in [0, 1]) crosses the segment
+// a..b, with some tolerance at the segment's extremities:
+static inline bool rayHit ( const Vector2D & origin, const Vector2D & dir, const Vector2D & a, const Vector2D & b,
+                            float tolerance, float * t ) {
+	Vector2D e = b - a;
+	float den  = cross( dir, e );
+
+	// Parallel: Can't run into it.
+	if ( fabsf( den ) < 1e-9f )
+		return false;
+
+	Vector2D w = a - origin;
+	float time = cross( w, e ) / den;
+	float s    = cross( w, dir ) / den;
+
+	float sTolerance = tolerance / e.length();
+
+	if ( time < -tolerance || time > 1.0f || s < -sTolerance || s > 1.0f + sTolerance )
+		return false;
+
+	*t = std::max( time, 0.0f );
+	return true;
+
+} // End of function: rayHit
+
+
+// A box moving by (dx, dy):
+struct SweptBox
+{
+	float minX, minY, maxX, maxY;
+	float dx, dy;
+
+	// Finds the fraction of the displacement at which the box starts
+	// overlapping the node's bounds; -1 if that doesn't happen until
+	// maxTime.
+	template <class Bounds>
+	inline float enterTime ( const Bounds & b, float maxTime ) const {
+		float enter = 0, exit = maxTime;
+
+		if ( !axis( minX, maxX, dx, b.minX, b.maxX, enter, exit ) ||
+		     !axis( minY, maxY, dy, b.minY, b.maxY, enter, exit ) )
+			return -1;
+
+		return enter;
+	}
+
+	static inline bool axis ( float lo, float hi, float d, float bLo, float bHi, float & enter, float & exit ) {
+		if ( d == 0 )
+			return hi >= bLo && lo <= bHi;
+
+		float t0 = (bLo - hi) / d;
+		float t1 = (bHi - lo) / d;
+		if ( t0 > t1 )
+			std::swap( t0, t1 );
+
+		enter = std::max( enter, t0 );
+		exit  = std::min( exit,  t1 );
+		return enter <= exit;
+	}
+};
+
+
+// An edge of an outline, going from one vertex to another with the solid
+// side on its right:
+struct OutlineEdge
+{
+	int      from, to;
+	Vector2D dir;
+	bool     used;
+};
+
+
+// Cell size of the vertex buckets used to find T-junctions, in pixels:
+static const float VERTEX_CELL = 64.0f;
+
+
+// Where vertices are looked up; points closer than 1/16 of a pixel are the
+// same vertex:
+static inline std::pair<int, int> vertexKey ( const Vector2D & p ) {
+	return std::make_pair( (int) floorf( p.x * 16 + 0.5f ), (int) floorf( p.y * 16 + 0.5f ) );
+} // End of function: vertexKey
+
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// RoomEdgeMesh:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+RoomEdgeMesh::RoomEdgeMesh () {
+	built   = false;
+	version = 0;
+
+} // End of method: RoomEdgeMesh::RoomEdgeMesh
+
+
+
+
+
+
+void RoomEdgeMesh::build ( const ObstacleGrid & grid, const RoomBlockGeometry & geometry, int blockSize ) {
+	edges.clear();
+	pieces.clear();
+	nodes.clear();
+
+	// Gather every block's edges, and sort them by the line they lie on:
+	std::vector<LineEdge> lineEdges;
+
+	for ( int i = 0; i < grid.rows; i++ ) {
+		for ( int j = 0; j < grid.columns; j++ ) {
+			const RoomBlockGeometry::Shape & shape = geometry.shape( grid.at( i, j ) );
+			Vector2D blk = Vector2D( j * blockSize, i * blockSize );
+
+			for ( int e = 0; e < shape.edgeCount; e++ ) {
+				const Edge & edge = shape.edges[e];
+				LineEdge le;
+
+				// Canonical normals point downwards, or to the right if
+				// horizontal:
+				le.side = (edge.normal.y > 1e-4f || (fabsf( edge.normal.y ) <= 1e-4f && edge.normal.x > 0)) ? 1 : -1;
+				le.lineNormal = edge.normal * (float) le.side;
+
+				Vector2D p1      = blk + edge.p1;
+				Vector2D p2      = blk + edge.p2;
+				Vector2D tangent = Vector2D( -le.lineNormal.y, le.lineNormal.x );
+
+				le.offset = le.lineNormal * p1;
+				le.u1     = tangent * p1;
+				le.u2     = tangent * p2;
+				if ( le.u1 > le.u2 )
+					std::swap( le.u1, le.u2 );
+
+				le.qnx       = (int) floorf( le.lineNormal.x * 1024 + 0.5f );
+				le.qny       = (int) floorf( le.lineNormal.y * 1024 + 0.5f );
+				le.qc        = (int) floorf( le.offset * 16 + 0.5f );
+				le.thinFloor = edge.thinFloor;
+
+				lineEdges.push_back( le );
+			}
+		}
+	}
+
+	std::sort( lineEdges.begin(), lineEdges.end() );
+
+	// Now, take each line in turn. Along the line, the parts covered by edges
+	// facing both ways lie between two blocks and are dropped; the parts
+	// covered by edges facing a single way become edges of the mesh.
+	std::vector<LineEvent> events;
+
+	for ( size_t first = 0; first < lineEdges.size(); ) {
+		size_t last = first + 1;
+		while ( last < lineEdges.size() && lineEdges[last].sameLine( lineEdges[first] ) )
+			last++;
+
+		const LineEdge & line = lineEdges[first];
+		Vector2D tangent = Vector2D( -line.lineNormal.y, line.lineNormal.x );
+		Vector2D origin  = line.lineNormal * line.offset;
+
+		events.clear();
+		for ( size_t k = first; k < last; k++ ) {
+			LineEvent start = { lineEdges[k].u1, lineEdges[k].side, 1 };
+			LineEvent end   = { lineEdges[k].u2, lineEdges[k].side, -1 };
+			events.push_back( start );
+			events.push_back( end );
+		}
+
+		std::sort( events.begin(), events.end() );
+
+		// Walk along the line, counting the edges facing each way:
+		int   count[2]  = { 0, 0 };
+		int   openSide  = 0;
+		float openStart = 0;
+
+		for ( size_t k = 0; k < events.size(); ) {
+			float u = events[k].u;
+
+			// Events closer than the tolerance happen at the same place:
+			while ( k < events.size() && events[k].u < u + MERGE_TOLERANCE ) {
+				count[events[k].side > 0 ? 0 : 1] += events[k].delta;
+				k++;
+			}
+
+			int side = (count[0] > 0 && count[1] == 0) ? 1 : ((count[1] > 0 && count[0] == 0) ? -1 : 0);
+
+			if ( side != openSide ) {
+				if ( openSide != 0 ) {
+					Edge edge;
+					edge.p1        = origin + tangent * openStart;
+					edge.p2        = origin + tangent * u;
+					edge.normal    = line.lineNormal * (float) openSide;
+					edge.thinFloor = line.thinFloor;
+					edges.push_back( edge );
+				}
+
+				openSide  = side;
+				openStart = u;
+			}
+		}
+
+		first = last;
+	}
+
+	// Cut the edges into pieces, and build the hierarchy:
+	float pieceLength = (float) (PIECE_BLOCKS * blockSize);
+
+	for ( int e = 0; e < (int) edges.size(); e++ ) {
+		const Edge & edge = edges[e];
+		int count = std::max( 1, (int) ceilf( (edge.p2 - edge.p1).length() / pieceLength ) );
+
+		for ( int k = 0; k < count; k++ ) {
+			Vector2D from = edge.p1 + (edge.p2 - edge.p1) * ((float) k / count);
+			Vector2D to   = edge.p1 + (edge.p2 - edge.p1) * ((float) (k + 1) / count);
+
+			Piece piece;
+			piece.edge = e;
+			piece.minX = std::min( from.x, to.x );
+			piece.minY = std::min( from.y, to.y );
+			piece.maxX = std::max( from.x, to.x );
+			piece.maxY = std::max( from.y, to.y );
+			pieces.push_back( piece );
+		}
+	}
+
+	if ( !pieces.empty() )
+		buildNode( 0, (int) pieces.size() );
+
+	built   = true;
+	version = grid.getVersion();
+
+} // End of method: RoomEdgeMesh::build
+
+
+
+
+
+
+int RoomEdgeMesh::buildNode ( int first, int count ) {
+	Node node;
+	node.minX = node.minY =  FLT_MAX;
+	node.maxX = node.maxY = -FLT_MAX;
+
+	// Bounds of the pieces, and of their centers:
+	float cMinX = FLT_MAX, cMinY = FLT_MAX, cMaxX = -FLT_MAX, cMaxY = -FLT_MAX;
+
+	for ( int k = first; k < first + count; k++ ) {
+		const Piece & piece = pieces[k];
+
+		node.minX = std::min( node.minX, piece.minX );
+		node.minY = std::min( node.minY, piece.minY );
+		node.maxX = std::max( node.maxX, piece.maxX );
+		node.maxY = std::max( node.maxY, piece.maxY );
+
+		cMinX = std::min( cMinX, piece.minX + piece.maxX );
+		cMinY = std::min( cMinY, piece.minY + piece.maxY );
+		cMaxX = std::max( cMaxX, piece.minX + piece.maxX );
+		cMaxY = std::max( cMaxY, piece.minY + piece.maxY );
+	}
+
+	node.first  = first;
+	node.count  = count;
+	node.second = -1;
+
+	int index = (int) nodes.size();
+	nodes.push_back( node );
+
+	if ( count <= LEAF_SIZE )
+		return index;
+
+	// Split at the median, along the longest axis:
+	bool alongX = (cMaxX - cMinX >= cMaxY - cMinY);
+	int  half   = count / 2;
+
+	std::nth_element( pieces.begin() + first, pieces.begin() + first + half, pieces.begin() + first + count,
+		[alongX] ( const Piece & a, const Piece & b ) {
+			return alongX ? (a.minX + a.maxX < b.minX + b.maxX)
+			              : (a.minY + a.maxY < b.minY + b.maxY);
+		} );
+
+	// (The children may reallocate the nodes, so don't hold on to them.)
+	buildNode( first, half );
+	int second = buildNode( first + half, count - half );
+
+	nodes[index].count  = 0;
+	nodes[index].second = second;
+
+	return index;
+
+} // End of method: RoomEdgeMesh::buildNode
+
+
+
+
+
+
+bool RoomEdgeMesh::sweep ( float x1, float y1, float x2, float y2, float dx, float dy, bool touchThinFloor,
+                           float * time, Vector2D * contact, Vector2D * normal ) const {
+	if ( nodes.empty() || (dx == 0 && dy == 0) )
+		return false;
+
+	Vector2D p1 = Vector2D( x1, y1 );
+	Vector2D p2 = Vector2D( x2, y2 );
+	Vector2D d  = Vector2D( dx, dy );
+
+	bool isPoint = ((p2 - p1).length() < EPSILON);
+
+	// Thin floors only count when moving from top to bottom:
+	bool thinFloorSolid = (touchThinFloor && dy >= 0);
+
+	// The moving segment's normal, facing backwards: Used when the segment
+	// runs into an edge's extremity.
+	Vector2D backNormal = Vector2D( -(y2 - y1), x2 - x1 );
+	if ( backNormal * d > 0 )
+		backNormal = -backNormal;
+	backNormal.normalize();
+
+	// Tolerance, as a fraction of the displacement:
+	float tolerance = EPSILON / d.length();
+
+	// The segment's bounding box:
+	SweptBox box;
+	box.minX = std::min( x1, x2 ) - EPSILON;
+	box.minY = std::min( y1, y2 ) - EPSILON;
+	box.maxX = std::max( x1, x2 ) + EPSILON;
+	box.maxY = std::max( y1, y2 ) + EPSILON;
+	box.dx   = dx;
+	box.dy   = dy;
+
+	bool     hit      = false;
+	float    bestTime = 1.0f;
+	Vector2D bestContact, normalSum;
+
+	// The edges whose contacts happen at bestTime; an edge cut into several
+	// pieces may be found again, but must only count once.
+	int tiedEdges[8];
+	int tiedCount = 0;
+
+	int   stack[64];
+	float stackTime[64];
+	int   top = 0;
+
+	float rootTime = box.enterTime( nodes[0], 1.0f );
+	if ( rootTime >= 0 ) {
+		stack[top]     = 0;
+		stackTime[top] = rootTime;
+		top++;
+	}
+
+	while ( top > 0 ) {
+		top--;
+
+		// Something closer may have been found since the node was pushed:
+		if ( stackTime[top] > bestTime + tolerance )
+			continue;
+
+		int index = stack[top];
+		const Node & node = nodes[index];
+
+		if ( node.count == 0 ) {
+			// Visit the nearest child first:
+			int   near     = index + 1;
+			int   far      = node.second;
+			float nearTime = box.enterTime( nodes[near], bestTime + tolerance );
+			float farTime  = box.enterTime( nodes[far],  bestTime + tolerance );
+
+			if ( farTime >= 0 && (nearTime < 0 || farTime < nearTime) ) {
+				std::swap( near, far );
+				std::swap( nearTime, farTime );
+			}
+
+			if ( farTime >= 0 ) {
+				stack[top]     = far;
+				stackTime[top] = farTime;
+				top++;
+			}
+
+			if ( nearTime >= 0 ) {
+				stack[top]     = near;
+				stackTime[top] = nearTime;
+				top++;
+			}
+
+			continue;
+		}
+
+		for ( int k = node.first; k < node.first + node.count; k++ ) {
+			int edgeIndex = pieces[k].edge;
+			const Edge & edge = edges[edgeIndex];
+
+			if ( edge.thinFloor && !thinFloorSolid )
+				continue;
+
+			// Already counted?
+			bool tied = false;
+			for ( int e = 0; e < tiedCount; e++ )
+				tied |= (tiedEdges[e] == edgeIndex);
+			if ( tied )
+				continue;
+
+			// Edges facing away from the movement can't be run into:
+			if ( edge.normal * d >= 0 )
+				continue;
+
+			// Sliding past the edge's extremity, with nothing but a corner in
+			// common, is not a collision:
+			if ( !isPoint ) {
+				float a1 = cross( d, p1 - edge.p1 ), a2 = cross( d, p2 - edge.p1 );
+				float b2 = cross( d, edge.p2 - edge.p1 );
+				float overlap = std::min( std::max( a1, a2 ), std::max( 0.0f, b2 ) ) -
+				                std::max( std::min( a1, a2 ), std::min( 0.0f, b2 ) );
+
+				if ( overlap < EPSILON * d.length() )
+					continue;
+			}
+
+			// The segment's extremities may run into the edge, and the edge's
+			// extremities may run into the segment:
+			float    t[4];
+			Vector2D c[4], n[4];
+			int      found = 0;
+
+			if ( rayHit( p1, d, edge.p1, edge.p2, tolerance, &t[found] ) ) {
+				c[found] = p1 + d * t[found]; n[found] = edge.normal; found++;
+			}
+
+			if ( !isPoint ) {
+				if ( rayHit( p2, d, edge.p1, edge.p2, tolerance, &t[found] ) ) {
+					c[found] = p2 + d * t[found]; n[found] = edge.normal; found++;
+				}
+				if ( rayHit( edge.p1, -d, p1, p2, tolerance, &t[found] ) ) {
+					c[found] = edge.p1; n[found] = backNormal; found++;
+				}
+				if ( rayHit( edge.p2, -d, p1, p2, tolerance, &t[found] ) ) {
+					c[found] = edge.p2; n[found] = backNormal; found++;
+				}
+			}
+
+			// Keep the earliest contacts, and combine the normals of those
+			// happening at the same time:
+			for ( int f = 0; f < found; f++ ) {
+				if ( !hit || t[f] < bestTime - tolerance ) {
+					hit         = true;
+					bestTime    = t[f];
+					bestContact = c[f];
+					normalSum   = n[f];
+					tiedCount   = 0;
+				}
+				else if ( t[f] <= bestTime + tolerance ) {
+					bestTime   = std::min( bestTime, t[f] );
+					normalSum += n[f];
+				}
+				else
+					continue;
+
+				if ( (tiedCount == 0 || tiedEdges[tiedCount - 1] != edgeIndex) && tiedCount < 8 )
+					tiedEdges[tiedCount++] = edgeIndex;
+			}
+		}
+	}
+
+	if ( !hit )
+		return false;
+
+	if ( time )
+		*time = bestTime;
+	if ( contact )
+		*contact = bestContact;
+	if ( normal )
+		*normal = normalSum.unit();
+
+	return true;
+
+} // End of method: RoomEdgeMesh::sweep
+
+
+
+
+
+
+void RoomEdgeMesh::traceOutlines ( std::vector< std::vector<Vector2D> > & loops,
+                                   std::vector< std::vector<Vector2D> > & chains ) const {
+	loops.clear();
+	chains.clear();
+
+	// Direct every solid edge so that its solid side is on the right, and
+	// find the vertices; edges ending at the same point share one.
+	std::vector<Vector2D> vertices;
+	std::map< std::pair<int, int>, int > vertexIndex;
+	std::vector< std::pair<int, int> > directed;
+
+	for ( int e = 0; e < (int) edges.size(); e++ ) {
+		const Edge & edge = edges[e];
+
+		if ( edge.thinFloor ) {
+			// Thin floors are left alone:
+			std::vector<Vector2D> chain;
+			chain.push_back( edge.p1.x <= edge.p2.x ? edge.p1 : edge.p2 );
+			chain.push_back( edge.p1.x <= edge.p2.x ? edge.p2 : edge.p1 );
+			chains.push_back( chain );
+			continue;
+		}
+
+		Vector2D dir = Vector2D( -edge.normal.y, edge.normal.x );
+		bool forward = ((edge.p2 - edge.p1) * dir >= 0);
+		Vector2D ends[2] = { forward ? edge.p1 : edge.p2, forward ? edge.p2 : edge.p1 };
+		int      index[2];
+
+		for ( int k = 0; k < 2; k++ ) {
+			std::pair<int, int> key = vertexKey( ends[k] );
+			std::map< std::pair<int, int>, int >::iterator found = vertexIndex.find( key );
+
+			if ( found == vertexIndex.end() ) {
+				index[k] = (int) vertices.size();
+				vertexIndex[key] = index[k];
+				vertices.push_back( ends[k] );
+			}
+			else
+				index[k] = found->second;
+		}
+
+		if ( index[0] != index[1] )
+			directed.push_back( std::make_pair( index[0], index[1] ) );
+	}
+
+	// An edge fused across the point where another outline touches it (say,
+	// the tip of a slope resting on a floor) has to be split there, so
+	// that both outlines can be followed through the point. Find such
+	// points with a coarse grid of vertex buckets:
+	float originX = FLT_MAX, originY = FLT_MAX, extentX = -FLT_MAX, extentY = -FLT_MAX;
+
+	for ( int v = 0; v < (int) vertices.size(); v++ ) {
+		originX = std::min( originX, vertices[v].x );
+		originY = std::min( originY, vertices[v].y );
+		extentX = std::max( extentX, vertices[v].x );
+		extentY = std::max( extentY, vertices[v].y );
+	}
+
+	int cellColumns = vertices.empty() ? 0 : (int) ((extentX - originX) / VERTEX_CELL) + 1;
+	int cellRows    = vertices.empty() ? 0 : (int) ((extentY - originY) / VERTEX_CELL) + 1;
+
+	std::vector< std::vector<int> > buckets( cellColumns * cellRows );
+
+	for ( int v = 0; v < (int) vertices.size(); v++ ) {
+		int cx = (int) ((vertices[v].x - originX) / VERTEX_CELL);
+		int cy = (int) ((vertices[v].y - originY) / VERTEX_CELL);
+		buckets[cy * cellColumns + cx].push_back( v );
+	}
+
+	std::vector<OutlineEdge>        outline;
+	std::vector< std::vector<int> > outgoing( vertices.size() );
+	std::vector< std::pair<float, int> > splits;
+
+	for ( int d = 0; d < (int) directed.size(); d++ ) {
+		int      from = directed[d].first;
+		int      to   = directed[d].second;
+		Vector2D a    = vertices[from];
+		Vector2D ab   = vertices[to] - a;
+		float    len  = ab.length();
+
+		int loX = std::max( 0, (int) floorf( (std::min( a.x, a.x + ab.x ) - MERGE_TOLERANCE - originX) / VERTEX_CELL ) );
+		int loY = std::max( 0, (int) floorf( (std::min( a.y, a.y + ab.y ) - MERGE_TOLERANCE - originY) / VERTEX_CELL ) );
+		int hiX = std::min( cellColumns - 1, (int) floorf( (std::max( a.x, a.x + ab.x ) + MERGE_TOLERANCE - originX) / VERTEX_CELL ) );
+		int hiY = std::min( cellRows - 1,    (int) floorf( (std::max( a.y, a.y + ab.y ) + MERGE_TOLERANCE - originY) / VERTEX_CELL ) );
+
+		splits.clear();
+		for ( int cy = loY; cy <= hiY; cy++ ) {
+			for ( int cx = loX; cx <= hiX; cx++ ) {
+				const std::vector<int> & bucket = buckets[cy * cellColumns + cx];
+
+				for ( size_t k = 0; k < bucket.size(); k++ ) {
+					int v = bucket[k];
+					if ( v == from || v == to )
+						continue;
+
+					Vector2D av = vertices[v] - a;
+					float    t  = (av * ab) / (len * len);
+
+					if ( t > 0 && t < 1 && fabsf( cross( ab, av ) ) / len <= MERGE_TOLERANCE )
+						splits.push_back( std::make_pair( t, v ) );
+				}
+			}
+		}
+
+		std::sort( splits.begin(), splits.end() );
+		splits.push_back( std::make_pair( 1.0f, to ) );
+
+		for ( size_t k = 0; k < splits.size(); k++ ) {
+			OutlineEdge piece;
+			piece.from = from;
+			piece.to   = splits[k].second;
+			piece.dir  = (vertices[piece.to] - vertices[piece.from]).unit();
+			piece.used = false;
+
+			outgoing[piece.from].push_back( (int) outline.size() );
+			outline.push_back( piece );
+
+			from = piece.to;
+		}
+	}
+
+	// Follow the outlines. Where several of them meet at a point, always
+	// take the sharpest turn towards the solid side, so that outlines
+	// touching at a corner don't cross into each other.
+	std::vector<int> path;
+
+	for ( int start = 0; start < (int) outline.size(); start++ ) {
+		if ( outline[start].used )
+			continue;
+
+		bool closed = false;
+		int  e      = start;
+
+		path.clear();
+		for ( ;; ) {
+			outline[e].used = true;
+			path.push_back( outline[e].from );
+
+			int at = outline[e].to;
+			if ( at == outline[start].from ) {
+				closed = true;
+				break;
+			}
+
+			int   next     = -1;
+			float bestTurn = -FLT_MAX;
+
+			for ( size_t k = 0; k < outgoing[at].size(); k++ ) {
+				const OutlineEdge & candidate = outline[outgoing[at][k]];
+				if ( candidate.used )
+					continue;
+
+				float turn = atan2f( cross( outline[e].dir, candidate.dir ), outline[e].dir * candidate.dir );
+				if ( turn > bestTurn ) {
+					bestTurn = turn;
+					next     = outgoing[at][k];
+				}
+			}
+
+			// A dead end: The outline isn't closed after all.
+			if ( next < 0 ) {
+				path.push_back( at );
+				break;
+			}
+
+			e = next;
+		}
+
+		// Drop the vertices between collinear edges (closed outlines wrap
+		// around; open ones keep their ends):
+		int n = (int) path.size();
+		std::vector<Vector2D> points;
+
+		for ( int k = 0; k < n; k++ ) {
+			bool end = !closed && (k == 0 || k == n - 1);
+
+			if ( !end ) {
+				Vector2D prev = vertices[path[(k + n - 1) % n]];
+				Vector2D here = vertices[path[k]];
+				Vector2D next = vertices[path[(k + 1) % n]];
+
+				Vector2D in  = here - prev;
+				Vector2D out = next - here;
+
+				if ( fabsf( cross( in, out ) ) <= MERGE_TOLERANCE * (next - prev).length() && in * out > 0 )
+					continue;
+			}
+
+			points.push_back( vertices[path[k]] );
+		}
+
+		if ( closed && points.size() >= 3 )
+			loops.push_back( points );
+		else if ( !closed && points.size() >= 2 )
+			chains.push_back( points );
+	}
+
+} // End of method: RoomEdgeMesh::traceOutlines
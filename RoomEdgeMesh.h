@@ -0,0 +1,147 @@
+#ifndef _RoomEdgeMesh_h_
+#define _RoomEdgeMesh_h_
+
+
+#include "ObstacleGrid.h"
+#include "RoomBlockGeometry.h"
+#include "Vector2D.h"
+
+#include <vector>
+
+/**
+* The outline of a Room's obstacle layer, as a set of long edges.
+*
+* The edges of all blocks are gathered; edges shared by two neighbouring
+* blocks (e.g., between two <tt>BLK_FULL</tt> blocks) cancel each other
+* out, and the remaining collinear edges with the same normal are fused,
+* so that a floor spanning 200 blocks becomes a single edge. Thin floors
+* are fused among themselves only.
+*
+* The edges are stored in a bounding volume hierarchy, so that sweeps only
+* examine the edges near their path, nearest first. Long edges are entered
+* in the hierarchy as several pieces, so that a long floor doesn't make
+* every node as wide as the room.
+*
+* The mesh is a snapshot: It remembers the obstacle layer's version it
+* was built from, so that users can tell when it's out of date.
+*
+* @see Room::buildEdgeMesh()
+*/
+class RoomEdgeMesh
+{
+public:
+	typedef RoomBlockGeometry::Edge Edge;
+
+	/**
+	* Creates an empty mesh, which is out of date for every grid.
+	*/
+	RoomEdgeMesh ();
+
+	/**
+	* Rebuilds the mesh from the obstacle layer and the blocks' shapes.
+	*/
+	void build ( const ObstacleGrid & grid, const RoomBlockGeometry & geometry, int blockSize );
+
+	/**
+	* @return true if the mesh was built from the grid's current contents.
+	*/
+	inline bool isUpToDate ( const ObstacleGrid & grid ) const {
+		return built && version == grid.getVersion();
+	}
+
+	/**
+	* @return The number of edges in the mesh.
+	*/
+	inline int getEdgeCount () const {
+		return (int) edges.size();
+	}
+
+	/**
+	* @return One of the mesh's edges.
+	*/
+	inline const Edge & getEdge ( int index ) const {
+		return edges[index];
+	}
+
+	/**
+	* Sweeps the segment ((x1, y1), (x2, y2)) -- which may be a single
+	* point -- along the displacement (dx, dy), and finds the first edge it
+	* runs into. Only edges facing the movement are considered; thin floors
+	* are only solid if <tt>touchThinFloor</tt> is true and the segment is
+	* not moving upwards.
+	*
+	* When a hit is found, the fraction of the displacement that can be
+	* covered is stored in <tt>time</tt>, where the segment touched the edge
+	* in <tt>contact</tt>, and the normal in <tt>normal</tt> (combined over
+	* all edges touched at the same time). Any of them may be
+	* <tt>NULL</tt>.
+	*
+	* @return true if the segment runs into an edge.
+	*/
+	bool sweep ( float x1, float y1, float x2, float y2, float dx, float dy, bool touchThinFloor,
+	             float * time, Vector2D * contact, Vector2D * normal ) const;
+
+	/**
+	* Links the mesh's edges into outlines, for physics engines that want
+	* connected chains rather than loose edges.
+	*
+	* Each outline in <tt>loops</tt> is a closed polygon (the last vertex
+	* connects back to the first one), going around the obstacle with its
+	* solid side on the right when y points down; every vertex is shared
+	* by two edges, and collinear edges are fused. Where outlines touch at
+	* a single point, they are kept apart. Thin floors go to
+	* <tt>chains</tt>, as open chains from left to right.
+	*/
+	void traceOutlines ( std::vector< std::vector<Vector2D> > & loops,
+	                     std::vector< std::vector<Vector2D> > & chains ) const;
+
+private:
+	/**
+	* A stretch of an edge, and its bounding box.
+	*/
+	struct Piece
+	{
+		int   edge;
+		float minX, minY, maxX, maxY;
+	};
+
+	/**
+	* A node of the bounding volume hierarchy. Leaves hold a range of
+	* <tt>pieces</tt>; inner nodes have their first child right after them.
+	*/
+	struct Node
+	{
+		float minX, minY, maxX, maxY;
+
+		/** Leaves: First index into <tt>pieces</tt>, and how many. */
+		int first, count;
+
+		/** Inner nodes: Index of the second child. */
+		int second;
+	};
+
+	/** Maximum number of pieces in a leaf. */
+	static const int LEAF_SIZE = 4;
+
+	/** Maximum length of a piece, in blocks. */
+	static const int PIECE_BLOCKS = 4;
+
+	std::vector<Edge> edges;
+
+	/** Arranged so that each leaf's pieces are contiguous. */
+	std::vector<Piece> pieces;
+
+	std::vector<Node> nodes;
+
+	bool         built;
+	unsigned int version;
+
+	/**
+	* Builds the subtree for pieces[first .. first + count - 1], and returns
+	* its node's index.
+	*/
+	int buildNode ( int first, int count );
+
+};
+
+#endif
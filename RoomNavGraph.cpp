@@ -0,0 +1,639 @@
+#include "RoomNavGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Auxiliary functions:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Runs function( index, thread ) for every index in [0, count), spread over
+// threadCount threads (the calling thread included), which take the indices
+// in order as they become free:
+template <typename Function>
+static void parallelFor ( int count, int threadCount, Function function ) {
+	std::atomic<int> next( 0 );
+
+	auto work = [&] ( int thread ) {
+		for ( int index = next++; index < count; index = next++ )
+			function( index, thread );
+	};
+
+	std::vector<std::thread> threads;
+
+	for ( int t = 1; t < threadCount; t++ )
+		threads.push_back( std::thread( work, t ) );
+
+	work( 0 );
+
+	for ( size_t t = 0; t < threads.size(); t++ )
+		threads[t].join();
+
+} // End of function: parallelFor
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// RoomNavGraph::Builder:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// The steps of RoomNavGraph::build(), and the scratch data they share. Every
+// move is checked by running the movement model at a fixed time step.
+class RoomNavGraph::Builder
+{
+public:
+	Builder ( RoomNavGraph & _graph, const Room & _room, int _threadCount )
+		: graph(_graph), room(_room), tuning(_graph.tuning), threadCount(_threadCount),
+		  rows(_room.obstacleLayer.rows), columns(_room.obstacleLayer.columns), blockSize(_room.blockSize),
+		  workspaces(_threadCount)
+	{
+	}
+
+	void build ();
+
+private:
+	/** The time step of the simulations. */
+	static const float STEP;
+
+	/** Height of the cells without a surface. */
+	static const float NO_SURFACE;
+
+	/** How long JUMP is held: long enough for the highest jump. */
+	static const float JUMP_TIME;
+
+	/** A simulated drop or jump. */
+	struct Flight
+	{
+		Vector2D launch, landing;
+		float    time;
+		int      to;
+	};
+
+	RoomNavGraph &                           graph;
+	const Room &                             room;
+	const PlatformerMotion::Tuning &         tuning;
+	int                                      threadCount;
+	int                                      rows, columns, blockSize;
+	std::vector<PlatformerMotion::Workspace> workspaces;
+
+	/** For every cell (row-major): the height of the surface the character
+	* stands on in the middle of the cell's column, if it lies inside the
+	* cell. */
+	std::vector<float> surfaces;
+
+	/** For every cell with a surface: the row of the surface reached by
+	* walking to the next column to the left and right, or -1. */
+	std::vector<int> walkLeft, walkRight;
+
+	/** For every cell with a surface: the span it belongs to. */
+	std::vector<int> cellSpans;
+
+	/** The links found from each span. */
+	std::vector< std::vector<RoomNavGraph::Link> > spanLinks;
+
+	inline float columnCenter ( int column ) const {
+		return (column + 0.5f) * blockSize;
+	}
+
+	inline float surface ( int row, int column ) const {
+		return surfaces[row * columns + column];
+	}
+
+	void findSurfaces  ( int row );
+	void findWalks     ( int row, PlatformerMotion::Workspace & workspace );
+	void buildSpans    ();
+	void findLinks     ( int span, PlatformerMotion::Workspace & workspace );
+	void collectLinks  ();
+
+	bool settle        ( PlatformerMotion::State & state, float x, float y, PlatformerMotion::Workspace & workspace ) const;
+	int  walk          ( int row, int column, int direction, PlatformerMotion::Workspace & workspace ) const;
+	bool fly           ( int span, int column, int direction, PlanAction::ACTION action, float offset,
+	                     float speed, Flight & flight, PlatformerMotion::Workspace & workspace ) const;
+	void launch        ( int span, int column, int direction, PlanAction::ACTION action,
+	                     PlatformerMotion::Workspace & workspace );
+};
+
+
+
+const float RoomNavGraph::FIND_TOLERANCE   = 16.0f;
+const float RoomNavGraph::Builder::STEP       = 1.0f / 60.0f;
+const float RoomNavGraph::Builder::NO_SURFACE = -1.0f;
+const float RoomNavGraph::Builder::JUMP_TIME  = 1.0f;
+
+
+
+
+
+
+void RoomNavGraph::Builder::build () {
+	surfaces.assign( rows * columns, NO_SURFACE );
+	walkLeft.assign( rows * columns, -1 );
+	walkRight.assign( rows * columns, -1 );
+	cellSpans.assign( rows * columns, -1 );
+
+	// Each row's surfaces, and then the walks from them, are independent of
+	// the other rows':
+	parallelFor( rows, threadCount, [this] ( int row, int ) {
+		findSurfaces( row );
+	} );
+
+	parallelFor( rows, threadCount, [this] ( int row, int thread ) {
+		findWalks( row, workspaces[thread] );
+	} );
+
+	buildSpans();
+
+	// The jumps and drops from each span are independent of the other
+	// spans':
+	spanLinks.assign( graph.spans.size(), std::vector<RoomNavGraph::Link>() );
+
+	parallelFor( (int) graph.spans.size(), threadCount, [this] ( int span, int thread ) {
+		findLinks( span, workspaces[thread] );
+	} );
+
+	collectLinks();
+
+} // End of method: RoomNavGraph::Builder::build
+
+
+
+
+
+
+void RoomNavGraph::Builder::findSurfaces ( int row ) {
+	float half = tuning.WIDTH / 2;
+	float top  = (float) (row * blockSize);
+
+	for ( int j = 0; j < columns; j++ ) {
+		float x = columnCenter( j );
+		float groundY, ceilingY;
+
+		// The character's whole bottom side must rest on the surface (on a
+		// slope, it rests on its highest point), and there must be room
+		// for its body above it, inside the room:
+		if ( x - half < 0 || x + half > room.getPixelWidth() )
+			continue;
+
+		if ( !room.groundHeight( x - half, x + half, top, blockSize - 0.5f, true, &groundY ) )
+			continue;
+
+		if ( groundY - tuning.HEIGHT < 0 )
+			continue;
+
+		if ( room.ceilingHeight( x - half, x + half, groundY - 0.5f, tuning.HEIGHT - 0.5f, &ceilingY ) )
+			continue;
+
+		surfaces[row * columns + j] = groundY;
+	}
+
+} // End of method: RoomNavGraph::Builder::findSurfaces
+
+
+
+
+
+
+void RoomNavGraph::Builder::findWalks ( int row, PlatformerMotion::Workspace & workspace ) {
+	for ( int j = 0; j < columns; j++ ) {
+		if ( surface( row, j ) == NO_SURFACE )
+			continue;
+
+		if ( j > 0 )
+			walkLeft[row * columns + j] = walk( row, j, -1, workspace );
+
+		if ( j < columns - 1 )
+			walkRight[row * columns + j] = walk( row, j, 1, workspace );
+	}
+
+} // End of method: RoomNavGraph::Builder::findWalks
+
+
+
+
+
+
+void RoomNavGraph::Builder::buildSpans () {
+	graph.spans.clear();
+	graph.heights.clear();
+
+	// Neighbouring cells belong to the same span if the character can walk
+	// from each one to the other. Spans are numbered by their first column,
+	// then from top to bottom.
+	for ( int j = 0; j < columns; j++ ) {
+		for ( int i = 0; i < rows; i++ ) {
+			if ( surface( i, j ) == NO_SURFACE || cellSpans[i * columns + j] >= 0 )
+				continue;
+
+			RoomNavGraph::Span span;
+			span.firstColumn = j;
+			span.lastColumn  = j;
+			span.firstHeight = (int) graph.heights.size();
+			span.firstLink   = 0;
+			span.linkCount   = 0;
+
+			int spanIndex = (int) graph.spans.size();
+			int row       = i;
+
+			for ( ;; ) {
+				cellSpans[row * columns + span.lastColumn] = spanIndex;
+				graph.heights.push_back( surface( row, span.lastColumn ) );
+
+				int next = walkRight[row * columns + span.lastColumn];
+
+				if ( next < 0 || walkLeft[next * columns + span.lastColumn + 1] != row ||
+				     cellSpans[next * columns + span.lastColumn + 1] >= 0 )
+					break;
+
+				row = next;
+				span.lastColumn++;
+			}
+
+			graph.spans.push_back( span );
+		}
+	}
+
+	// Index the spans by column, top to bottom:
+	graph.columnStart.assign( columns + 1, 0 );
+
+	for ( size_t s = 0; s < graph.spans.size(); s++ )
+		for ( int j = graph.spans[s].firstColumn; j <= graph.spans[s].lastColumn; j++ )
+			graph.columnStart[j + 1]++;
+
+	for ( int j = 0; j < columns; j++ )
+		graph.columnStart[j + 1] += graph.columnStart[j];
+
+	graph.columnSpans.assign( graph.columnStart[columns], -1 );
+
+	for ( int j = 0; j < columns; j++ ) {
+		int slot = graph.columnStart[j];
+
+		for ( int i = 0; i < rows; i++ )
+			if ( cellSpans[i * columns + j] >= 0 )
+				graph.columnSpans[slot++] = cellSpans[i * columns + j];
+	}
+
+} // End of method: RoomNavGraph::Builder::buildSpans
+
+
+
+
+
+
+void RoomNavGraph::Builder::findLinks ( int span, PlatformerMotion::Workspace & workspace ) {
+	const RoomNavGraph::Span & s = graph.spans[span];
+	int middle = (s.firstColumn + s.lastColumn) / 2;
+
+	// Drop off both ends:
+	launch( span, s.firstColumn, -1, PlanAction::WALK, workspace );
+	launch( span, s.lastColumn,   1, PlanAction::WALK, workspace );
+
+	// Jumps off both ends, back over the span from both ends, and onto
+	// whatever lies above the span's middle:
+	for ( int direction = -1; direction <= 1; direction += 2 ) {
+		int end  = (direction < 0 ? s.firstColumn : s.lastColumn);
+		int back = (direction < 0 ? s.lastColumn  : s.firstColumn);
+
+		launch( span, end, direction, PlanAction::JUMP, workspace );
+
+		if ( back != end )
+			launch( span, back, direction, PlanAction::JUMP, workspace );
+
+		if ( middle != s.firstColumn && middle != s.lastColumn )
+			launch( span, middle, direction, PlanAction::JUMP, workspace );
+	}
+
+} // End of method: RoomNavGraph::Builder::findLinks
+
+
+
+
+
+
+void RoomNavGraph::Builder::collectLinks () {
+	graph.links.clear();
+
+	for ( size_t s = 0; s < spanLinks.size(); s++ ) {
+		graph.spans[s].firstLink = (int) graph.links.size();
+		graph.spans[s].linkCount = (int) spanLinks[s].size();
+
+		graph.links.insert( graph.links.end(), spanLinks[s].begin(), spanLinks[s].end() );
+	}
+
+} // End of method: RoomNavGraph::Builder::collectLinks
+
+
+
+
+
+
+bool RoomNavGraph::Builder::settle ( PlatformerMotion::State & state, float x, float y,
+                                     PlatformerMotion::Workspace & workspace ) const {
+	float half = tuning.WIDTH / 2;
+	float groundY;
+
+	// Put the character on the ground near (x, y), which may be a little
+	// higher or lower on a slope:
+	if ( !room.groundHeight( x - half, x + half, y - blockSize / 2.0f, (float) blockSize, true, &groundY ) )
+		return false;
+
+	state = PlatformerMotion::State();
+	state.pos = Vector2D( x, groundY );
+
+	// A step without input finds the contacts:
+	PlatformerMotion::step( room, tuning, PlatformerMotion::Controls(), STEP, state, workspace );
+
+	return state.bottomContact;
+
+} // End of method: RoomNavGraph::Builder::settle
+
+
+
+
+
+
+int RoomNavGraph::Builder::walk ( int row, int column, int direction, PlatformerMotion::Workspace & workspace ) const {
+	PlatformerMotion::State state;
+
+	if ( !settle( state, columnCenter( column ), surface( row, column ), workspace ) )
+		return -1;
+
+	// Walk to the middle of the next column, without ever leaving the
+	// ground; slopes may slow the character down.
+	PlatformerMotion::Controls controls;
+	controls.left  = (direction < 0);
+	controls.right = (direction > 0);
+
+	float targetX  = columnCenter( column + direction );
+	int   maxSteps = (int) (4.0f * blockSize / tuning.WALK_SPEED / STEP) + 30;
+	bool  arrived  = false;
+
+	for ( int k = 0; k < maxSteps && !arrived; k++ ) {
+		PlatformerMotion::step( room, tuning, controls, STEP, state, workspace );
+
+		if ( !state.bottomContact )
+			return -1;
+
+		arrived = (direction > 0 ? state.pos.x >= targetX : state.pos.x <= targetX);
+	}
+
+	if ( !arrived )
+		return -1;
+
+	// Which of the next column's surfaces is it on?
+	float tolerance = 2.0f + std::abs( state.pos.x - targetX );
+	int   best      = -1;
+
+	for ( int i = 0; i < rows; i++ ) {
+		float s = surface( i, column + direction );
+
+		if ( s != NO_SURFACE && std::abs( s - state.pos.y ) <= tolerance &&
+		     (best < 0 || std::abs( s - state.pos.y ) < std::abs( surface( best, column + direction ) - state.pos.y )) )
+			best = i;
+	}
+
+	return best;
+
+} // End of method: RoomNavGraph::Builder::walk
+
+
+
+
+
+
+bool RoomNavGraph::Builder::fly ( int span, int column, int direction, PlanAction::ACTION action, float offset,
+                                  float speed, Flight & flight, PlatformerMotion::Workspace & workspace ) const {
+	PlatformerMotion::State state;
+
+	if ( !settle( state, columnCenter( column ) + offset, graph.getSurface( span, column ), workspace ) )
+		return false;
+
+	state.vel.x = speed;
+
+	PlatformerMotion::Controls controls;
+	controls.left  = (direction < 0);
+	controls.right = (direction > 0);
+
+	bool airborne = false;
+
+	flight.launch = state.pos;
+	flight.time   = 0;
+
+	// Three seconds are enough for any sensible jump or drop; walking for a
+	// second without leaving the ground means there's a wall ahead.
+	for ( int k = 0; k < (int) (3.0f / STEP); k++ ) {
+		controls.jumpPress = (action == PlanAction::JUMP && k == 0);
+		controls.jump      = (action == PlanAction::JUMP && k * STEP < JUMP_TIME);
+
+		Vector2D before = state.pos;
+
+		PlatformerMotion::step( room, tuning, controls, STEP, state, workspace );
+
+		if ( airborne )
+			flight.time += STEP;
+
+		if ( !airborne && !state.bottomContact ) {
+			airborne = true;
+
+			// Drops start where the character walks off the ground:
+			if ( action == PlanAction::WALK )
+				flight.launch = before;
+		}
+		else if ( airborne && state.bottomContact ) {
+			break;
+		}
+		else if ( !airborne && k * STEP > 1.0f ) {
+			return false;
+		}
+
+		if ( state.pos.y > room.getPixelHeight() )
+			return false;
+	}
+
+	if ( !airborne || !state.bottomContact )
+		return false;
+
+	flight.landing = state.pos;
+	flight.to      = graph.findSpan( state.pos.x, state.pos.y );
+
+	return flight.to >= 0 && flight.to != span;
+
+} // End of method: RoomNavGraph::Builder::fly
+
+
+
+
+
+
+void RoomNavGraph::Builder::launch ( int span, int column, int direction, PlanAction::ACTION action,
+                                     PlatformerMotion::Workspace & workspace ) {
+	// Agents reach the launch point standing still or walking its way, and
+	// no closer than the distance they walk in a step: The move must take
+	// the character to the same span in all of these cases. The link leads
+	// from the standstill launch point to its landing point, and takes as
+	// long as the slowest case.
+	Flight flight;
+
+	if ( !fly( span, column, direction, action, 0, 0, flight, workspace ) )
+		return;
+
+	int   to    = flight.to;
+	float time  = flight.time;
+	float error = tuning.WALK_SPEED * STEP;
+
+	for ( int moving = 0; moving <= 1; moving++ ) {
+		for ( int shift = -1; shift <= 1; shift++ ) {
+			Flight other;
+
+			// The standstill case from the launch point is the one above:
+			if ( !moving && !shift )
+				continue;
+
+			if ( !fly( span, column, direction, action, shift * error, moving * direction * tuning.WALK_SPEED,
+			           other, workspace ) || other.to != to )
+				return;
+
+			time = std::max( time, other.time );
+		}
+	}
+
+	// Keep the quickest way of each kind to each span:
+	std::vector<RoomNavGraph::Link> & found = spanLinks[span];
+
+	for ( size_t l = 0; l < found.size(); l++ ) {
+		if ( found[l].to == to && found[l].action == action ) {
+			if ( found[l].time <= time )
+				return;
+
+			found.erase( found.begin() + l );
+			break;
+		}
+	}
+
+	RoomNavGraph::Link link;
+	link.from      = span;
+	link.to        = to;
+	link.action    = action;
+	link.launch    = flight.launch;
+	link.landing   = flight.landing;
+	link.direction = direction;
+	link.jumpTime  = (action == PlanAction::JUMP ? JUMP_TIME : 0);
+	link.time      = time;
+
+	found.push_back( link );
+
+} // End of method: RoomNavGraph::Builder::launch
+
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// RoomNavGraph:
+//
+///////////////////////////////////////////////////////////////////////////////
+
+RoomNavGraph::RoomNavGraph ()
+	// Initialize members:
+	: room(NULL),
+	  version(0),
+	  buildCount(0),
+	  blockSize(1),
+	  columns(0)
+{
+} // End of constructor: RoomNavGraph::RoomNavGraph
+
+
+
+
+
+
+void RoomNavGraph::build ( const Room & room, const PlatformerMotion::Tuning & tuning, int threadCount ) {
+	if ( threadCount <= 0 )
+		threadCount = std::max( 1, (int) std::thread::hardware_concurrency() );
+
+	this->tuning    = tuning;
+	this->room      = &room;
+	this->version   = room.obstacleLayer.getVersion();
+	this->blockSize = room.blockSize;
+	this->columns   = room.obstacleLayer.columns;
+
+	Builder( *this, room, threadCount ).build();
+
+	buildCount++;
+
+} // End of method: RoomNavGraph::build
+
+
+
+
+
+
+Vector2D RoomNavGraph::getStandingPoint ( int span, float x ) const {
+	const Span & s = spans[span];
+	int column = std::min( std::max( (int) floorf( x / blockSize ), s.firstColumn ), s.lastColumn );
+
+	return Vector2D( (column + 0.5f) * blockSize, getSurface( span, column ) );
+
+} // End of method: RoomNavGraph::getStandingPoint
+
+
+
+
+
+
+float RoomNavGraph::getSurfaceAt ( int span, float x ) const {
+	const Span & s = spans[span];
+
+	// Between the middles of two columns, the surface goes from one's
+	// height to the other's; beyond the first and last middles, it's flat.
+	float column = x / blockSize - 0.5f;
+
+	if ( column <= s.firstColumn )
+		return getSurface( span, s.firstColumn );
+
+	if ( column >= s.lastColumn )
+		return getSurface( span, s.lastColumn );
+
+	int   left = (int) floorf( column );
+	float t    = column - left;
+
+	return getSurface( span, left ) * (1 - t) + getSurface( span, left + 1 ) * t;
+
+} // End of method: RoomNavGraph::getSurfaceAt
+
+
+
+
+
+
+int RoomNavGraph::findSpan ( float x, float y ) const {
+	int column = (int) floorf( x / blockSize );
+	int best   = -1;
+
+	// Spans crossing the character's column, or ending in one of its
+	// neighbours (the character may be standing on the edge of a ledge):
+	float bestDistance = FIND_TOLERANCE;
+
+	for ( int j = std::max( column - 1, 0 ); j <= std::min( column + 1, columns - 1 ); j++ ) {
+		for ( int c = columnStart[j]; c < columnStart[j + 1]; c++ ) {
+			int   span     = columnSpans[c];
+			float distance = std::abs( getSurfaceAt( span, x ) - y );
+
+			if ( distance < bestDistance ) {
+				best         = span;
+				bestDistance = distance;
+			}
+		}
+	}
+
+	return best;
+
+} // End of method: RoomNavGraph::findSpan
@@ -0,0 +1,218 @@
+#ifndef _RoomNavGraph_h_
+#define _RoomNavGraph_h_
+
+
+#include "Room.h"
+#include "PlatformerMotion.h"
+#include "PlanAction.h"
+#include "Vector2D.h"
+
+#include <vector>
+
+/**
+* Where a platformer character can go in a Room, as a graph.
+*
+* The nodes are <em>spans</em>: runs of neighbouring block columns in
+* which the character can stand, and walk from one column to the next
+* and back (flat floors, slopes and thin floors alike). Each span keeps
+* the height of its surface at the middle of each of its columns.
+*
+* The links are the ways to get from one span to another without
+* walking: dropping off its ends, and jumping from its ends and its
+* middle in either direction. Every link, as well as every step between
+* two columns of a span, is found by running the character's own
+* movement model (<tt>PlatformerMotion</tt>) with its tuning profile, so
+* the graph only contains moves the character can actually make. A link
+* is taken at its launch point, standing or walking towards the link's
+* direction, by holding that direction (and JUMP, for jumps) until the
+* character lands; it's only kept if it lands on the same span either way.
+*
+* Building the graph runs many short simulations; the rows of the room
+* and then its spans are spread over several threads. Once built, the
+* graph is read-only, and can be queried from any thread.
+*
+* The graph isn't rebuilt when the room changes: <tt>isUpToDate()</tt>
+* tells whether it still matches the room and the obstacle layer it was
+* built from, and <tt>getBuildCount()</tt> lets caches of paths through
+* it notice a rebuild.
+*
+* @see PathPlanner
+*/
+class RoomNavGraph
+{
+public:
+	/**
+	* A run of columns the character can walk along.
+	*/
+	struct Span
+	{
+		/** The span's first and last block columns. */
+		int firstColumn, lastColumn;
+
+		/** Index of the span's first cell, which is also that column's
+		* surface height in the graph's height table; the others
+		* follow. */
+		int firstHeight;
+
+		/** The span's outgoing links: <tt>linkCount</tt> links, starting
+		* at <tt>firstLink</tt>. */
+		int firstLink, linkCount;
+	};
+
+	/**
+	* A move from one span to another: walking off an end
+	* (<tt>PlanAction::WALK</tt>) or jumping (<tt>PlanAction::JUMP</tt>).
+	*/
+	struct Link
+	{
+		int from, to;
+
+		PlanAction::ACTION action;
+
+		/** Where the character leaves the source span, and where it
+		* lands. */
+		Vector2D launch, landing;
+
+		/** Which way to steer while in the air: -1 (left) or 1
+		* (right). */
+		int direction;
+
+		/** How long JUMP is held, in seconds. */
+		float jumpTime;
+
+		/** Seconds from launch to landing. */
+		float time;
+	};
+
+	/**
+	* Creates an empty graph, which is out of date for every room.
+	*/
+	RoomNavGraph ();
+
+	/**
+	* Rebuilds the graph for a character with the specified tuning
+	* profile. The room must not change while it's being built.
+	*
+	* @param threadCount Number of threads to build the graph with; 0 means
+	*                    one per hardware thread.
+	*/
+	void build ( const Room & room, const PlatformerMotion::Tuning & tuning, int threadCount = 0 );
+
+	/**
+	* @return true if the graph was built from the room's current obstacle
+	*         layer.
+	*/
+	inline bool isUpToDate ( const Room & room ) const {
+		return this->room == &room && version == room.obstacleLayer.getVersion();
+	}
+
+	/**
+	* @return How many times the graph has been built; e.g., for caches of
+	*         paths through it.
+	*/
+	inline unsigned int getBuildCount () const {
+		return buildCount;
+	}
+
+	/**
+	* @return The tuning profile the graph was built for.
+	*/
+	inline const PlatformerMotion::Tuning & getTuning () const {
+		return tuning;
+	}
+
+	inline int getBlockSize () const {
+		return blockSize;
+	}
+
+	inline int getSpanCount () const {
+		return (int) spans.size();
+	}
+
+	inline const Span & getSpan ( int index ) const {
+		return spans[index];
+	}
+
+	inline int getLinkCount () const {
+		return (int) links.size();
+	}
+
+	inline const Link & getLink ( int index ) const {
+		return links[index];
+	}
+
+	/**
+	* @return The number of cells: the columns of all spans.
+	*/
+	inline int getCellCount () const {
+		return (int) heights.size();
+	}
+
+	/**
+	* @return The index of the span's cell at <tt>column</tt>, which must be
+	*         one of the span's columns. A span's cells are numbered
+	*         consecutively.
+	*/
+	inline int getCell ( int span, int column ) const {
+		return spans[span].firstHeight + column - spans[span].firstColumn;
+	}
+
+	/**
+	* @return The surface height of the span at the middle of
+	*         <tt>column</tt>, which must be one of the span's columns.
+	*/
+	inline float getSurface ( int span, int column ) const {
+		return heights[getCell( span, column )];
+	}
+
+	/**
+	* @return The point of the span's surface nearest to <tt>x</tt>, at the
+	*         middle of a column.
+	*/
+	Vector2D getStandingPoint ( int span, float x ) const;
+
+	/**
+	* @return The height of the span's surface at <tt>x</tt>: between the
+	*         middles of two of its columns, it goes straight from one's
+	*         height to the other's; beyond the first and last ones, it's
+	*         flat.
+	*/
+	float getSurfaceAt ( int span, float x ) const;
+
+	/**
+	* Finds the span a character standing at <tt>(x, y)</tt> is on: the
+	* span whose surface passes nearest to the character's feet, within
+	* <tt>FIND_TOLERANCE</tt> pixels. The character may be standing on the
+	* edge of a ledge, with its middle over the next column.
+	*
+	* @return The span's index, or -1.
+	*/
+	int findSpan ( float x, float y ) const;
+
+private:
+	class Builder;
+
+	/** How far from a surface <tt>findSpan()</tt> looks, in pixels: Less
+	* than half the character's height, so that it can't pick the floor
+	* above. */
+	static const float FIND_TOLERANCE;
+
+	std::vector<Span>  spans;
+	std::vector<float> heights;
+	std::vector<Link>  links;
+
+	/** For every column, the spans crossing it, top to bottom:
+	* <tt>columnSpans[columnStart[j] .. columnStart[j + 1] - 1]</tt>. */
+	std::vector<int> columnStart;
+	std::vector<int> columnSpans;
+
+	PlatformerMotion::Tuning tuning;
+
+	const Room * room;
+	unsigned int version;
+	unsigned int buildCount;
+	int          blockSize;
+	int          columns;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "SceneNode.h"
 #include "Command.h"
+#include "CommandDispatcher.h"
 #include "Foreach.h"
 #include "Utility.h"
 
@@ -13,12 +14,40 @@ SceneNode::SceneNode(CommandCategory::Type category)
 : mChildren()
 , mParent(nullptr)
 , mDefaultCategory(category)
+, mQuadTree(nullptr)
+, mCommandDispatcher(nullptr)
+, mDispatchRegistration(0)
+, mEntityRegistry(nullptr)
+, mHandle()
+, mWorldTransform()
+, mWorldTransformDirty(true)
 {
 }
 
+SceneNode::~SceneNode()
+{
+	// The children unregister in their own destructors
+	if (mCommandDispatcher)
+		mCommandDispatcher->removeNode(mDispatchRegistration);
+
+	if (mEntityRegistry)
+		mEntityRegistry->remove(mHandle);
+}
+
 void SceneNode::attachChild(Ptr child)
 {
 	child->mParent = this;
+	child->invalidateWorldTransform();
+
+	if (mQuadTree)
+		child->enterQuadTree(*mQuadTree);
+
+	if (mCommandDispatcher)
+		child->enterCommandDispatcher(*mCommandDispatcher);
+
+	if (mEntityRegistry)
+		child->enterEntityRegistry(*mEntityRegistry);
+
 	mChildren.push_back(std::move(child));
 }
 
@@ -29,10 +58,34 @@ SceneNode::Ptr SceneNode::detachChild(const SceneNode& node)
 
 	Ptr result = std::move(*found);
 	result->mParent = nullptr;
+	result->invalidateWorldTransform();
+	result->leaveQuadTree();
+	result->leaveCommandDispatcher();
+	result->leaveEntityRegistry();
 	mChildren.erase(found);
 	return result;
 }
 
+SceneNode* SceneNode::getParent() const
+{
+	return mParent;
+}
+
+void SceneNode::setQuadTree(qdt::QuadTree* quadTree)
+{
+	mQuadTree = quadTree;
+}
+
+void SceneNode::enterQuadTree(qdt::QuadTree&)
+{
+	// Not indexed by default
+}
+
+void SceneNode::leaveQuadTree()
+{
+	// Not indexed by default
+}
+
 void SceneNode::update(sf::Time dt, CommandQueue& commands)
 {
 	updateCurrent(dt, commands);
@@ -93,14 +146,105 @@ sf::Vector2f SceneNode::getWorldPosition() const
 	return getWorldTransform() * sf::Vector2f();
 }
 
-sf::Transform SceneNode::getWorldTransform() const
+const sf::Transform& SceneNode::getWorldTransform() const
+{
+	// Recompute only after the node or one of its ancestors has moved; the
+	// parent's transform is then cached for the node's siblings as well
+	if (mWorldTransformDirty)
+	{
+		if (mParent)
+			mWorldTransform = mParent->getWorldTransform() * getTransform();
+		else
+			mWorldTransform = getTransform();
+
+		mWorldTransformDirty = false;
+	}
+
+	return mWorldTransform;
+}
+
+void SceneNode::setPosition(float x, float y)
 {
-	sf::Transform transform = sf::Transform::Identity;
+	sf::Transformable::setPosition(x, y);
+	invalidateWorldTransform();
+}
 
-	for (const SceneNode* node = this; node != nullptr; node = node->mParent)
-		transform = node->getTransform() * transform;
+void SceneNode::setPosition(const sf::Vector2f& position)
+{
+	sf::Transformable::setPosition(position);
+	invalidateWorldTransform();
+}
 
-	return transform;
+void SceneNode::setRotation(float angle)
+{
+	sf::Transformable::setRotation(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setScale(float factorX, float factorY)
+{
+	sf::Transformable::setScale(factorX, factorY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setScale(const sf::Vector2f& factors)
+{
+	sf::Transformable::setScale(factors);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setOrigin(float x, float y)
+{
+	sf::Transformable::setOrigin(x, y);
+	invalidateWorldTransform();
+}
+
+void SceneNode::setOrigin(const sf::Vector2f& origin)
+{
+	sf::Transformable::setOrigin(origin);
+	invalidateWorldTransform();
+}
+
+void SceneNode::move(float offsetX, float offsetY)
+{
+	sf::Transformable::move(offsetX, offsetY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::move(const sf::Vector2f& offset)
+{
+	sf::Transformable::move(offset);
+	invalidateWorldTransform();
+}
+
+void SceneNode::rotate(float angle)
+{
+	sf::Transformable::rotate(angle);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(float factorX, float factorY)
+{
+	sf::Transformable::scale(factorX, factorY);
+	invalidateWorldTransform();
+}
+
+void SceneNode::scale(const sf::Vector2f& factor)
+{
+	sf::Transformable::scale(factor);
+	invalidateWorldTransform();
+}
+
+void SceneNode::invalidateWorldTransform()
+{
+	// Already dirty: so is the whole subtree
+	if (mWorldTransformDirty)
+		return;
+
+	mWorldTransformDirty = true;
+
+	FOREACH(Ptr& child, mChildren)
+		child->invalidateWorldTransform();
 }
 
 void SceneNode::onCommand(const Command& command, sf::Time dt)
@@ -119,21 +263,96 @@ unsigned int SceneNode::getCategory() const
 	return mDefaultCategory;
 }
 
-void SceneNode::checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs)
+void SceneNode::setCommandDispatcher(CommandDispatcher* dispatcher)
+{
+	leaveCommandDispatcher();
+
+	if (dispatcher)
+		enterCommandDispatcher(*dispatcher);
+}
+
+void SceneNode::enterCommandDispatcher(CommandDispatcher& dispatcher)
+{
+	assert(!mCommandDispatcher);
+
+	mCommandDispatcher = &dispatcher;
+	mDispatchRegistration = dispatcher.addNode(*this, getCategory());
+
+	FOREACH(Ptr& child, mChildren)
+		child->enterCommandDispatcher(dispatcher);
+}
+
+void SceneNode::leaveCommandDispatcher()
+{
+	if (!mCommandDispatcher)
+		return;
+
+	mCommandDispatcher->removeNode(mDispatchRegistration);
+	mCommandDispatcher = nullptr;
+
+	FOREACH(Ptr& child, mChildren)
+		child->leaveCommandDispatcher();
+}
+
+void SceneNode::setEntityRegistry(EntityRegistry* registry)
+{
+	leaveEntityRegistry();
+
+	if (registry)
+		enterEntityRegistry(*registry);
+}
+
+EntityHandle SceneNode::getHandle() const
+{
+	return mHandle;
+}
+
+EntityRegistry* SceneNode::getEntityRegistry() const
+{
+	return mEntityRegistry;
+}
+
+void SceneNode::notifyDestroyed()
+{
+	if (mEntityRegistry)
+		mEntityRegistry->markDestroyed(mHandle);
+}
+
+void SceneNode::enterEntityRegistry(EntityRegistry& registry)
+{
+	assert(!mEntityRegistry);
+
+	mEntityRegistry = &registry;
+	mHandle = registry.add(*this);
+
+	// Destroyed before it was attached
+	if (isDestroyed())
+		registry.markDestroyed(mHandle);
+
+	FOREACH(Ptr& child, mChildren)
+		child->enterEntityRegistry(registry);
+}
+
+void SceneNode::leaveEntityRegistry()
 {
-	checkNodeCollision(sceneGraph, collisionPairs);
+	if (!mEntityRegistry)
+		return;
 
-	FOREACH(Ptr& child, sceneGraph.mChildren)
-		checkSceneCollision(*child, collisionPairs);
+	mEntityRegistry->remove(mHandle);
+	mEntityRegistry = nullptr;
+	mHandle = EntityHandle();
+
+	FOREACH(Ptr& child, mChildren)
+		child->leaveEntityRegistry();
 }
 
-void SceneNode::checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs)
+void SceneNode::collectNodes(unsigned int categories, std::vector<SceneNode*>& nodes)
 {
-	if (this != &node && collision(*this, node) && !isDestroyed() && !node.isDestroyed())
-		collisionPairs.insert(std::minmax(this, &node));
+	if ((getCategory() & categories) && !isDestroyed())
+		nodes.push_back(this);
 
 	FOREACH(Ptr& child, mChildren)
-		child->checkNodeCollision(node, collisionPairs);
+		child->collectNodes(categories, nodes);
 }
 
 void SceneNode::removeWrecks()
@@ -146,6 +365,12 @@ void SceneNode::removeWrecks()
 	std::for_each(mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::removeWrecks));
 }
 
+void SceneNode::removeChildWrecks()
+{
+	auto wreckfieldBegin = std::remove_if (mChildren.begin(), mChildren.end(), std::mem_fn(&SceneNode::isMarkedForRemoval));
+	mChildren.erase(wreckfieldBegin, mChildren.end());
+}
+
 sf::FloatRect SceneNode::getBoundingRect() const
 {
 	return sf::FloatRect();
@@ -163,6 +388,27 @@ bool SceneNode::isDestroyed() const
 	return false;
 }
 
+unsigned int SceneNode::getChecksum(unsigned int hash) const
+{
+	// Hash node and children, in scene graph order
+	hash = getChecksumCurrent(hash);
+
+	FOREACH(const Ptr& child, mChildren)
+		hash = child->getChecksum(hash);
+
+	return hash;
+}
+
+unsigned int SceneNode::getChecksumCurrent(unsigned int hash) const
+{
+	hash = hashInt(hash, static_cast<int>(getCategory()));
+	hash = hashFloat(hash, getPosition().x);
+	hash = hashFloat(hash, getPosition().y);
+	hash = hashFloat(hash, getRotation());
+
+	return hash;
+}
+
 bool collision(const SceneNode& lhs, const SceneNode& rhs)
 {
 	return lhs.getBoundingRect().intersects(rhs.getBoundingRect());
@@ -2,15 +2,21 @@
 #define _SceneNode_h_
 
 #include "CommandCategory.h"
+#include "EntityRegistry.h"
 
 #include <SFML\Graphics.hpp>
 #include <vector>
-#include <set>
 #include <memory>
 #include <utility>
 
 struct Command;
 class CommandQueue;
+class CommandDispatcher;
+
+namespace qdt
+{
+	class QuadTree;
+}
 
 class SceneNode : public sf::Transformable, public sf::Drawable, private sf::NonCopyable
 {
@@ -21,25 +27,74 @@ class SceneNode : public sf::Transformable, public sf::Drawable, private sf::Non
 
 	public:
 		explicit				SceneNode(CommandCategory::Type category = CommandCategory::None);
+		virtual					~SceneNode();
 
 		void					attachChild(Ptr child);
 		Ptr						detachChild(const SceneNode& node);
+		SceneNode*				getParent() const;
+
+		// Children attached from now on enter the quadtree, if they are
+		// quadtree occupants (entities); pass nullptr to stop indexing
+		void					setQuadTree(qdt::QuadTree* quadTree);
 		
 		void					update(sf::Time dt, CommandQueue& commands);
 
 		sf::Vector2f			getWorldPosition() const;
-		sf::Transform			getWorldTransform() const;
+		const sf::Transform&	getWorldTransform() const;
+
+		// Hide sf::Transformable's setters, so that every change of the local
+		// transform invalidates the cached world transforms of the subtree
+		void					setPosition(float x, float y);
+		void					setPosition(const sf::Vector2f& position);
+		void					setRotation(float angle);
+		void					setScale(float factorX, float factorY);
+		void					setScale(const sf::Vector2f& factors);
+		void					setOrigin(float x, float y);
+		void					setOrigin(const sf::Vector2f& origin);
+		void					move(float offsetX, float offsetY);
+		void					move(const sf::Vector2f& offset);
+		void					rotate(float angle);
+		void					scale(float factorX, float factorY);
+		void					scale(const sf::Vector2f& factor);
 
 		void					onCommand(const Command& command, sf::Time dt);
 		virtual unsigned int	getCategory() const;
 
-		void					checkSceneCollision(SceneNode& sceneGraph, std::set<Pair>& collisionPairs);
-		void					checkNodeCollision(SceneNode& node, std::set<Pair>& collisionPairs);
+		// Registers the subtree with the dispatcher (nullptr to unregister it);
+		// nodes attached below it later register on attach. Set on the root
+		void					setCommandDispatcher(CommandDispatcher* dispatcher);
+
+		// Registers the subtree with the registry (nullptr to unregister it),
+		// like setCommandDispatcher(). Set on the root
+		void					setEntityRegistry(EntityRegistry* registry);
+
+		// Invalid unless registered
+		EntityHandle			getHandle() const;
+
+		// Appends the nodes of the subtree (this one included) that match
+		// the categories and aren't destroyed, in scene graph order
+		void					collectNodes(unsigned int categories, std::vector<SceneNode*>& nodes);
 		void					removeWrecks();
+
+		// Like removeWrecks(), without descending into the remaining children
+		void					removeChildWrecks();
 		virtual sf::FloatRect	getBoundingRect() const;
 		virtual bool			isMarkedForRemoval() const;
 		virtual bool			isDestroyed() const;
 
+		unsigned int			getChecksum(unsigned int hash) const;
+
+
+	protected:
+		virtual unsigned int	getChecksumCurrent(unsigned int hash) const;
+
+		// nullptr unless registered
+		EntityRegistry*			getEntityRegistry() const;
+
+		// Call when isDestroyed() becomes true, so that the registry removes
+		// the node once it's marked for removal
+		void					notifyDestroyed();
+
 
 	private:
 		virtual void			updateCurrent(sf::Time dt, CommandQueue& commands);
@@ -50,11 +105,35 @@ class SceneNode : public sf::Transformable, public sf::Drawable, private sf::Non
 		void					drawChildren(sf::RenderTarget& target, sf::RenderStates states) const;
 		void					drawBoundingRect(sf::RenderTarget& target, sf::RenderStates states) const;
 
+		void					invalidateWorldTransform();
+
+		void					enterCommandDispatcher(CommandDispatcher& dispatcher);
+		void					leaveCommandDispatcher();
+
+		void					enterEntityRegistry(EntityRegistry& registry);
+		void					leaveEntityRegistry();
+
+		virtual void			enterQuadTree(qdt::QuadTree& quadTree);
+		virtual void			leaveQuadTree();
+
 
 	private:
 		std::vector<Ptr>		mChildren;
 		SceneNode*				mParent;
 		CommandCategory::Type	mDefaultCategory;
+		qdt::QuadTree*			mQuadTree;
+
+		// Where the node is registered, and its registration there
+		CommandDispatcher*		mCommandDispatcher;
+		unsigned int			mDispatchRegistration;
+
+		EntityRegistry*			mEntityRegistry;
+		EntityHandle			mHandle;
+
+		// Parent's world transform * local transform, valid unless dirty. A
+		// dirty node's descendants are all dirty too.
+		mutable sf::Transform	mWorldTransform;
+		mutable bool			mWorldTransformDirty;
 };
 
 bool	collision(const SceneNode& lhs, const SceneNode& rhs);
@@ -10,6 +10,23 @@ SpriteNode::SpriteNode(const sf::Texture& texture, const sf::IntRect& textureRec
 {
 }
 
+SpriteNode::SpriteNode()
+	: mSprite()
+{
+}
+
+SpriteNode::SpriteNode(const sf::IntRect& textureRect)
+	: mSprite()
+{
+	mSprite.setTextureRect(textureRect);
+}
+
+void SpriteNode::setTexture(const sf::Texture& texture)
+{
+	// Keeps the rect, if any (else takes the whole texture)
+	mSprite.setTexture(texture);
+}
+
 void SpriteNode::drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const
 {
 	target.draw(mSprite, states);
@@ -10,6 +10,12 @@ public:
 	explicit		SpriteNode(const sf::Texture& texture);
 					SpriteNode(const sf::Texture& texture, const sf::IntRect& rect);
 
+	// Without a texture yet (none in headless worlds), see setTexture()
+					SpriteNode();
+	explicit		SpriteNode(const sf::IntRect& rect);
+
+	void			setTexture(const sf::Texture& texture);
+
 private:
 	virtual void	drawCurrent(sf::RenderTarget& target,
 								sf::RenderStates states) const;
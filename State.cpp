@@ -1,12 +1,13 @@
 #include "State.h"
 #include "StateStack.h"
 
-State::Context::Context(sf::RenderWindow& window, TextureManager& textures, FontManager& fonts, Player& player, PlayerPlatformer& playerPlatformer)
+State::Context::Context(sf::RenderWindow& window, TextureManager& textures, FontManager& fonts, Player& player, PlayerPlatformer& playerPlatformer, Replay& replay)
 	: window(&window)
 	, textures(&textures)
 	, fonts(&fonts)
 	, player(&player)
 	, playerPlatformer(&playerPlatformer)
+	, replay(&replay)
 {
 }
 
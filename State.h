@@ -14,6 +14,7 @@ namespace sf
 class StateStack;
 class Player;
 class PlayerPlatformer;
+class Replay;
 
 class State
 {
@@ -22,13 +23,14 @@ public:
 
 	struct Context 
 	{
-							Context(sf::RenderWindow& window, TextureManager& textures, FontManager& fonts, Player& player, PlayerPlatformer& playerPlatformer);
+							Context(sf::RenderWindow& window, TextureManager& textures, FontManager& fonts, Player& player, PlayerPlatformer& playerPlatformer, Replay& replay);
 
 		sf::RenderWindow*	window;
 		TextureManager*		textures;
 		FontManager*		fonts;
 		Player*				player;
 		PlayerPlatformer*	playerPlatformer;
+		Replay*				replay;
 	};
 
 public:
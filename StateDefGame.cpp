@@ -4,8 +4,12 @@ StateDefGame::StateDefGame(StateStack& stack, Context context)
 : State(stack, context)
 , mWorld(*context.window, *context.fonts)
 , mPlayer(*context.player)
+, mReplay(context.replay->isRecording() ? context.replay : nullptr)
 {
 	mPlayer.setMissionStatus(Player::MissionRunning);
+
+	if (mReplay)
+		mReplay->beginSession(States::Game);
 }
 
 void StateDefGame::draw()
@@ -29,7 +33,16 @@ bool StateDefGame::update(sf::Time dt)
 	}
 
 	CommandQueue& commands = mWorld.getCommandQueue();
-	mPlayer.handleRealtimeInput(commands);
+	unsigned int actions = mPlayer.getRealtimeActions();
+	mPlayer.triggerActions(actions, commands);
+
+	// Record this tick (ReplayRunner plays it back the same way)
+	if (mReplay)
+	{
+		mReplay->recordActions(actions);
+		if (mReplay->needsChecksum())
+			mReplay->recordChecksum(mWorld.getChecksum());
+	}
 
 	return true;
 }
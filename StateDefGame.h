@@ -4,6 +4,7 @@
 #include "State.h"
 #include "World.h"
 #include "Player.h"
+#include "Replay.h"
 
 #include <SFML\Graphics.hpp>
 
@@ -20,6 +21,7 @@ class StateDefGame : public State
 	private:
 		World				mWorld;
 		Player&				mPlayer;
+		Replay*				mReplay;
 };
 
 #endif
\ No newline at end of file
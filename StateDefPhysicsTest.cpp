@@ -1,4 +1,5 @@
 #include "StateDefPhysicsTest.h"
+#include "MapLoader.h"
 
 StateDefPhysicsTest::StateDefPhysicsTest(StateStack& stack, Context context)
 : State(stack, context)
@@ -13,30 +14,12 @@ StateDefPhysicsTest::StateDefPhysicsTest(StateStack& stack, Context context)
 	/* Set initial flags for what to draw */
 	mDebugDraw.SetFlags(b2Draw::e_shapeBit); //Only draw shapes
 
-	/* Create the bounding box */
-	b2BodyDef boundingBoxDef;
-	boundingBoxDef.type = b2_staticBody;
-	float xPos = (context.window->getSize().x / 2.f) / sfdd::SCALE;
-	float yPos = 0.5f;
-	boundingBoxDef.position.Set(xPos, yPos);
-
-	b2Body* boundingBoxBody = mB2World.CreateBody(&boundingBoxDef);
-
-	b2PolygonShape boxShape;
-	boxShape.SetAsBox((context.window->getSize().x) / sfdd::SCALE, 0.5f, b2Vec2(0.f, 0.f), 0.f);
-	boundingBoxBody->CreateFixture(&boxShape, 1.0); //Top
-
-	yPos = (context.window->getSize().y) / sfdd::SCALE - 1.f;
-	boxShape.SetAsBox((context.window->getSize().x) / sfdd::SCALE, 0.5f, b2Vec2(0.f, yPos), 0.f);
-	boundingBoxBody->CreateFixture(&boxShape, 1.f); //Bottom
-
-	xPos -= 0.5f;
-	boxShape.SetAsBox(0.5f, (context.window->getSize().y) / sfdd::SCALE, b2Vec2(-xPos, 0.f), 0.f);
-	boundingBoxBody->CreateFixture(&boxShape, 1.f);//Left
-
-	boxShape.SetAsBox(0.5f, (context.window->getSize().y) / sfdd::SCALE, b2Vec2(xPos, 0.f), 0.f);
-	boundingBoxBody->CreateFixture(&boxShape, 1.f);//Right
-
+	/* Collide against the test map's obstacle layer, or a bounding box around the window if it can't be loaded */
+	MapLoader mapLoader("../resources");
+	if(mapLoader.load("test.tmx", mMap))
+		physics::createRoomBody(mB2World, *mMap.getRoom(), sfdd::SCALE);
+	else
+		createBoundingBox(mB2World, context.window->getSize());
 }
 
 void StateDefPhysicsTest::draw()
@@ -78,4 +61,30 @@ b2Body*	StateDefPhysicsTest::createSquare(b2World &world)
 	body->CreateFixture(&boxShape, 1.f);
 	
 	return body;
+}
+
+void StateDefPhysicsTest::createBoundingBox(b2World &world, const sf::Vector2u& size)
+{
+	b2BodyDef boundingBoxDef;
+	boundingBoxDef.type = b2_staticBody;
+	float xPos = (size.x / 2.f) / sfdd::SCALE;
+	float yPos = 0.5f;
+	boundingBoxDef.position.Set(xPos, yPos);
+
+	b2Body* boundingBoxBody = world.CreateBody(&boundingBoxDef);
+
+	b2PolygonShape boxShape;
+	boxShape.SetAsBox((size.x) / sfdd::SCALE, 0.5f, b2Vec2(0.f, 0.f), 0.f);
+	boundingBoxBody->CreateFixture(&boxShape, 1.0); //Top
+
+	yPos = (size.y) / sfdd::SCALE - 1.f;
+	boxShape.SetAsBox((size.x) / sfdd::SCALE, 0.5f, b2Vec2(0.f, yPos), 0.f);
+	boundingBoxBody->CreateFixture(&boxShape, 1.f); //Bottom
+
+	xPos -= 0.5f;
+	boxShape.SetAsBox(0.5f, (size.y) / sfdd::SCALE, b2Vec2(-xPos, 0.f), 0.f);
+	boundingBoxBody->CreateFixture(&boxShape, 1.f);//Left
+
+	boxShape.SetAsBox(0.5f, (size.y) / sfdd::SCALE, b2Vec2(xPos, 0.f), 0.f);
+	boundingBoxBody->CreateFixture(&boxShape, 1.f);//Right
 }
\ No newline at end of file
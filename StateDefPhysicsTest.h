@@ -4,6 +4,7 @@
 #include "State.h"
 #include "Physics.h"
 #include "PhysicsDebugDraw.h"
+#include "Map.h"
 
 #include <SFML\Graphics.hpp>
 
@@ -18,10 +19,12 @@ class StateDefPhysicsTest : public State
 
 	private:
 		b2Body*				createSquare(b2World &world);
+		void				createBoundingBox(b2World &world, const sf::Vector2u& size);
 
 	private:
 		b2World				mB2World;
 		PhysicsDebugDraw	mDebugDraw;
+		Map					mMap;
 	
 		//Converts SFML's vector to Box2D's vector and downscales it so it fits Box2D's MKS units
 		template<typename T > 
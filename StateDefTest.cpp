@@ -8,9 +8,13 @@ StateDefTest::StateDefTest(StateStack& stack, Context context)
 , mEnvironment(*context.window,*context.textures,*context.fonts)
 , mGui()
 , mPlayerPlatformer(*context.playerPlatformer)
+, mReplay(context.replay->isRecording() ? context.replay : nullptr)
 {
 	mPlayerPlatformer.setMissionStatus(PlayerPlatformer::MissionRunning);
 
+	if (mReplay)
+		mReplay->beginSession(States::Test);
+
 	// GUI
 	auto checkbox = std::make_shared<GUI::GuiCtrlButton>(sf::Vector2f(0,50), *context.textures);
 	checkbox->setCallback([this](){
@@ -49,7 +53,16 @@ bool StateDefTest::update(sf::Time dt)
 	mEnvironment.update(dt);
 
 	CommandQueue& commands = mEnvironment.getCommandQueue();
-	mPlayerPlatformer.handleRealtimeInput(commands);
+	unsigned int actions = mPlayerPlatformer.getRealtimeActions();
+	mPlayerPlatformer.triggerActions(actions, commands);
+
+	// Record this tick (ReplayRunner plays it back the same way)
+	if (mReplay)
+	{
+		mReplay->recordActions(actions);
+		if (mReplay->needsChecksum())
+			mReplay->recordChecksum(mEnvironment.getChecksum());
+	}
 
 	mAnim.update(dt);
 
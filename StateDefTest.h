@@ -5,6 +5,7 @@
 #include "Environment.h"
 #include "PlayerPlatformer.h"
 #include "AnimationManager.h"
+#include "Replay.h"
 
 #include "GUI\Gui.h"
 
@@ -23,6 +24,7 @@ class StateDefTest : public State
 		GUI::Gui			mGui;
 		Environment			mEnvironment;
 		PlayerPlatformer&	mPlayerPlatformer;
+		Replay*				mReplay;
 		Anim				mAnim;
 };
 
@@ -1,4 +1,4 @@
-#include <LTBL/QuadTree/StaticQuadTree.h>
+#include "StaticQuadTree.h"
 
 #include <assert.h>
 
@@ -9,17 +9,18 @@ namespace qdt
 	{
 	}
 
-	StaticQuadTree::StaticQuadTree(const AABB &rootRegion)
+	StaticQuadTree::StaticQuadTree(const sf::FloatRect &rootRegion)
 		: m_created(false)
 	{
-		m_pRootNode.reset(new QuadTreeNode(rootRegion, 0));
-
-		m_created = true;
+		Create(rootRegion);
 	}
 
-	void StaticQuadTree::Create(const AABB &rootRegion)
+	void StaticQuadTree::Create(const sf::FloatRect &rootRegion)
 	{
-		m_pRootNode.reset(new QuadTreeNode(rootRegion, 0));
+		// Occupants of the previous root leave the tree
+		ReleaseOccupants();
+
+		m_pRootNode.reset(new QuadTreeNode(rootRegion, 0, NULL, this));
 
 		m_created = true;
 	}
@@ -31,17 +32,15 @@ namespace qdt
 		SetQuadTree(pOc);
 
 		// If the occupant fits in the root node
-		if(m_pRootNode->GetRegion().Contains(pOc->GetAABB()))
+		if(Contains(m_pRootNode->GetRegion(), pOc->GetAABB()))
 			m_pRootNode->Add(pOc);
 		else
-			m_outsideRoot.insert(pOc);
+			m_outsideRoot.push_back(pOc);
 	}
 
 	void StaticQuadTree::Clear()
 	{
-		m_pRootNode.reset();
-
-		m_outsideRoot.clear();
+		ReleaseOccupants();
 
 		m_created = false;
 	}
@@ -50,4 +49,4 @@ namespace qdt
 	{
 		return m_created;
 	}
-}
\ No newline at end of file
+}
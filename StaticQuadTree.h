@@ -1,10 +1,12 @@
 #ifndef QDT_STATICQUADTREE_H
 #define QDT_STATICQUADTREE_H
 
-#include <LTBL/QuadTree/QuadTree.h>
+#include "QuadTree.h"
 
 namespace qdt
 {
+	// QuadTree over a fixed root region; occupants outside it are kept in a
+	// list, and checked by every query
 	class StaticQuadTree :
 		public QuadTree
 	{
@@ -13,9 +15,9 @@ namespace qdt
 
 	public:
 		StaticQuadTree();
-		StaticQuadTree(const AABB &rootRegion);
+		StaticQuadTree(const sf::FloatRect &rootRegion);
 
-		void Create(const AABB &rootRegion);
+		void Create(const sf::FloatRect &rootRegion);
 
 		// Inherited from QuadTree
 		void Add(QuadTreeOccupant* pOc);
@@ -26,4 +28,4 @@ namespace qdt
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -1,9 +1,12 @@
 #include "TextNode.h"
+#include "NodePool.h"
 #include "Utility.h"
 
 TextNode::TextNode(const FontManager& fonts, const std::string& text)
 {
-	mText.setFont(fonts.get(Fonts::Main));
+	// No font in headless worlds: the text then has no geometry
+	if (const sf::Font* font = fonts.find(Fonts::Main))
+		mText.setFont(*font);
 	mText.setCharacterSize(20);
 	setString(text);
 }
@@ -17,4 +20,14 @@ void TextNode::setString(const std::string& text)
 {
 	mText.setString(text);
 	centerOrigin(mText);
-}
\ No newline at end of file
+}
+
+void* TextNode::operator new(std::size_t size)
+{
+	return NodePool<TextNode>::allocate(size);
+}
+
+void TextNode::operator delete(void* block, std::size_t size)
+{
+	NodePool<TextNode>::deallocate(block, size);
+}
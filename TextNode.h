@@ -14,6 +14,10 @@ class TextNode : public SceneNode
 
 		void				setString(const std::string& text);
 
+		// Storage recycled through NodePool
+		static void*		operator new(std::size_t size);
+		static void			operator delete(void* block, std::size_t size);
+
 
 	private:
 		virtual void		drawCurrent(sf::RenderTarget& target, sf::RenderStates states) const;
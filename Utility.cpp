@@ -11,10 +11,11 @@
 
 namespace
 {
+	unsigned long RandomSeed = static_cast<unsigned long>(std::time(nullptr));
+
 	std::default_random_engine createRandomEngine()
 	{
-		auto seed = static_cast<unsigned long>(std::time(nullptr));
-		return std::default_random_engine(seed);
+		return std::default_random_engine(RandomSeed);
 	}
 
 	auto RandomEngine = createRandomEngine();
@@ -167,6 +168,37 @@ int randomInt(int exclusiveMax)
 	return distr(RandomEngine);
 }
 
+void setRandomSeed(unsigned long seed)
+{
+	RandomSeed = seed;
+	RandomEngine = createRandomEngine();
+}
+
+unsigned long getRandomSeed()
+{
+	return RandomSeed;
+}
+
+unsigned int hashBytes(unsigned int hash, const void* data, std::size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	for (std::size_t i = 0; i < size; ++i)
+		hash = (hash ^ bytes[i]) * 16777619u;
+
+	return hash;
+}
+
+unsigned int hashFloat(unsigned int hash, float value)
+{
+	return hashBytes(hash, &value, sizeof(value));
+}
+
+unsigned int hashInt(unsigned int hash, int value)
+{
+	return hashBytes(hash, &value, sizeof(value));
+}
+
 float length(sf::Vector2f vector)
 {
 	return std::sqrt(vector.x * vector.x + vector.y * vector.y);
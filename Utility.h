@@ -35,6 +35,16 @@ float			toRadian(float degree);
 // Random number generation
 int				randomInt(int exclusiveMax);
 
+// Seed of the random number generator; setting it restarts the sequence
+// (e.g., to play a replay back)
+void			setRandomSeed(unsigned long seed);
+unsigned long	getRandomSeed();
+
+// Checksums (FNV-1a), to compare the simulation's state between runs
+unsigned int	hashBytes(unsigned int hash, const void* data, std::size_t size);
+unsigned int	hashFloat(unsigned int hash, float value);
+unsigned int	hashInt(unsigned int hash, int value);
+
 // Vector operations
 float			length(sf::Vector2f vector);
 sf::Vector2f	unitVector(sf::Vector2f vector);
@@ -4,31 +4,79 @@
 #include "Foreach.h"
 #include "TextNode.h"
 #include "ParticleNode.h"
+#include "Utility.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cmath>
 #include <limits>
 
 World::World(sf::RenderTarget& outputTarget, FontManager& fonts)
-: mTarget(outputTarget)
+: mTarget(&outputTarget)
 , mSceneTexture()
 , mWorldView(outputTarget.getDefaultView())
 , mTextures() 
 , mFonts(fonts)
+, mQuadTrees()
+, mQueryResults()
+, mCommandDispatcher()
+, mEntityRegistry()
 , mSceneGraph()
 , mSceneLayers()
 , mWorldBounds(0.f, 0.f, mWorldView.getSize().x, 5000.f)
 , mSpawnPosition(mWorldView.getSize().x / 2.f, mWorldBounds.height - mWorldView.getSize().y / 2.f)
 , mScrollSpeed(-50.f)
-, mPlayerAircraft(nullptr)
+, mPlayerAircraft()
 , mEnemySpawnPoints()
 , mActiveEnemies()
+, mBroadphase(64.f)
+, mCollisionCandidates()
+, mCollisionPairs()
+, mBloomEffect()
 {
-	mSceneTexture.create(mTarget.getSize().x, mTarget.getSize().y);
-
 	loadTextures();
+	initialize();
+}
+
+World::World(sf::Vector2f viewSize, FontManager& fonts)
+: mTarget(nullptr)
+, mSceneTexture()
+, mWorldView(sf::FloatRect(0.f, 0.f, viewSize.x, viewSize.y))
+, mTextures() 
+, mFonts(fonts)
+, mQuadTrees()
+, mQueryResults()
+, mCommandDispatcher()
+, mEntityRegistry()
+, mSceneGraph()
+, mSceneLayers()
+, mWorldBounds(0.f, 0.f, mWorldView.getSize().x, 5000.f)
+, mSpawnPosition(mWorldView.getSize().x / 2.f, mWorldBounds.height - mWorldView.getSize().y / 2.f)
+, mScrollSpeed(-50.f)
+, mPlayerAircraft()
+, mEnemySpawnPoints()
+, mActiveEnemies()
+, mBroadphase(64.f)
+, mCollisionCandidates()
+, mCollisionPairs()
+, mBloomEffect()
+{
+	initialize();
+}
+
+void World::initialize()
+{
+	mSceneGraph.setCommandDispatcher(&mCommandDispatcher);
+	mSceneGraph.setEntityRegistry(&mEntityRegistry);
+
 	buildScene();
 
+	// Category pairs that handleCollisions() responds to
+	mBroadphase.addRule(CommandCategory::PlayerShip, CommandCategory::EnemyShip);
+	mBroadphase.addRule(CommandCategory::PlayerShip, CommandCategory::Pickup);
+	mBroadphase.addRule(CommandCategory::EnemyShip, CommandCategory::AlliedProjectile);
+	mBroadphase.addRule(CommandCategory::PlayerShip, CommandCategory::EnemyProjectile);
+
 	// Prepare the view
 	mWorldView.setCenter(mSpawnPosition);
 }
@@ -37,22 +85,22 @@ void World::update(sf::Time dt)
 {
 	// Scroll the world, reset player velocity
 	mWorldView.move(0.f, mScrollSpeed * dt.asSeconds());	
-	mPlayerAircraft->setVelocity(0.f, 0.f);
+	if (Character* player = getPlayerAircraft())
+		player->setVelocity(0.f, 0.f);
 
 	// Setup commands to destroy entities, and guide missiles
 	destroyEntitiesOutsideView();
 	guideMissiles();
 
 	// Forward commands to scene graph, adapt velocity (scrolling, diagonal correction)
-	while (!mCommandQueue.isEmpty())
-		mSceneGraph.onCommand(mCommandQueue.pop(), dt);
+	mCommandDispatcher.dispatch(mCommandQueue, dt);
 	adaptPlayerVelocity();
 
 	// Collision detection and response (may destroy entities)
 	handleCollisions();
 
 	// Remove all destroyed entities, create new ones
-	mSceneGraph.removeWrecks();
+	mEntityRegistry.removeWrecks();
 	spawnEnemies();
 
 	// Regular update step, adapt position (correct if outside view)
@@ -62,18 +110,56 @@ void World::update(sf::Time dt)
 
 void World::draw()
 {
+	assert(mTarget);
+
 	if (Effect::isSupported())
 	{
-		mSceneTexture.clear();
-		mSceneTexture.setView(mWorldView);
-		mSceneTexture.draw(mSceneGraph);
-		mSceneTexture.display();
-		mBloomEffect.apply(mSceneTexture, mTarget);
+		if (!mSceneTexture)
+		{
+			mSceneTexture.reset(new sf::RenderTexture());
+			mSceneTexture->create(mTarget->getSize().x, mTarget->getSize().y);
+			mBloomEffect.reset(new EffectBloom());
+		}
+
+		mSceneTexture->clear();
+		mSceneTexture->setView(mWorldView);
+		drawScene(*mSceneTexture);
+		mSceneTexture->display();
+		mBloomEffect->apply(*mSceneTexture, *mTarget);
 	}
 	else
 	{
-		mTarget.setView(mWorldView);
-		mTarget.draw(mSceneGraph);
+		mTarget->setView(mWorldView);
+		drawScene(*mTarget);
+	}
+}
+
+void World::drawScene(sf::RenderTarget& target)
+{
+	target.draw(*mSceneLayers[Background]);
+
+	// Entities in view only, in the order they entered their layer (the layers
+	// themselves aren't transformed). Texts hang out of the entities' bounds,
+	// hence the margin
+	sf::FloatRect viewBounds = getViewBounds();
+	const float margin = 50.f;
+	viewBounds.left -= margin;
+	viewBounds.top -= margin;
+	viewBounds.width += 2.f * margin;
+	viewBounds.height += 2.f * margin;
+
+	for (std::size_t i = LowerAir; i < LayerCount; ++i)
+	{
+		mQueryResults.clear();
+		mQuadTrees[i].Query_Region(viewBounds, mQueryResults);
+
+		std::sort(mQueryResults.begin(), mQueryResults.end(), [] (qdt::QuadTreeOccupant* lhs, qdt::QuadTreeOccupant* rhs)
+		{
+			return lhs->GetAddOrder() < rhs->GetAddOrder();
+		});
+
+		FOREACH(qdt::QuadTreeOccupant* occupant, mQueryResults)
+			target.draw(*static_cast<Entity*>(occupant));
 	}
 }
 
@@ -82,14 +168,32 @@ CommandQueue& World::getCommandQueue()
 	return mCommandQueue;
 }
 
+unsigned int World::getChecksum() const
+{
+	// The view scrolls, and decides which enemies spawn and which entities are destroyed
+	unsigned int hash = 2166136261u;
+	hash = hashFloat(hash, mWorldView.getCenter().x);
+	hash = hashFloat(hash, mWorldView.getCenter().y);
+
+	return mSceneGraph.getChecksum(hash);
+}
+
 bool World::hasAlivePlayer() const
 {
-	return !mPlayerAircraft->isMarkedForRemoval();
+	Character* player = getPlayerAircraft();
+	return player && !player->isMarkedForRemoval();
 }
 
 bool World::hasPlayerReachedEnd() const
 {
-	return !mWorldBounds.contains(mPlayerAircraft->getPosition());
+	Character* player = getPlayerAircraft();
+	return player && !mWorldBounds.contains(player->getPosition());
+}
+
+Character* World::getPlayerAircraft() const
+{
+	// nullptr once removed after its explosion
+	return mEntityRegistry.get<Character>(mPlayerAircraft);
 }
 
 void World::loadTextures()
@@ -103,28 +207,37 @@ void World::loadTextures()
 
 void World::adaptPlayerPosition()
 {
+	Character* player = getPlayerAircraft();
+	if (!player)
+		return;
+
 	// Keep player's position inside the screen bounds, at least borderDistance units from the border
 	sf::FloatRect viewBounds = getViewBounds();
 	const float borderDistance = 40.f;
 
-	sf::Vector2f position = mPlayerAircraft->getPosition();
+	sf::Vector2f position = player->getPosition();
 	position.x = std::max(position.x, viewBounds.left + borderDistance);
 	position.x = std::min(position.x, viewBounds.left + viewBounds.width - borderDistance);
 	position.y = std::max(position.y, viewBounds.top + borderDistance);
 	position.y = std::min(position.y, viewBounds.top + viewBounds.height - borderDistance);
-	mPlayerAircraft->setPosition(position);
+	player->setPosition(position);
+	player->updateBounds();
 }
 
 void World::adaptPlayerVelocity()
 {
-	sf::Vector2f velocity = mPlayerAircraft->getVelocity();
+	Character* player = getPlayerAircraft();
+	if (!player)
+		return;
+
+	sf::Vector2f velocity = player->getVelocity();
 
 	// If moving diagonally, reduce velocity (to have always same velocity)
 	if (velocity.x != 0.f && velocity.y != 0.f)
-		mPlayerAircraft->setVelocity(velocity / std::sqrt(2.f));
+		player->setVelocity(velocity / std::sqrt(2.f));
 
 	// Add scrolling velocity
-	mPlayerAircraft->accelerate(0.f, mScrollSpeed);
+	player->accelerate(0.f, mScrollSpeed);
 }
 
 bool matchesCategories(SceneNode::Pair& colliders, CommandCategory::Type type1, CommandCategory::Type type2)
@@ -150,10 +263,21 @@ bool matchesCategories(SceneNode::Pair& colliders, CommandCategory::Type type1,
 
 void World::handleCollisions()
 {
-	std::set<SceneNode::Pair> collisionPairs;
-	mSceneGraph.checkSceneCollision(mSceneGraph, collisionPairs);
+	// Live entities are all on the battlefield: the others are destroyed as
+	// they leave it
+	sf::FloatRect battlefieldBounds = getBattlefieldBounds();
+
+	mQueryResults.clear();
+	for (std::size_t i = LowerAir; i < LayerCount; ++i)
+		mQuadTrees[i].Query_Region(battlefieldBounds, mQueryResults);
 
-	FOREACH(SceneNode::Pair pair, collisionPairs)
+	mCollisionCandidates.clear();
+	FOREACH(qdt::QuadTreeOccupant* occupant, mQueryResults)
+		mCollisionCandidates.push_back(static_cast<Entity*>(occupant));
+
+	mBroadphase.findPairs(mCollisionCandidates, mCollisionPairs);
+
+	FOREACH(SceneNode::Pair pair, mCollisionPairs)
 	{
 		if (matchesCategories(pair, CommandCategory::PlayerShip, CommandCategory::EnemyShip))
 		{
@@ -198,41 +322,55 @@ void World::buildScene()
 		SceneNode::Ptr layer(new SceneNode(category));
 		mSceneLayers[i] = layer.get();
 
+		// Index the entities of the air layers, over the area the background covers
+		if (i != Background)
+		{
+			float viewHeight = mWorldView.getSize().y;
+			mQuadTrees[i].Create(sf::FloatRect(mWorldBounds.left, mWorldBounds.top - viewHeight, mWorldBounds.width, mWorldBounds.height + viewHeight));
+			layer->setQuadTree(&mQuadTrees[i]);
+		}
+
 		mSceneGraph.attachChild(std::move(layer));
 	}
 
-	// Prepare the tiled background
-	sf::Texture& jungleTexture = mTextures.get(Textures::Jungle);
-	jungleTexture.setRepeated(true);
-
+	// Prepare the tiled background (headless worlds have no textures, but
+	// still build the same scene, for the checksums)
 	float viewHeight = mWorldView.getSize().y;
 	sf::IntRect textureRect(mWorldBounds);
 	textureRect.height += static_cast<int>(viewHeight);
 
 	// Add the background sprite to the scene
-	std::unique_ptr<SpriteNode> jungleSprite(new SpriteNode(jungleTexture, textureRect));
+	std::unique_ptr<SpriteNode> jungleSprite(new SpriteNode(textureRect));
+	if (sf::Texture* jungleTexture = mTextures.find(Textures::Jungle))
+	{
+		jungleTexture->setRepeated(true);
+		jungleSprite->setTexture(*jungleTexture);
+	}
 	jungleSprite->setPosition(mWorldBounds.left, mWorldBounds.top - viewHeight);
 	mSceneLayers[Background]->attachChild(std::move(jungleSprite));
 
 	// Add the finish line to the scene
-	sf::Texture& finishTexture = mTextures.get(Textures::FinishLine);
-	std::unique_ptr<SpriteNode> finishSprite(new SpriteNode(finishTexture));
+	std::unique_ptr<SpriteNode> finishSprite(new SpriteNode());
+	if (const sf::Texture* finishTexture = mTextures.find(Textures::FinishLine))
+		finishSprite->setTexture(*finishTexture);
 	finishSprite->setPosition(0.f, -76.f);
 	mSceneLayers[Background]->attachChild(std::move(finishSprite));
 
-	// Add particle node to the scene
+	// Add particle node to the scene (on top of the background, below the air
+	// layers, which only draw their entities)
 	std::unique_ptr<ParticleNode> smokeNode(new ParticleNode(Particle::Smoke, mTextures));
-	mSceneLayers[LowerAir]->attachChild(std::move(smokeNode));
+	mSceneLayers[Background]->attachChild(std::move(smokeNode));
 
 	// Add propellant particle node to the scene
 	std::unique_ptr<ParticleNode> propellantNode(new ParticleNode(Particle::Propellant, mTextures));
-	mSceneLayers[LowerAir]->attachChild(std::move(propellantNode));
+	mSceneLayers[Background]->attachChild(std::move(propellantNode));
 
 	// Add player's aircraft
 	std::unique_ptr<Character> player(new Character(Character::Eagle, mTextures, mFonts));
-	mPlayerAircraft = player.get();
-	mPlayerAircraft->setPosition(mSpawnPosition);
+	player->setPosition(mSpawnPosition);
+	Character& playerAircraft = *player;
 	mSceneLayers[UpperAir]->attachChild(std::move(player));
+	mPlayerAircraft = playerAircraft.getHandle();
 
 	// Add enemy aircraft
 	addEnemies();
@@ -322,7 +460,7 @@ void World::guideMissiles()
 	enemyCollector.action = derivedAction<Character>([this] (Character& enemy, sf::Time)
 	{
 		if (!enemy.isDestroyed())
-			mActiveEnemies.push_back(&enemy);
+			mActiveEnemies.push_back(enemy.getHandle());
 	});
 
 	// Setup command that guides all missiles to the enemy which is currently closest to the player
@@ -338,8 +476,12 @@ void World::guideMissiles()
 		Character* closestEnemy = nullptr;
 
 		// Find closest enemy
-		FOREACH(Character* enemy, mActiveEnemies)
+		FOREACH(EntityHandle handle, mActiveEnemies)
 		{
+			Character* enemy = mEntityRegistry.get<Character>(handle);
+			if (!enemy)
+				continue;
+
 			float enemyDistance = distance(missile, *enemy);
 
 			if (enemyDistance < minDistance)
@@ -8,11 +8,16 @@
 #include "Character.h"
 #include "CommandQueue.h"
 #include "Command.h"
+#include "CommandDispatcher.h"
+#include "EntityRegistry.h"
 #include "EffectBloom.h"
 #include "Physics.h"
+#include "Broadphase.h"
+#include "StaticQuadTree.h"
 
 #include <SFML\Graphics.hpp>
 #include <array>
+#include <memory>
 #include <queue>
 
 // Forward declaration
@@ -25,20 +30,29 @@ class World : private sf::NonCopyable
 {
 	public:
 		explicit							World(sf::RenderTarget& outputTarget, FontManager& fonts);
+
+		// Headless: no render target, no textures, and fonts may be empty. The
+		// simulation (and its checksums) is the same; draw() mustn't be called
+											World(sf::Vector2f viewSize, FontManager& fonts);
+
 		void								update(sf::Time dt);
 		void								draw();
 		
 		CommandQueue&						getCommandQueue();
+		unsigned int						getChecksum() const;
 
 		bool 								hasAlivePlayer() const;
 		bool 								hasPlayerReachedEnd() const;
 
 
 	private:
+		void								initialize();
 		void								loadTextures();
+		Character*							getPlayerAircraft() const;
 		void								adaptPlayerPosition();
 		void								adaptPlayerVelocity();
 		void								handleCollisions();
+		void								drawScene(sf::RenderTarget& target);
 		
 		void								buildScene();
 		void								addEnemies();
@@ -75,12 +89,21 @@ class World : private sf::NonCopyable
 
 
 	private:
-		sf::RenderTarget&					mTarget;
-		sf::RenderTexture					mSceneTexture;
+		sf::RenderTarget*					mTarget;		// nullptr if headless
+		std::unique_ptr<sf::RenderTexture>	mSceneTexture;	// Created by the first draw()
 		sf::View							mWorldView;
 		TextureManager						mTextures;
 		FontManager&						mFonts;
 
+		// Entities of LowerAir and UpperAir, by bounds (declared before the
+		// scene graph, which they leave when destroyed)
+		std::array<qdt::StaticQuadTree, LayerCount>	mQuadTrees;
+		std::vector<qdt::QuadTreeOccupant*>	mQueryResults;
+
+		// Declared before the scene graph, which unregisters from them when destroyed
+		CommandDispatcher					mCommandDispatcher;
+		EntityRegistry						mEntityRegistry;
+
 		SceneNode							mSceneGraph;
 		std::array<SceneNode*, LayerCount>	mSceneLayers;
 		CommandQueue						mCommandQueue;
@@ -88,12 +111,16 @@ class World : private sf::NonCopyable
 		sf::FloatRect						mWorldBounds;
 		sf::Vector2f						mSpawnPosition;
 		float								mScrollSpeed;
-		Character*							mPlayerAircraft;
+		EntityHandle						mPlayerAircraft;
 
 		std::vector<SpawnPoint>				mEnemySpawnPoints;
-		std::vector<Character*>				mActiveEnemies;
+		std::vector<EntityHandle>			mActiveEnemies;
+
+		Broadphase							mBroadphase;
+		std::vector<SceneNode*>				mCollisionCandidates;
+		std::vector<SceneNode::Pair>		mCollisionPairs;
 
-		EffectBloom							mBloomEffect;
+		std::unique_ptr<EffectBloom>		mBloomEffect;	// Created by the first draw()
 };
 
 #endif
\ No newline at end of file